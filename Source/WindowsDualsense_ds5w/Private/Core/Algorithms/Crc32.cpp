@@ -0,0 +1,283 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Algorithms/Crc32.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#define DS_CRC32_PCLMUL 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#elif PLATFORM_CPU_ARM_FAMILY && defined(__ARM_FEATURE_CRC32)
+#define DS_CRC32_ARMV8 1
+#include <arm_acle.h>
+#endif
+
+#if DS_CRC32_PCLMUL && (defined(__clang__) || defined(__GNUC__))
+#define DS_CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+#else
+#define DS_CRC32_PCLMUL_TARGET
+#endif
+
+namespace
+{
+	/**
+	 * Lookup tables for the slicing-by-8 loop. Entries[0] is the classic byte table; Entries[K]
+	 * advances a byte through K more zero bytes, so eight lookups consume eight input bytes.
+	 */
+	struct FSlicingTables
+	{
+		uint32 Entries[8][256] = {};
+
+		constexpr FSlicingTables()
+		{
+			for (uint32 Index = 0; Index < 256; ++Index)
+			{
+				Entries[0][Index] = ~FCrc32::ExtendByte(~0u, static_cast<unsigned char>(Index));
+			}
+			for (uint32 Index = 0; Index < 256; ++Index)
+			{
+				for (int32 Slice = 1; Slice < 8; ++Slice)
+				{
+					const uint32 Previous = Entries[Slice - 1][Index];
+					Entries[Slice][Index] = (Previous >> 8) ^ Entries[0][Previous & 0xFF];
+				}
+			}
+		}
+	};
+
+	constexpr FSlicingTables Tables;
+
+	// The functions below work on the raw register, i.e. the inverted CRC.
+
+	uint32 UpdateTable(uint32 State, const unsigned char* Data, size_t Len)
+	{
+		for (size_t i = 0; i < Len; ++i)
+		{
+			State = Tables.Entries[0][(State ^ Data[i]) & 0xFF] ^ (State >> 8);
+		}
+		return State;
+	}
+
+	uint32 UpdateSlicingBy8(uint32 State, const unsigned char* Data, size_t Len)
+	{
+		while (Len >= 8)
+		{
+			// Little-endian loads; every platform the plugin targets is little-endian.
+			uint32 Low;
+			uint32 High;
+			FMemory::Memcpy(&Low, Data, sizeof(Low));
+			FMemory::Memcpy(&High, Data + 4, sizeof(High));
+			Low ^= State;
+
+			State = Tables.Entries[7][Low & 0xFF] ^ Tables.Entries[6][(Low >> 8) & 0xFF] ^
+			        Tables.Entries[5][(Low >> 16) & 0xFF] ^ Tables.Entries[4][Low >> 24] ^
+			        Tables.Entries[3][High & 0xFF] ^ Tables.Entries[2][(High >> 8) & 0xFF] ^
+			        Tables.Entries[1][(High >> 16) & 0xFF] ^ Tables.Entries[0][High >> 24];
+
+			Data += 8;
+			Len -= 8;
+		}
+		return UpdateTable(State, Data, Len);
+	}
+
+#if DS_CRC32_PCLMUL
+	/**
+	 * Folds a buffer into the CRC register with carry-less multiplications, following Intel's
+	 * "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+	 * Len must be a multiple of 16 and at least 64.
+	 */
+	DS_CRC32_PCLMUL_TARGET uint32 UpdatePclmul(const uint32 State, const unsigned char* Data, size_t Len)
+	{
+		// Folding constants x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32) and x^64 mod P,
+		// then the Barrett reduction pair P(x) and floor(x^64 / P(x)), all bit-reflected.
+		const __m128i K1K2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+		const __m128i K3K4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+		const __m128i K5 = _mm_set_epi64x(0, 0x0163cd6124);
+		const __m128i Poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+		const __m128i Mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+		__m128i X1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 0x00));
+		__m128i X2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 0x10));
+		__m128i X3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 0x20));
+		__m128i X4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 0x30));
+		X1 = _mm_xor_si128(X1, _mm_cvtsi32_si128(static_cast<int32>(State)));
+		Data += 64;
+		Len -= 64;
+
+		// Four independent lanes of 128 bits while at least 64 bytes remain.
+		while (Len >= 64)
+		{
+			const __m128i X5 = _mm_clmulepi64_si128(X1, K1K2, 0x00);
+			const __m128i X6 = _mm_clmulepi64_si128(X2, K1K2, 0x00);
+			const __m128i X7 = _mm_clmulepi64_si128(X3, K1K2, 0x00);
+			const __m128i X8 = _mm_clmulepi64_si128(X4, K1K2, 0x00);
+
+			X1 = _mm_clmulepi64_si128(X1, K1K2, 0x11);
+			X2 = _mm_clmulepi64_si128(X2, K1K2, 0x11);
+			X3 = _mm_clmulepi64_si128(X3, K1K2, 0x11);
+			X4 = _mm_clmulepi64_si128(X4, K1K2, 0x11);
+
+			X1 = _mm_xor_si128(_mm_xor_si128(X1, X5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 0x00)));
+			X2 = _mm_xor_si128(_mm_xor_si128(X2, X6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 0x10)));
+			X3 = _mm_xor_si128(_mm_xor_si128(X3, X7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 0x20)));
+			X4 = _mm_xor_si128(_mm_xor_si128(X4, X8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 0x30)));
+
+			Data += 64;
+			Len -= 64;
+		}
+
+		// Fold the four lanes into one.
+		const __m128i Lanes[3] = {X2, X3, X4};
+		for (const __m128i& Lane : Lanes)
+		{
+			const __m128i X5 = _mm_clmulepi64_si128(X1, K3K4, 0x00);
+			X1 = _mm_clmulepi64_si128(X1, K3K4, 0x11);
+			X1 = _mm_xor_si128(_mm_xor_si128(X1, Lane), X5);
+		}
+
+		// Remaining 16-byte blocks.
+		while (Len >= 16)
+		{
+			const __m128i X5 = _mm_clmulepi64_si128(X1, K3K4, 0x00);
+			X1 = _mm_clmulepi64_si128(X1, K3K4, 0x11);
+			X1 = _mm_xor_si128(_mm_xor_si128(X1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data))), X5);
+			Data += 16;
+			Len -= 16;
+		}
+
+		// 128 -> 64 bits.
+		__m128i Upper = _mm_clmulepi64_si128(X1, K3K4, 0x10);
+		X1 = _mm_xor_si128(_mm_srli_si128(X1, 8), Upper);
+		Upper = _mm_srli_si128(X1, 4);
+		X1 = _mm_and_si128(X1, Mask32);
+		X1 = _mm_clmulepi64_si128(X1, K5, 0x00);
+		X1 = _mm_xor_si128(X1, Upper);
+
+		// Barrett reduction to 32 bits.
+		__m128i Reduced = _mm_and_si128(X1, Mask32);
+		Reduced = _mm_clmulepi64_si128(Reduced, Poly, 0x10);
+		Reduced = _mm_and_si128(Reduced, Mask32);
+		Reduced = _mm_clmulepi64_si128(Reduced, Poly, 0x00);
+		X1 = _mm_xor_si128(X1, Reduced);
+
+		return static_cast<uint32>(_mm_extract_epi32(X1, 1));
+	}
+
+	bool DetectHardwareSupport()
+	{
+		constexpr uint32 Sse41Bit = 1u << 19;
+		constexpr uint32 PclmulBit = 1u << 1;
+#if defined(_MSC_VER) && !defined(__clang__)
+		int32 Registers[4] = {};
+		__cpuid(Registers, 1);
+		const uint32 Features = static_cast<uint32>(Registers[2]);
+#else
+		unsigned int Eax = 0, Ebx = 0, Ecx = 0, Edx = 0;
+		const uint32 Features = __get_cpuid(1, &Eax, &Ebx, &Ecx, &Edx) ? Ecx : 0;
+#endif
+		return (Features & (Sse41Bit | PclmulBit)) == (Sse41Bit | PclmulBit);
+	}
+#elif DS_CRC32_ARMV8
+	uint32 UpdateArmCrc(uint32 State, const unsigned char* Data, size_t Len)
+	{
+		while (Len >= 8)
+		{
+			uint64 Word;
+			FMemory::Memcpy(&Word, Data, sizeof(Word));
+			State = __crc32d(State, Word);
+			Data += 8;
+			Len -= 8;
+		}
+		while (Len > 0)
+		{
+			State = __crc32b(State, *Data++);
+			--Len;
+		}
+		return State;
+	}
+
+	bool DetectHardwareSupport()
+	{
+		// The compiler only defines __ARM_FEATURE_CRC32 when the target baseline includes it.
+		return true;
+	}
+#else
+	bool DetectHardwareSupport()
+	{
+		return false;
+	}
+#endif
+
+	using FExtendFunction = uint32 (*)(uint32, const unsigned char*, size_t);
+
+	FExtendFunction SelectImplementation()
+	{
+		return FCrc32::HasHardwareSupport() ? &FCrc32::ExtendHardware : &FCrc32::ExtendSlicingBy8;
+	}
+} // namespace
+
+uint32 FCrc32::Extend(const uint32 Crc, const unsigned char* Data, const size_t Len)
+{
+	static const FExtendFunction Implementation = SelectImplementation();
+	return Implementation(Crc, Data, Len);
+}
+
+uint32 FCrc32::ExtendTable(const uint32 Crc, const unsigned char* Data, const size_t Len)
+{
+	return ~UpdateTable(~Crc, Data, Len);
+}
+
+uint32 FCrc32::ExtendSlicingBy8(const uint32 Crc, const unsigned char* Data, const size_t Len)
+{
+	return ~UpdateSlicingBy8(~Crc, Data, Len);
+}
+
+uint32 FCrc32::ExtendHardware(const uint32 Crc, const unsigned char* Data, size_t Len)
+{
+	if (!HasHardwareSupport())
+	{
+		return ExtendSlicingBy8(Crc, Data, Len);
+	}
+
+	uint32 State = ~Crc;
+#if DS_CRC32_PCLMUL
+	// Fold the 16-byte aligned bulk, the short tail is cheaper through the tables.
+	if (Len >= 64)
+	{
+		const size_t Folded = Len & ~static_cast<size_t>(15);
+		State = UpdatePclmul(State, Data, Folded);
+		Data += Folded;
+		Len -= Folded;
+	}
+	State = UpdateSlicingBy8(State, Data, Len);
+#elif DS_CRC32_ARMV8
+	State = UpdateArmCrc(State, Data, Len);
+#endif
+	return ~State;
+}
+
+bool FCrc32::HasHardwareSupport()
+{
+	static const bool bSupported = DetectHardwareSupport();
+	return bSupported;
+}
+
+const TCHAR* FCrc32::GetImplementationName()
+{
+	if (!HasHardwareSupport())
+	{
+		return TEXT("SlicingBy8");
+	}
+#if DS_CRC32_PCLMUL
+	return TEXT("PCLMULQDQ");
+#else
+	return TEXT("ARMv8 CRC32");
+#endif
+}
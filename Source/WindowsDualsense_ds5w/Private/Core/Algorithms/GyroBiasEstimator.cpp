@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Algorithms/GyroBiasEstimator.h"
+
+namespace
+{
+	// Confidence gained per stationary window, and lost per second of motion.
+	constexpr float ConfidenceGainPerWindow = 0.2f;
+	constexpr float ConfidenceDecayPerSecond = 0.002f;
+	// Smallest blend weight, so a long stationary history still tracks slow thermal drift.
+	constexpr float MinBiasBlend = 0.05f;
+	// Fewer samples than this cannot give a meaningful variance.
+	constexpr int32 MinWindowSamples = 10;
+} // namespace
+
+FGyroBiasEstimator::FGyroBiasEstimator(const float InGyroNoiseThreshold, const float InAccelNoiseThreshold,
+                                       const float InMaxStationaryRate, const float InWindowSeconds)
+    : GyroNoiseThreshold(InGyroNoiseThreshold)
+    , AccelNoiseThreshold(InAccelNoiseThreshold)
+    , MaxStationaryRate(InMaxStationaryRate)
+    , WindowSeconds(InWindowSeconds)
+{
+}
+
+void FGyroBiasEstimator::AddSample(const FVector& Gyro, const FVector& Accel, const float DeltaSeconds)
+{
+	if (DeltaSeconds <= 0.0f)
+	{
+		ResetWindow();
+		return;
+	}
+
+	GyroStats[0].Add(Gyro.X);
+	GyroStats[1].Add(Gyro.Y);
+	GyroStats[2].Add(Gyro.Z);
+	AccelMagnitudeStats.Add(Accel.Size());
+
+	WindowElapsed += DeltaSeconds;
+	if (WindowElapsed >= WindowSeconds)
+	{
+		CloseWindow();
+	}
+}
+
+void FGyroBiasEstimator::CloseWindow()
+{
+	const float Elapsed = WindowElapsed;
+	bool bStationary = AccelMagnitudeStats.Count >= MinWindowSamples &&
+	                   FMath::Sqrt(AccelMagnitudeStats.GetVariance()) <= AccelNoiseThreshold;
+	for (const FRunningStats& Axis : GyroStats)
+	{
+		bStationary &= FMath::Sqrt(Axis.GetVariance()) <= GyroNoiseThreshold;
+	}
+
+	const FVector WindowMean(GyroStats[0].Mean, GyroStats[1].Mean, GyroStats[2].Mean);
+	bStationary &= WindowMean.Size() <= MaxStationaryRate;
+
+	if (bStationary)
+	{
+		// Trust the first windows heavily, then settle to a slow blend that follows drift.
+		const float Blend = bHasEstimate ? FMath::Max(1.0f - Confidence, MinBiasBlend) : 1.0f;
+		Bias = bHasEstimate ? FMath::Lerp(Bias, WindowMean, Blend) : WindowMean;
+		Confidence = FMath::Min(Confidence + ConfidenceGainPerWindow, 1.0f);
+		bHasEstimate = true;
+	}
+	else
+	{
+		Confidence = FMath::Max(Confidence - ConfidenceDecayPerSecond * Elapsed, 0.0f);
+	}
+
+	ResetWindow();
+}
+
+void FGyroBiasEstimator::SetBias(const FVector& InBias, const float InConfidence)
+{
+	Bias = InBias;
+	Confidence = FMath::Clamp(InConfidence, 0.0f, 1.0f);
+	bHasEstimate = true;
+	ResetWindow();
+}
+
+void FGyroBiasEstimator::Reset()
+{
+	Bias = FVector::ZeroVector;
+	Confidence = 0.0f;
+	bHasEstimate = false;
+	ResetWindow();
+}
+
+void FGyroBiasEstimator::ResetWindow()
+{
+	for (FRunningStats& Axis : GyroStats)
+	{
+		Axis = FRunningStats();
+	}
+	AccelMagnitudeStats = FRunningStats();
+	WindowElapsed = 0.0f;
+}
@@ -0,0 +1,220 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Algorithms/HapticDecimator.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#define DS_DECIMATOR_SSE 1
+#include <emmintrin.h>
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+#define DS_DECIMATOR_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+	/**
+	 * Zeroth-order modified Bessel function of the first kind, for the Kaiser window.
+	 */
+	double BesselI0(const double X)
+	{
+		double Sum = 1.0;
+		double Term = 1.0;
+		const double HalfX = X * 0.5;
+		for (int32 K = 1; K < 64; ++K)
+		{
+			Term *= (HalfX / K) * (HalfX / K);
+			Sum += Term;
+			if (Term < Sum * 1e-12)
+			{
+				break;
+			}
+		}
+		return Sum;
+	}
+
+	/**
+	 * Dot product of two float arrays. Count must be a multiple of 8.
+	 */
+	float DotProduct(const float* RESTRICT A, const float* RESTRICT B, const int32 Count)
+	{
+#if DS_DECIMATOR_SSE
+		__m128 Sum0 = _mm_setzero_ps();
+		__m128 Sum1 = _mm_setzero_ps();
+		for (int32 i = 0; i < Count; i += 8)
+		{
+			Sum0 = _mm_add_ps(Sum0, _mm_mul_ps(_mm_loadu_ps(A + i), _mm_loadu_ps(B + i)));
+			Sum1 = _mm_add_ps(Sum1, _mm_mul_ps(_mm_loadu_ps(A + i + 4), _mm_loadu_ps(B + i + 4)));
+		}
+		__m128 Sum = _mm_add_ps(Sum0, Sum1);
+		Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+		Sum = _mm_add_ss(Sum, _mm_shuffle_ps(Sum, Sum, 0x55));
+		return _mm_cvtss_f32(Sum);
+#elif DS_DECIMATOR_NEON
+		float32x4_t Sum0 = vdupq_n_f32(0.0f);
+		float32x4_t Sum1 = vdupq_n_f32(0.0f);
+		for (int32 i = 0; i < Count; i += 8)
+		{
+			Sum0 = vfmaq_f32(Sum0, vld1q_f32(A + i), vld1q_f32(B + i));
+			Sum1 = vfmaq_f32(Sum1, vld1q_f32(A + i + 4), vld1q_f32(B + i + 4));
+		}
+		return vaddvq_f32(vaddq_f32(Sum0, Sum1));
+#else
+		float Sum = 0.0f;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Sum += A[i] * B[i];
+		}
+		return Sum;
+#endif
+	}
+} // namespace
+
+bool FHapticDecimator::Init(const int32 InInputRate, const int32 InOutputRate, const int32 InNumChannels, const int32 InMaxInputFrames)
+{
+	InputRate = 0;
+	NumChannels = 0;
+	if (InInputRate <= 0 || InOutputRate <= 0 || InOutputRate > InInputRate || InNumChannels <= 0 || InMaxInputFrames <= 0)
+	{
+		return false;
+	}
+
+	const int32 Divisor = FMath::GreatestCommonDivisor(InInputRate, InOutputRate);
+	Interpolation = InOutputRate / Divisor;
+	Decimation = InInputRate / Divisor;
+	if (Interpolation > MaxInterpolation)
+	{
+		return false;
+	}
+
+	// Pass up to a third of the output rate, stop at its Nyquist frequency; the actuators respond below ~1 kHz anyway.
+	const double PrototypeRate = static_cast<double>(InInputRate) * Interpolation;
+	const double PassbandEdge = InOutputRate / 3.0;
+	const double StopbandEdge = InOutputRate * 0.5;
+	const double Cutoff = (PassbandEdge + StopbandEdge) * 0.5 / PrototypeRate;
+	const double Transition = (StopbandEdge - PassbandEdge) / PrototypeRate;
+
+	// Kaiser's estimates for the window shape and the filter length.
+	const double Beta = 0.1102 * (StopbandAttenuationDb - 8.7);
+	const int32 Length = FMath::CeilToInt32((StopbandAttenuationDb - 7.95) / (2.285 * 2.0 * PI * Transition)) + 1;
+	TapsPerPhase = Align(FMath::DivideAndRoundUp(Length, Interpolation), 8);
+
+	Coefficients.SetNumZeroed(Interpolation * TapsPerPhase);
+	const double Center = (Length - 1) * 0.5;
+	const double WindowNorm = BesselI0(Beta);
+	double Sum = 0.0;
+	TArray<double> Prototype;
+	Prototype.SetNumZeroed(Interpolation * TapsPerPhase);
+	for (int32 n = 0; n < Length; ++n)
+	{
+		const double X = n - Center;
+		const double Sinc = X == 0.0 ? 2.0 * Cutoff : FMath::Sin(2.0 * PI * Cutoff * X) / (PI * X);
+		const double Ratio = X / Center;
+		const double Window = BesselI0(Beta * FMath::Sqrt(FMath::Max(0.0, 1.0 - Ratio * Ratio))) / WindowNorm;
+		Prototype[n] = Sinc * Window;
+		Sum += Prototype[n];
+	}
+
+	// Unity DC gain per output sample: zero stuffing spreads the input over Interpolation phases.
+	const double Gain = Interpolation / Sum;
+	for (int32 Phase = 0; Phase < Interpolation; ++Phase)
+	{
+		float* Taps = &Coefficients[Phase * TapsPerPhase];
+		for (int32 Tap = 0; Tap < TapsPerPhase; ++Tap)
+		{
+			Taps[TapsPerPhase - 1 - Tap] = static_cast<float>(Prototype[Phase + Tap * Interpolation] * Gain);
+		}
+	}
+
+	MaxInputFrames = InMaxInputFrames;
+	HistoryCapacity = TapsPerPhase - 1 + MaxInputFrames;
+	History.SetNumUninitialized(InNumChannels * HistoryCapacity);
+	HighPassState.SetNumUninitialized(InNumChannels);
+
+	InputRate = InInputRate;
+	NumChannels = InNumChannels;
+	Reset();
+	return true;
+}
+
+void FHapticDecimator::SetHighPass(const float InAlpha, const float InGain)
+{
+	bHighPass = true;
+	HighPassAlpha = InAlpha;
+	HighPassGain = InGain;
+}
+
+void FHapticDecimator::Reset()
+{
+	// Start with a silent history, so the first outputs need no special case.
+	FMemory::Memzero(History.GetData(), History.Num() * sizeof(float));
+	FMemory::Memzero(HighPassState.GetData(), HighPassState.Num() * sizeof(float));
+	HistoryCount = TapsPerPhase - 1;
+	Position = static_cast<int64>(HistoryCount) * Interpolation;
+}
+
+int32 FHapticDecimator::Process(const float* Input, int32 NumInputFrames, float* Output, const int32 MaxOutputFrames)
+{
+	if (NumChannels == 0)
+	{
+		return 0;
+	}
+
+	int32 Written = 0;
+	while (NumInputFrames > 0)
+	{
+		const int32 Chunk = FMath::Min(NumInputFrames, MaxInputFrames);
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			float* Destination = &History[Channel * HistoryCapacity + HistoryCount];
+			for (int32 Frame = 0; Frame < Chunk; ++Frame)
+			{
+				Destination[Frame] = Input[Frame * NumChannels + Channel];
+			}
+		}
+		HistoryCount += Chunk;
+
+		for (; Position / Interpolation < HistoryCount; Position += Decimation)
+		{
+			if (Written >= MaxOutputFrames)
+			{
+				continue;
+			}
+
+			const int32 Newest = static_cast<int32>(Position / Interpolation);
+			const float* Taps = &Coefficients[static_cast<int32>(Position % Interpolation) * TapsPerPhase];
+			float* OutFrame = Output + Written * NumChannels;
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				const float* Samples = &History[Channel * HistoryCapacity + Newest - (TapsPerPhase - 1)];
+				float Sample = DotProduct(Taps, Samples, TapsPerPhase);
+				if (bHighPass)
+				{
+					float& Low = HighPassState[Channel];
+					Low = HighPassGain * Sample + HighPassAlpha * Low;
+					Sample -= Low;
+				}
+				OutFrame[Channel] = Sample;
+			}
+			++Written;
+		}
+
+		// Keep the samples the next output still reaches back to.
+		const int32 Discard = FMath::Min(static_cast<int32>(Position / Interpolation) - (TapsPerPhase - 1), HistoryCount);
+		if (Discard > 0)
+		{
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				float* Samples = &History[Channel * HistoryCapacity];
+				FMemory::Memmove(Samples, Samples + Discard, (HistoryCount - Discard) * sizeof(float));
+			}
+			HistoryCount -= Discard;
+			Position -= static_cast<int64>(Discard) * Interpolation;
+		}
+
+		Input += Chunk * NumChannels;
+		NumInputFrames -= Chunk;
+	}
+	return Written;
+}
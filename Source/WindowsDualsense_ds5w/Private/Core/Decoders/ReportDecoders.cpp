@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Decoders/ReportDecoders.h"
+
+FReportDecodeFunction FReportDecoders::Select(const EDeviceType DeviceType, const EDeviceConnection ConnectionType)
+{
+	const bool bIsBluetooth = ConnectionType == EDeviceConnection::Bluetooth;
+	switch (DeviceType)
+	{
+		case EDeviceType::DualSense:
+			return bIsBluetooth ? &DecodeInputReport<FDualSenseBluetoothLayout> : &DecodeInputReport<FDualSenseUsbLayout>;
+		case EDeviceType::DualSenseEdge:
+			return bIsBluetooth ? &DecodeInputReport<FDualSenseEdgeBluetoothLayout> : &DecodeInputReport<FDualSenseEdgeUsbLayout>;
+		case EDeviceType::DualShock4:
+			return bIsBluetooth ? &DecodeInputReport<FDualShockBluetoothLayout> : &DecodeInputReport<FDualShockUsbLayout>;
+		default:
+			return nullptr;
+	}
+}
@@ -12,7 +12,9 @@
 #include "Core/Structs/DeviceContext.h"
 #include "Core/Structs/OutputContext.h"
 #include "GameFramework/InputSettings.h"
+#include "GenericPlatform/GenericPlatformInputDeviceMapper.h"
 #include "HAL/PlatformProcess.h"
+#include "Misc/CoreDelegates.h"
 #include "Runtime/Launch/Resources/Version.h"
 
 // #if PLATFORM_WINDOWS
@@ -22,23 +24,26 @@
 TSharedPtr<FDeviceRegistry> FDeviceRegistry::Instance;
 TMap<FString, FInputDeviceId> FDeviceRegistry::KnownDevicePaths;
 TMap<FString, FInputDeviceId> FDeviceRegistry::HistoryDevices;
-TMap<FInputDeviceId, ISonyGamepadInterface*> FDeviceRegistry::LibraryInstances;
+FLibrarySlotTable FDeviceRegistry::LibraryInstances;
 
-bool PrimaryTick = true;
 void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 {
-	if (!PrimaryTick)
+	ShutdownRetiredLibraries(false);
+
+	AccumulatorDelta += DeltaTime;
+	if (bIsDeviceDetectionInProgress)
 	{
-		AccumulatorDelta += DeltaTime;
-		if (AccumulatorDelta < 2.0f || bIsDeviceDetectionInProgress)
-		{
-			return;
-		}
+		return;
+	}
 
-		AccumulatorDelta = 0.0f;
+	const bool bPollDue = (!bHotplugActive || bRetryDetection) && AccumulatorDelta >= PollingInterval;
+	if (!bDetectionRequested.exchange(false) && !bPollDue)
+	{
+		return;
 	}
 
-	PrimaryTick = false;
+	AccumulatorDelta = 0.0f;
+	bRetryDetection = false;
 	bIsDeviceDetectionInProgress = true;
 
 	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakManager = AsWeak()]() {
@@ -46,13 +51,19 @@ void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 		DetectedDevices.Reset();
 
 		IPlatformHardwareInfoInterface::Get().Detect(DetectedDevices);
-		AsyncTask(ENamedThreads::GameThread, [WeakManager, DetectedDevices = MoveTemp(DetectedDevices)]() mutable {
+		const bool bRetry = IPlatformHardwareInfoInterface::Get().NeedsDetectionRetry();
+		AsyncTask(ENamedThreads::GameThread, [WeakManager, DetectedDevices = MoveTemp(DetectedDevices), bRetry]() mutable {
 			const TSharedPtr<FDeviceRegistry> Manager = WeakManager.Pin();
 			if (!Manager)
 			{
 				return;
 			}
 
+			if (bRetry)
+			{
+				Manager->bRetryDetection = true;
+			}
+
 			TSet<FString> CurrentlyConnectedPaths;
 			for (const FDeviceContext& Context : DetectedDevices)
 			{
@@ -66,7 +77,7 @@ void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 				const FInputDeviceId& DeviceId = KnownDevice.Value;
 				if (!CurrentlyConnectedPaths.Contains(Path))
 				{
-					if (Manager->LibraryInstances.Contains(DeviceId))
+					if (Manager->LibraryInstances.Find(DeviceId))
 					{
 						Manager->RemoveLibraryInstance(DeviceId);
 						DisconnectedPaths.Add(Path);
@@ -74,6 +85,15 @@ void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 				}
 			}
 
+			// A device unplugged while it was being connected: its handle is dead, so FinishLibraryInstance() must drop it.
+			for (const FString& Path : Manager->PendingDevicePaths)
+			{
+				if (!CurrentlyConnectedPaths.Contains(Path))
+				{
+					Manager->VanishedPendingPaths.Add(Path);
+				}
+			}
+
 			for (const FString& Path : DisconnectedPaths)
 			{
 				if (Manager->KnownDevicePaths.Contains(Path))
@@ -84,19 +104,9 @@ void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 
 			for (FDeviceContext& Context : DetectedDevices)
 			{
-				if (!Manager->KnownDevicePaths.Contains(Context.Path))
+				if (!Manager->KnownDevicePaths.Contains(Context.Path) && !Manager->PendingDevicePaths.Contains(Context.Path))
 				{
 					Context.Output = FOutputContext();
-					if (!IPlatformHardwareInfoInterface::Get().CreateHandle(&Context))
-					{
-						UE_LOG(LogTemp, Log, TEXT("DualSense: DeviceManager Failed to create handle for device %s."), *Context.Path);
-						continue;
-					}
-
-					if (Context.Handle == INVALID_PLATFORM_HANDLE)
-					{
-						continue;
-					}
 					Manager->CreateLibraryInstance(Context);
 				}
 			}
@@ -112,33 +122,120 @@ TSharedPtr<FDeviceRegistry> FDeviceRegistry::Get()
 	{
 		check(IsInGameThread());
 		Instance = MakeShared<FDeviceRegistry>();
+		Instance->StartHotplugNotifications();
+		Instance->BindMappingEvents();
 	}
 	return Instance;
 }
 
+void FDeviceRegistry::BindMappingEvents()
+{
+	IPlatformInputDeviceMapper& Mapper = IPlatformInputDeviceMapper::Get();
+	ConnectionChangeHandle = Mapper.GetOnInputDeviceConnectionChange().AddLambda(
+	    [this](EInputDeviceConnectionState, FPlatformUserId, FInputDeviceId) { InvalidateControllerResolution(); });
+	PairingChangeHandle = Mapper.GetOnInputDevicePairingChange().AddLambda(
+	    [this](FInputDeviceId, FPlatformUserId, FPlatformUserId) { InvalidateControllerResolution(); });
+	UserLoginChangeHandle = FCoreDelegates::OnUserLoginChangedEvent.AddLambda(
+	    [this](bool, int32, int32) { InvalidateControllerResolution(); });
+}
+
+void FDeviceRegistry::UnbindMappingEvents()
+{
+	IPlatformInputDeviceMapper::Get().GetOnInputDeviceConnectionChange().Remove(ConnectionChangeHandle);
+	IPlatformInputDeviceMapper::Get().GetOnInputDevicePairingChange().Remove(PairingChangeHandle);
+	FCoreDelegates::OnUserLoginChangedEvent.Remove(UserLoginChangeHandle);
+}
+
+FInputDeviceId FDeviceRegistry::ResolveControllerDevice(const int32 ControllerId)
+{
+	// We should never call into IPlatformInputDeviceMapper from non-game thread because it is not thread-safe
+	check(IsInGameThread());
+
+	if (ControllerId < 0)
+	{
+		return FInputDeviceId::CreateFromInternalId(INDEX_NONE);
+	}
+
+	if (ResolvedVersion != MappingVersion)
+	{
+		ResolvedControllers.Reset();
+		ResolvedVersion = MappingVersion;
+	}
+
+	// A library can lose its device before the next detection removes it, so a cached device is confirmed first.
+	if (ResolvedControllers.IsValidIndex(ControllerId) && ResolvedControllers[ControllerId].bResolved)
+	{
+		const FInputDeviceId Cached = ResolvedControllers[ControllerId].DeviceId;
+		if (!Cached.IsValid() || GetLibraryInstance(Cached))
+		{
+			return Cached;
+		}
+	}
+
+	FInputDeviceId Resolved = FInputDeviceId::CreateFromInternalId(INDEX_NONE);
+	ResolveScratch.Reset();
+	IPlatformInputDeviceMapper::Get().GetAllInputDevicesForUser(FPlatformUserId::CreateFromInternalId(ControllerId), ResolveScratch);
+	for (const FInputDeviceId& DeviceId : ResolveScratch)
+	{
+		if (GetLibraryInstance(DeviceId))
+		{
+			Resolved = DeviceId;
+			break;
+		}
+	}
+
+	if (ControllerId >= ResolvedControllers.Num())
+	{
+		ResolvedControllers.SetNum(ControllerId + 1);
+	}
+	ResolvedControllers[ControllerId].DeviceId = Resolved;
+	ResolvedControllers[ControllerId].bResolved = true;
+	return Resolved;
+}
+
+void FDeviceRegistry::StartHotplugNotifications()
+{
+	// The registry unregisters in its destructor, which waits for a callback in flight, so capturing this is safe.
+	bHotplugActive = IPlatformHardwareInfoInterface::Get().StartHotplugNotifications([this]() {
+		bDetectionRequested.store(true);
+	});
+}
+
 FDeviceRegistry::~FDeviceRegistry()
 {
+	if (bHotplugActive)
+	{
+		IPlatformHardwareInfoInterface::Get().StopHotplugNotifications();
+		bHotplugActive = false;
+	}
+	UnbindMappingEvents();
+
 	TArray<FInputDeviceId> WatcherKeys;
-	LibraryInstances.GetKeys(WatcherKeys);
+	LibraryInstances.ForEach([&WatcherKeys](const FInputDeviceId& DeviceId, ISonyGamepadInterface*) {
+		WatcherKeys.Add(DeviceId);
+	});
 
 	for (const FInputDeviceId& ControllerId : WatcherKeys)
 	{
 		RemoveLibraryInstance(ControllerId);
 	}
+	ShutdownRetiredLibraries(true);
 }
 
 ISonyGamepadInterface* FDeviceRegistry::GetLibraryInstance(const FInputDeviceId& DeviceId)
 {
-	if (!LibraryInstances.Contains(DeviceId))
-	{
-		return nullptr;
-	}
+	ISonyGamepadInterface* Library = LibraryInstances.Find(DeviceId);
+	return Library && Library->IsConnected() ? Library : nullptr;
+}
 
-	if (!LibraryInstances[DeviceId]->IsConnected())
+FLibrarySlotTable::FPinned FDeviceRegistry::PinLibraryInstance(const FInputDeviceId& DeviceId)
+{
+	FLibrarySlotTable::FPinned Library = LibraryInstances.Pin(DeviceId);
+	if (Library && !Library->IsConnected())
 	{
-		return nullptr;
+		Library.Release();
 	}
-	return LibraryInstances[DeviceId];
+	return Library;
 }
 
 void FDeviceRegistry::RemoveLibraryInstance(const FInputDeviceId& GamepadId)
@@ -146,19 +243,39 @@ void FDeviceRegistry::RemoveLibraryInstance(const FInputDeviceId& GamepadId)
 	// We should never call into IPlatformInputDeviceMapper from non-game thread because it is not thread-safe
 	check(IsInGameThread());
 
-	if (!LibraryInstances.Contains(GamepadId))
+	ISonyGamepadInterface* Library = LibraryInstances.Remove(GamepadId);
+	if (!Library)
 	{
 		return;
 	}
+	InvalidateControllerResolution();
 
 	IPlatformInputDeviceMapper::Get().Internal_SetInputDeviceConnectionState(GamepadId, EInputDeviceConnectionState::Disconnected);
 
-	LibraryInstances[GamepadId]->ShutdownLibrary();
-	LibraryInstances.Remove(GamepadId);
+	// Other threads may still hold a pin; the library is shut down by a later tick once they released it.
+}
+
+void FDeviceRegistry::ShutdownRetiredLibraries(const bool bWait)
+{
+	// No other thread holds these libraries anymore, so their threads and handles can be torn down.
+	auto Shutdown = [](ISonyGamepadInterface* Library) {
+		Library->ShutdownLibrary();
+	};
+	if (bWait)
+	{
+		LibraryInstances.FlushRetired(Shutdown);
+	}
+	else
+	{
+		LibraryInstances.CollectRetired(Shutdown);
+	}
 }
 
 void FDeviceRegistry::CreateLibraryInstance(FDeviceContext& Context)
 {
+	// We should never call into IPlatformInputDeviceMapper from non-game thread because it is not thread-safe
+	check(IsInGameThread());
+
 	ISonyGamepadInterface* SonyGamepad = nullptr;
 	if (Context.DeviceType == EDeviceType::DualSense || Context.DeviceType == EDeviceType::DualSenseEdge)
 	{
@@ -175,21 +292,6 @@ void FDeviceRegistry::CreateLibraryInstance(FDeviceContext& Context)
 		return;
 	}
 
-	TArray<FInputDeviceId> Devices;
-	Devices.Reset();
-
-	// We should never call into IPlatformInputDeviceMapper from non-game thread because it is not thread-safe
-	check(IsInGameThread());
-
-	IPlatformInputDeviceMapper::Get().GetAllInputDevicesForUser(
-	    IPlatformInputDeviceMapper::Get().GetPrimaryPlatformUser(), Devices);
-
-	bool AllocateDeviceToDefaultUser = false;
-	if (Devices.Num() <= 1)
-	{
-		AllocateDeviceToDefaultUser = true;
-	}
-
 	const FName UniqueNamespace = TEXT("DeviceManager.WindowsDualsense");
 	const FHardwareDeviceIdentifier HardwareId(UniqueNamespace, *Context.Path);
 	if (HistoryDevices.Contains(Context.Path))
@@ -203,12 +305,94 @@ void FDeviceRegistry::CreateLibraryInstance(FDeviceContext& Context)
 	}
 
 	SonyGamepad->_getUObject()->AddToRoot();
-	SonyGamepad->InitializeLibrary(Context);
+	PendingDevicePaths.Add(Context.Path);
+
+	// Opening the handles and the initial handshake block on the device, up to a 100 ms wait for Bluetooth
+	// controllers, so they run on a worker; the library is not reachable from the registry until it is ready.
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakManager = AsWeak(), SonyGamepad, Context]() mutable {
+		// Invalidating a handle clears the context path, so keep what the game thread needs aside.
+		const FString Path = Context.Path;
+		const FInputDeviceId DeviceId = Context.UniqueInputDeviceId;
+		bool bReady = false;
+		if (!IPlatformHardwareInfoInterface::Get().CreateHandle(&Context) || Context.Handle == INVALID_PLATFORM_HANDLE)
+		{
+			UE_LOG(LogTemp, Log, TEXT("DualSense: DeviceManager Failed to create handle for device %s."), *Path);
+			IPlatformHardwareInfoInterface::Get().InvalidateHandle(&Context);
+		}
+		else
+		{
+			bReady = SonyGamepad->InitializeLibrary(Context);
+			if (!bReady)
+			{
+				SonyGamepad->ShutdownLibrary();
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakManager, SonyGamepad, Path, DeviceId, bReady]() {
+			const TSharedPtr<FDeviceRegistry> Manager = WeakManager.Pin();
+			if (!Manager)
+			{
+				if (bReady)
+				{
+					SonyGamepad->ShutdownLibrary();
+				}
+				SonyGamepad->_getUObject()->RemoveFromRoot();
+				return;
+			}
+			Manager->FinishLibraryInstance(SonyGamepad, Path, DeviceId, bReady);
+		});
+	});
+}
+
+void FDeviceRegistry::FinishLibraryInstance(ISonyGamepadInterface* SonyGamepad, const FString& Path, const FInputDeviceId& DeviceId,
+                                            const bool bReady)
+{
+	check(IsInGameThread());
+
+	PendingDevicePaths.Remove(Path);
+	if (!bReady)
+	{
+		VanishedPendingPaths.Remove(Path);
+		SonyGamepad->_getUObject()->RemoveFromRoot();
+		bRetryDetection = true;
+		return;
+	}
+
+	if (VanishedPendingPaths.Remove(Path) > 0)
+	{
+		// It may have come back on the same path meanwhile; a fresh detection connects it again with a live handle.
+		UE_LOG(LogTemp, Log, TEXT("DualSense: DeviceManager dropped device %s, disconnected while it was connecting."), *Path);
+		SonyGamepad->ShutdownLibrary();
+		SonyGamepad->_getUObject()->RemoveFromRoot();
+		bDetectionRequested.store(true);
+		return;
+	}
 
-	KnownDevicePaths.Add(Context.Path, Context.UniqueInputDeviceId);
-	LibraryInstances.Add(Context.UniqueInputDeviceId, SonyGamepad);
+	if (!LibraryInstances.Add(DeviceId, SonyGamepad))
+	{
+		UE_LOG(LogTemp, Error, TEXT("DualSense: DeviceManager cannot store device %d (%s): id beyond %d or already in use."),
+		       DeviceId.GetId(), *Path, FLibrarySlotTable::Capacity);
+		SonyGamepad->ShutdownLibrary();
+		SonyGamepad->_getUObject()->RemoveFromRoot();
+		return;
+	}
+	InvalidateControllerResolution();
+
+	TArray<FInputDeviceId> Devices;
+	Devices.Reset();
 
-	FInputDeviceId GamepadId = Context.UniqueInputDeviceId;
+	IPlatformInputDeviceMapper::Get().GetAllInputDevicesForUser(
+	    IPlatformInputDeviceMapper::Get().GetPrimaryPlatformUser(), Devices);
+
+	bool AllocateDeviceToDefaultUser = false;
+	if (Devices.Num() <= 1)
+	{
+		AllocateDeviceToDefaultUser = true;
+	}
+
+	KnownDevicePaths.Add(Path, DeviceId);
+
+	FInputDeviceId GamepadId = DeviceId;
 	if (
 	    IPlatformInputDeviceMapper::Get().GetInputDeviceConnectionState(GamepadId) !=
 	    EInputDeviceConnectionState::Connected)
@@ -226,7 +410,7 @@ void FDeviceRegistry::CreateLibraryInstance(FDeviceContext& Context)
 #endif
 		}
 
-		IPlatformInputDeviceMapper::Get().Internal_MapInputDeviceToUser(Context.UniqueInputDeviceId,
+		IPlatformInputDeviceMapper::Get().Internal_MapInputDeviceToUser(DeviceId,
 		                                                                UserId,
 		                                                                EInputDeviceConnectionState::Connected);
 	}
@@ -239,5 +423,19 @@ int32 FDeviceRegistry::GetAllocatedDevices()
 
 TMap<FInputDeviceId, ISonyGamepadInterface*> FDeviceRegistry::GetAllocatedDevicesMap()
 {
-	return LibraryInstances;
+	TMap<FInputDeviceId, ISonyGamepadInterface*> Devices;
+	LibraryInstances.ForEach([&Devices](const FInputDeviceId& DeviceId, ISonyGamepadInterface* Library) {
+		Devices.Add(DeviceId, Library);
+	});
+	return Devices;
+}
+
+void FDeviceRegistry::FlushOutputs()
+{
+	LibraryInstances.ForEach([](const FInputDeviceId&, ISonyGamepadInterface* Library) {
+		if (Library->IsConnected())
+		{
+			Library->FlushOutput();
+		}
+	});
 }
@@ -5,14 +5,32 @@
 #include "Core/DualSense/DualSenseLibrary.h"
 #include "Async/Async.h"
 #include "Async/TaskGraphInterfaces.h"
-#include "Core/Algorithms/MadgwickAhrs.h"
+#include "Core/Decoders/ReportDecoders.h"
+#include "Core/ImuCalibrationRegistry.h"
 #include "Core/Interfaces/PlatformHardwareInfoInterface.h"
 #include "Core/PlayStationOutputComposer.h"
 #include "Core/Structs/OutputContext.h"
+#include "Core/Threads/HapticFrameRing.h"
 #include "DeviceManager.h"
 #include "Helpers/ValidateHelpers.h"
 #include "InputCoreTypes.h"
 
+namespace
+{
+	// Official PlayStation DualSense scaling constants (from kernel driver), the resolution calibrated samples are normalized to
+	constexpr float DS_ACC_RES_PER_G = 8192.0f;      // counts per 1 g
+	constexpr float DS_GYRO_RES_PER_DEG_S = 1024.0f; // counts per 1 deg/s
+	// Peak-to-peak noise of a resting controller; the calibration dead zone is a fraction of these bands.
+	constexpr float DS_GYRO_NOISE_BAND = 0.5f * DS_GYRO_RES_PER_DEG_S;
+	constexpr float DS_ACC_NOISE_BAND = 0.02f * DS_ACC_RES_PER_G;
+	constexpr float G_TO_MS2 = 9.80665f;
+	constexpr float DEG2RAD = 3.14159265358979323846f / 180.0f;
+	// The sensor timestamp counts in units of 1/3 microsecond.
+	constexpr double DS_SENSOR_TIMESTAMP_TICK_SECONDS = 1.0 / 3000000.0;
+	// Gaps longer than this mean the sample stream was interrupted rather than slow.
+	constexpr float DS_MAX_SENSOR_SAMPLE_DELTA = 0.1f;
+} // namespace
+
 bool UDualSenseLibrary::InitializeLibrary(const FDeviceContext& Context)
 {
 	HIDDeviceContexts = Context;
@@ -23,6 +41,9 @@ bool UDualSenseLibrary::InitializeLibrary(const FDeviceContext& Context)
 		EnableReport->Feature.FeatureMode = 0x55;
 		EnableReport->Lightbar = {0, 0, 222};
 		EnableReport->PlayerLed.Brightness = 0x00;
+		// Written synchronously, before the output writer is attached: the controller must accept the
+		// feature flags before the audio setup below. The registry runs this on a connection worker, so
+		// neither the write nor the wait stalls the game thread.
 		SendOut();
 
 		FPlatformProcess::Sleep(0.1f);
@@ -38,19 +59,47 @@ bool UDualSenseLibrary::InitializeLibrary(const FDeviceContext& Context)
 		HIDDeviceContexts.BufferAudio[9] = 50;
 	}
 
+	OutputWriter = MakeUnique<FOutputWriterThread>(&HIDDeviceContexts);
+	if (OutputWriter->Start())
+	{
+		HIDDeviceContexts.OutputWriter = OutputWriter.Get();
+		HIDDeviceContexts.HandledFailedWrites = 0;
+	}
+
 	StopAll();
-	return true;
+
+	// Cached by controller address, so a reconnect only waits for the pairing info report, not the calibration.
+	ImuCalibration = FImuCalibrationRegistry::Load(&HIDDeviceContexts);
+	ReportDecoder = FReportDecoders::Select(HIDDeviceContexts.DeviceType, HIDDeviceContexts.ConnectionType);
+	InputReader = MakeUnique<FInputReaderThread>(&HIDDeviceContexts);
+	return InputReader->Start();
 }
 
 void UDualSenseLibrary::ShutdownLibrary()
 {
-	ButtonStates.Reset();
+	ButtonState.Reset();
+	InputState = FGamepadInputState();
+	MotionFilter.Reset();
+	bMotionFilterInitialized = false;
+	bHasSensorTimestamp = false;
+	BiasEstimator.Reset();
+	if (InputReader)
+	{
+		InputReader->Shutdown();
+		InputReader.Reset();
+	}
+	if (OutputWriter)
+	{
+		HIDDeviceContexts.OutputWriter = nullptr;
+		OutputWriter->Shutdown();
+		OutputWriter.Reset();
+	}
 	IPlatformHardwareInfoInterface::Get().InvalidateHandle(&HIDDeviceContexts);
 }
 
 bool UDualSenseLibrary::IsConnected()
 {
-	return HIDDeviceContexts.IsConnected;
+	return HIDDeviceContexts.IsConnected && !(InputReader && InputReader->IsDeviceLost());
 }
 
 void UDualSenseLibrary::SendOut()
@@ -89,39 +138,156 @@ void UDualSenseLibrary::Settings(const FDualSenseFeatureReport& Settings)
 	{
 		HidOutput->Audio.Mode = 0x21;
 	}
+	MarkOutputDirty();
+}
+
+void UDualSenseLibrary::FlushOutput()
+{
+	if (!bOutputDirty && !FPlayStationOutputComposer::IsResendDue(HIDDeviceContexts))
+	{
+		return;
+	}
+
+	bOutputDirty = false;
 	SendOut();
 }
 
-void UDualSenseLibrary::CheckButtonInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
-                                         const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
-                                         const FName ButtonName, const bool IsButtonPressed)
+void UDualSenseLibrary::DispatchButtons(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+                                        const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+                                        const uint64 Buttons)
+{
+	ButtonState.Update(Buttons, EGamepadButton::DigitalBits, InMessageHandler, UserId, InputDeviceId,
+	                   bEnableSubFrameInput ? &SubFrameInputEvents : nullptr, CurrentReportTimestamp);
+}
+
+void UDualSenseLibrary::ProcessMotionSample(const FGamepadInputState& State)
 {
-	const bool PreviousState = ButtonStates.Contains(ButtonName) ? ButtonStates[ButtonName] : false;
-	if (IsButtonPressed && !PreviousState)
+	// Integrate over the time the controller measured between samples, not the game frame time.
+	float SampleDelta = 0.0f;
+	if (bHasSensorTimestamp)
+	{
+		// Unsigned subtraction keeps the delta correct across the 32-bit counter wraparound.
+		const uint32 Ticks = State.SensorTimestamp - LastSensorTimestamp;
+		SampleDelta = static_cast<float>(Ticks * DS_SENSOR_TIMESTAMP_TICK_SECONDS);
+		if (SampleDelta > DS_MAX_SENSOR_SAMPLE_DELTA)
+		{
+			// The stream was interrupted; restart integration instead of applying one huge step.
+			SampleDelta = 0.0f;
+		}
+	}
+	LastSensorTimestamp = State.SensorTimestamp;
+	bHasSensorTimestamp = true;
+
+	FVector Gyro = ImuCalibration.CalibrateGyro(State.Gyro);
+	FVector Acc = ImuCalibration.CalibrateAccel(State.Accel);
+
+	if (bIsCalibrating)
+	{
+		AccumulatedGyro += Gyro;
+		AccumulatedAccel += Acc;
+
+		CalibrationSampleCount++;
+		if (FPlatformTime::Seconds() - CalibrationStartTime >= CalibrationDuration)
+		{
+			FinishMotionSensorCalibration();
+		}
+	}
+
+	BiasEstimator.AddSample(Gyro, Acc, SampleDelta);
+	if (BiasEstimator.HasEstimate())
+	{
+		// Continuously refined zero-rate offset, seeded by an explicit calibration when one was run.
+		Gyro -= BiasEstimator.GetBias();
+	}
+
+	if (bHasMotionSensorBaseline)
+	{
+		Acc -= AccelBaseline;
+
+		const float GyroDeadZone = DS_GYRO_NOISE_BAND * SensorsDeadZone;
+		const float AccelDeadZone = DS_ACC_NOISE_BAND * SensorsDeadZone;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (FMath::Abs(Gyro[Axis]) <= GyroDeadZone)
+			{
+				Gyro[Axis] = 0.0f;
+			}
+			if (FMath::Abs(Acc[Axis]) <= AccelDeadZone)
+			{
+				Acc[Axis] = 0.0f;
+			}
+		}
+	}
+
+	// Madgwick AHRS (IMU-only), fed with values converted from calibrated counts
+	// to SI using the official DS constants. Each controller owns its filter.
+	// Convert gyro (counts) -> deg/s -> rad/s
+	const float gx = static_cast<float>(Gyro.X) / DS_GYRO_RES_PER_DEG_S * DEG2RAD;
+	const float gy = static_cast<float>(Gyro.Y) / DS_GYRO_RES_PER_DEG_S * DEG2RAD;
+	const float gz = static_cast<float>(Gyro.Z) / DS_GYRO_RES_PER_DEG_S * DEG2RAD;
+
+	const float ax = static_cast<float>(Acc.X) / DS_ACC_RES_PER_G * G_TO_MS2;
+	const float ay = static_cast<float>(Acc.Y) / DS_ACC_RES_PER_G * G_TO_MS2;
+	const float az = static_cast<float>(Acc.Z) / DS_ACC_RES_PER_G * G_TO_MS2;
+
+	if (!bMotionFilterInitialized && SampleDelta > 0.0f)
 	{
-		InMessageHandler.Get().OnControllerButtonPressed(ButtonName, UserId, InputDeviceId, false);
+		MotionFilter.SetSampleFreq(1.0f / SampleDelta);
+		MotionFilter.SetBeta(0.08f);
+		bMotionFilterInitialized = true;
 	}
 
-	if (!IsButtonPressed && PreviousState)
+	if (bIsResetGyroscope)
 	{
-		InMessageHandler.Get().OnControllerButtonReleased(ButtonName, UserId, InputDeviceId, false);
+		MotionFilter.Reset();
+		bIsResetGyroscope = false;
 	}
 
-	ButtonStates.Add(ButtonName, IsButtonPressed);
+	// Update Madgwick filter (IMU-only)
+	MotionFilter.UpdateImu(gx, gy, -gz, ax, ay, -az, SampleDelta);
+
+	// Keep the same output vectors you already used elsewhere
+	MotionGyroscope = FVector(Gyro.X, Gyro.Z, Gyro.Y);
+	MotionAccelerometer = FVector(Acc.X, Acc.Z, Acc.Y);
+	MotionAccelMS2 = FVector(ax, az, ay);
 }
 
 void UDualSenseLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
                                     const FPlatformUserId UserId, const FInputDeviceId InputDeviceId, float Delta)
 {
-	FDeviceContext* Context = &HIDDeviceContexts;
-	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [NewContext = MoveTemp(Context)]() {
-		IPlatformHardwareInfoInterface::Get().Read(NewContext);
-	});
+	SubFrameInputEvents.Reset();
+	const bool bQueueAllReports = bEnableSubFrameInput || bEnableAccelerometerAndGyroscope;
+	if (InputReader && ReportDecoder)
+	{
+		if (bQueueAllReports)
+		{
+			// Replay every report received since the last update so presses shorter than a frame are not
+			// lost and every motion sample is integrated.
+			FInputReport QueuedReport;
+			FGamepadInputState QueuedState;
+			while (InputReader->DequeueReport(QueuedReport))
+			{
+				CurrentReportTimestamp = QueuedReport.Timestamp;
+				ReportDecoder(QueuedReport.Data, QueuedState);
+				if (bEnableSubFrameInput)
+				{
+					DispatchButtons(InMessageHandler, UserId, InputDeviceId, QueuedState.Buttons);
+				}
+				if (bEnableAccelerometerAndGyroscope)
+				{
+					ProcessMotionSample(QueuedState);
+				}
+			}
+		}
 
-	const size_t Padding = HIDDeviceContexts.ConnectionType == EDeviceConnection::Bluetooth ? 2 : 1;
-	const unsigned char* HIDInput = &HIDDeviceContexts.Buffer[Padding];
+		if (InputReader->ConsumeLatest())
+		{
+			CurrentReportTimestamp = InputReader->GetLatest().Timestamp;
+			ReportDecoder(InputReader->GetLatest().Data, InputState);
+		}
+	}
 
-	const auto HandleAnalogInput = [&](const FName& AnalogKey, const FName& ButtonKeyPositive, const FName& ButtonKeyNegative, float NewAxisValue) {
+	const auto HandleAnalogInput = [&](const FName& AnalogKey, const EGamepadButton::Type ButtonPositive, const EGamepadButton::Type ButtonNegative, float NewAxisValue) {
 		if (FMath::Abs(NewAxisValue) < AnalogDeadZone)
 		{
 			NewAxisValue = 0;
@@ -137,128 +303,34 @@ void UDualSenseLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageH
 		InMessageHandler->OnControllerAnalog(AnalogKey, UserId, InputDeviceId, NewAxisValue);
 		OldAxisValue = NewAxisValue;
 
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, ButtonKeyPositive, NewAxisValue > 0);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, ButtonKeyNegative, NewAxisValue < 0);
+		const uint64 AxisBits = EGamepadButton::Bit(ButtonPositive) | EGamepadButton::Bit(ButtonNegative);
+		const uint64 AxisButtons = NewAxisValue > 0 ? EGamepadButton::Bit(ButtonPositive) : NewAxisValue < 0 ? EGamepadButton::Bit(ButtonNegative) : 0;
+		ButtonState.Update(AxisButtons, AxisBits, InMessageHandler, UserId, InputDeviceId,
+		                   bEnableSubFrameInput ? &SubFrameInputEvents : nullptr, CurrentReportTimestamp);
 	};
 
 	// Analogs
-	const float LeftAnalogX = static_cast<float>(HIDInput[0x00] - 128) / 128;
-	const float LeftAnalogY = static_cast<float>(HIDInput[0x01] - 128) / -128;
-	const float RightAnalogX = static_cast<float>(HIDInput[0x02] - 128) / 128;
-	const float RightAnalogY = static_cast<float>(HIDInput[0x03] - 128) / -128;
-
-	HandleAnalogInput(FGamepadKeyNames::LeftAnalogX, FGamepadKeyNames::LeftStickRight, FGamepadKeyNames::LeftStickLeft, LeftAnalogX);
-	HandleAnalogInput(FGamepadKeyNames::LeftAnalogY, FGamepadKeyNames::LeftStickUp, FGamepadKeyNames::LeftStickDown, LeftAnalogY);
-	HandleAnalogInput(FGamepadKeyNames::RightAnalogX, FGamepadKeyNames::RightStickRight, FGamepadKeyNames::RightStickLeft, RightAnalogX);
-	HandleAnalogInput(FGamepadKeyNames::RightAnalogY, FGamepadKeyNames::RightStickUp, FGamepadKeyNames::RightStickDown, RightAnalogY);
-
-	const float TriggerL = HIDInput[0x04] / 256.0f;
-	const float TriggerR = HIDInput[0x05] / 256.0f;
+	const float LeftAnalogX = static_cast<float>(InputState.LeftStickX - 128) / 128;
+	const float LeftAnalogY = static_cast<float>(InputState.LeftStickY - 128) / -128;
+	const float RightAnalogX = static_cast<float>(InputState.RightStickX - 128) / 128;
+	const float RightAnalogY = static_cast<float>(InputState.RightStickY - 128) / -128;
+
+	HandleAnalogInput(FGamepadKeyNames::LeftAnalogX, EGamepadButton::LeftStickRight, EGamepadButton::LeftStickLeft, LeftAnalogX);
+	HandleAnalogInput(FGamepadKeyNames::LeftAnalogY, EGamepadButton::LeftStickUp, EGamepadButton::LeftStickDown, LeftAnalogY);
+	HandleAnalogInput(FGamepadKeyNames::RightAnalogX, EGamepadButton::RightStickRight, EGamepadButton::RightStickLeft, RightAnalogX);
+	HandleAnalogInput(FGamepadKeyNames::RightAnalogY, EGamepadButton::RightStickUp, EGamepadButton::RightStickDown, RightAnalogY);
+
+	const float TriggerL = InputState.LeftTrigger / 256.0f;
+	const float TriggerR = InputState.RightTrigger / 256.0f;
 	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::LeftTriggerAnalog, UserId, InputDeviceId, TriggerL);
 	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::RightTriggerAnalog, UserId, InputDeviceId, TriggerR);
 
-	uint8_t ButtonsMask = HIDInput[0x07] & 0xF0;
-	const bool bCross = ButtonsMask & BTN_CROSS;
-	const bool bSquare = ButtonsMask & BTN_SQUARE;
-	const bool bCircle = ButtonsMask & BTN_CIRCLE;
-	const bool bTriangle = ButtonsMask & BTN_TRIANGLE;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonBottom, bCross);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonLeft, bSquare);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonRight, bCircle);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonTop, bTriangle);
+	DispatchButtons(InMessageHandler, UserId, InputDeviceId, InputState.Buttons);
 
-	switch (HIDInput[0x07] & 0x0F)
-	{
-		case 0x0:
-			ButtonsMask |= BTN_DPAD_UP;
-			break;
-		case 0x4:
-			ButtonsMask |= BTN_DPAD_DOWN;
-			break;
-		case 0x6:
-			ButtonsMask |= BTN_DPAD_LEFT;
-			break;
-		case 0x2:
-			ButtonsMask |= BTN_DPAD_RIGHT;
-			break;
-		case 0x5:
-			ButtonsMask |= BTN_DPAD_LEFT | BTN_DPAD_DOWN;
-			break;
-		case 0x7:
-			ButtonsMask |= BTN_DPAD_LEFT | BTN_DPAD_UP;
-			break;
-		case 0x1:
-			ButtonsMask |= BTN_DPAD_RIGHT | BTN_DPAD_UP;
-			break;
-		case 0x3:
-			ButtonsMask |= BTN_DPAD_RIGHT | BTN_DPAD_DOWN;
-			break;
-		default:;
-	}
-	const bool bDPadLeft = ButtonsMask & BTN_DPAD_LEFT;
-	const bool bDPadDown = ButtonsMask & BTN_DPAD_DOWN;
-	const bool bDPadRight = ButtonsMask & BTN_DPAD_RIGHT;
-	const bool bDPadUp = ButtonsMask & BTN_DPAD_UP;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadUp, bDPadUp);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadDown, bDPadDown);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadLeft, bDPadLeft);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadRight, bDPadRight);
-
-	// Shoulders
-	const bool bLeftShoulder = HIDInput[0x08] & BTN_LEFT_SHOLDER;
-	const bool bRightShoulder = HIDInput[0x08] & BTN_RIGHT_SHOLDER;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftShoulder, bLeftShoulder);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightShoulder, bRightShoulder);
-
-	// Push Stick
-	const bool PushLeftStick = HIDInput[0x08] & BTN_LEFT_STICK;
-	const bool PushRightStick = HIDInput[0x08] & BTN_RIGHT_STICK;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PushLeftStick"), PushLeftStick);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PushRightStick"), PushRightStick);
-
-	// mapped urenal native gamepad Push Stick
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftThumb, PushLeftStick);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightThumb, PushRightStick);
-
-	// Function & Special Actions
-	const bool Playstation = HIDInput[0x09] & BTN_PLAYSTATION_LOGO;
-	const bool TouchPad = HIDInput[0x09] & BTN_PAD_BUTTON;
-	const bool Mic = HIDInput[0x09] & BTN_MIC_BUTTON;
-	const bool bFn1 = HIDInput[0x09] & BTN_FN1;
-	const bool bFn2 = HIDInput[0x09] & BTN_FN2;
-	const bool bPaddleLeft = HIDInput[0x09] & BTN_PADDLE_LEFT;
-	const bool bPaddleRight = HIDInput[0x09] & BTN_PADDLE_RIGHT;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Mic"), Mic);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_TouchButtom"), TouchPad);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Button"), Playstation);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_FunctionL"), bFn1);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_FunctionR"), bFn2);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PaddleL"), bPaddleLeft);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PaddleR"), bPaddleRight);
-
-	const bool Start = HIDInput[0x08] & BTN_START;
-	const bool Select = HIDInput[0x08] & BTN_SELECT;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Menu"), Start);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Share"), Select);
-
-	// mapped urenal native gamepad Start and Select
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::SpecialRight, Start);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::SpecialLeft, Select);
-
-	const bool bLeftTriggerThreshold = HIDInput[0x08] & BTN_LEFT_TRIGGER;
-	const bool bRightTriggerThreshold = HIDInput[0x08] & BTN_RIGHT_TRIGGER;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftTriggerThreshold,
-	                 bLeftTriggerThreshold);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightTriggerThreshold,
-	                 bRightTriggerThreshold);
 	if (bEnableTouch)
 	{
 		FTouchPoint1 Touch;
-		const int32 Touchpad1Raw = *reinterpret_cast<const int32*>(&HIDInput[0x20]);
+		const uint32 Touchpad1Raw = InputState.TouchPoints[0];
 		Touch.Y = (Touchpad1Raw & 0xFFF00000) >> 20;
 		Touch.X = (Touchpad1Raw & 0x000FFF00) >> 8;
 		Touch.Down = (Touchpad1Raw & (1 << 7)) == 0;
@@ -297,7 +369,7 @@ void UDualSenseLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageH
 		bWasTouch1Down = bIsTouchDown;
 
 		FTouchPoint2 Touch2;
-		const int32 Touchpad2Raw = *reinterpret_cast<const int32*>(&HIDInput[0x24]);
+		const uint32 Touchpad2Raw = InputState.TouchPoints[1];
 		Touch2.Y = (Touchpad2Raw & 0xFFF00000) >> 20;
 		Touch2.X = (Touchpad2Raw & 0x000FFF00) >> 8;
 		Touch2.Down = (Touchpad2Raw & (1 << 7)) == 0;
@@ -332,154 +404,9 @@ void UDualSenseLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageH
 
 	if (bEnableAccelerometerAndGyroscope)
 	{
-		FGyro Gyro;
-		Gyro.X = static_cast<int16_t>((HIDInput[16]) | (HIDInput[17] << 8));
-		Gyro.Y = static_cast<int16_t>((HIDInput[18]) | (HIDInput[19] << 8));
-		Gyro.Z = static_cast<int16_t>((HIDInput[20]) | (HIDInput[21] << 8));
-
-		FAccelerometer Acc;
-		Acc.X = static_cast<int16_t>((HIDInput[22]) | (HIDInput[23] << 8));
-		Acc.Y = static_cast<int16_t>((HIDInput[24]) | (HIDInput[25] << 8));
-		Acc.Z = static_cast<int16_t>((HIDInput[26]) | (HIDInput[27] << 8));
-
-		if (bIsCalibrating)
-		{
-			AccumulatedGyro.X += Gyro.X;
-			AccumulatedGyro.Y += Gyro.Y;
-			AccumulatedGyro.Z += Gyro.Z;
-
-			AccumulatedAccel.X += Acc.X;
-			AccumulatedAccel.Y += Acc.Y;
-			AccumulatedAccel.Z += Acc.Z;
-
-			Bounds.Gyro_X_Bounds.X = FMath::Min(Bounds.Gyro_X_Bounds.X, Gyro.X);
-			Bounds.Gyro_X_Bounds.Y = FMath::Max(Bounds.Gyro_X_Bounds.Y, Gyro.X);
-
-			Bounds.Gyro_Y_Bounds.X = FMath::Min(Bounds.Gyro_Y_Bounds.X, Gyro.Y);
-			Bounds.Gyro_Y_Bounds.Y = FMath::Max(Bounds.Gyro_Y_Bounds.Y, Gyro.Y);
-
-			Bounds.Gyro_Z_Bounds.X = FMath::Min(Bounds.Gyro_Z_Bounds.X, Gyro.Z);
-			Bounds.Gyro_Z_Bounds.Y = FMath::Max(Bounds.Gyro_Z_Bounds.Y, Gyro.Z);
-
-			Bounds.Accel_X_Bounds.X = FMath::Min(Bounds.Accel_X_Bounds.X, Acc.X);
-			Bounds.Accel_X_Bounds.Y = FMath::Max(Bounds.Accel_X_Bounds.Y, Acc.X);
-
-			Bounds.Accel_Y_Bounds.X = FMath::Min(Bounds.Accel_Y_Bounds.X, Acc.Y);
-			Bounds.Accel_Y_Bounds.Y = FMath::Max(Bounds.Accel_Y_Bounds.Y, Acc.Y);
-
-			Bounds.Accel_Z_Bounds.X = FMath::Min(Bounds.Accel_Z_Bounds.X, Acc.Z);
-			Bounds.Accel_Z_Bounds.Y = FMath::Max(Bounds.Accel_Z_Bounds.Y, Acc.Z);
-
-			CalibrationSampleCount++;
-		}
-
-		if (bHasMotionSensorBaseline)
-		{
-			Gyro.X -= GyroBaseline.X;
-			Gyro.Y -= GyroBaseline.Y;
-			Gyro.Z -= GyroBaseline.Z;
-
-			float FinalGyroValueX = 0.0f;
-			if (FMath::Abs(Gyro.X) > (Bounds.Gyro_X_Bounds.Y - Bounds.Gyro_X_Bounds.X) * SensorsDeadZone)
-			{
-				FinalGyroValueX = Gyro.X;
-			}
-
-			float FinalGyroValueY = 0.0f;
-			if (FMath::Abs(Gyro.Y) > (Bounds.Gyro_Y_Bounds.Y - Bounds.Gyro_Y_Bounds.X) * SensorsDeadZone)
-			{
-				FinalGyroValueY = Gyro.Y;
-			}
-
-			float FinalGyroValueZ = 0.0f;
-			if (FMath::Abs(Gyro.Z) > (Bounds.Gyro_Z_Bounds.Y - Bounds.Gyro_Z_Bounds.X) * SensorsDeadZone)
-			{
-				FinalGyroValueZ = Gyro.Z;
-			}
-
-			Acc.X -= AccelBaseline.X;
-			Acc.Y -= AccelBaseline.Y;
-			Acc.Z -= AccelBaseline.Z;
-
-			float FinalAccelValueX = 0.0f;
-			if (FMath::Abs(Acc.X) > (Bounds.Accel_X_Bounds.Y - Bounds.Accel_X_Bounds.X) * SensorsDeadZone)
-			{
-				FinalAccelValueX = Acc.X;
-			}
-
-			float FinalAccelValueY = 0.0f;
-			if (FMath::Abs(Acc.Y) > (Bounds.Accel_Y_Bounds.Y - Bounds.Accel_Y_Bounds.X) * SensorsDeadZone)
-			{
-				FinalAccelValueY = Acc.Y;
-			}
-
-			float FinalAccelValueZ = 0.0f;
-			if (FMath::Abs(Acc.Z) > (Bounds.Accel_Z_Bounds.Y - Bounds.Accel_Z_Bounds.X) *
-			                            SensorsDeadZone)
-			{
-				FinalAccelValueZ = Acc.Z;
-			}
-
-			Gyro.X = FinalGyroValueX;
-			Gyro.Y = FinalGyroValueY;
-			Gyro.Z = FinalGyroValueZ;
-
-			Acc.X = FinalAccelValueX;
-			Acc.Y = FinalAccelValueY;
-			Acc.Z = FinalAccelValueZ;
-		}
-
-		// ---------- REPLACED: Complementary Slerp fusion  ----------
-		// We now use the Madgwick AHRS (IMU-only) and feed it with values
-		// converted from raw counts to SI using the official DS constants.
-		// The Madgwick instance and initialization are static locals so that
-		// we don't need to change the class header right away.
-		static FMadgwickAhrs MadgwickFilter(200.0f, 0.08f);
-		static bool bMadgwickInitialized = false;
-
-		// Official PlayStation DualSense scaling constants (from kernel driver)
-		constexpr float DS_ACC_RES_PER_G = 8192.0f;      // counts per 1 g
-		constexpr float DS_GYRO_RES_PER_DEG_S = 1024.0f; // counts per 1 deg/s
-		constexpr float G_TO_MS2 = 9.80665f;
-		constexpr float DEG2RAD = 3.14159265358979323846f / 180.0f;
-
-		// Convert gyro raw (counts) -> deg/s -> rad/s
-		float gx_dps = static_cast<float>(Gyro.X) / DS_GYRO_RES_PER_DEG_S;
-		float gy_dps = static_cast<float>(Gyro.Y) / DS_GYRO_RES_PER_DEG_S;
-		float gz_dps = static_cast<float>(Gyro.Z) / DS_GYRO_RES_PER_DEG_S;
-
-		float gx = gx_dps * DEG2RAD;
-		float gy = gy_dps * DEG2RAD;
-		float gz = gz_dps * DEG2RAD;
-
-		float ax_g = static_cast<float>(Acc.X) / DS_ACC_RES_PER_G;
-		float ay_g = static_cast<float>(Acc.Y) / DS_ACC_RES_PER_G;
-		float az_g = static_cast<float>(Acc.Z) / DS_ACC_RES_PER_G;
-
-		float ax = ax_g * G_TO_MS2;
-		float ay = ay_g * G_TO_MS2;
-		float az = az_g * G_TO_MS2;
-
-		if (!bMadgwickInitialized)
-		{
-			const float safeDt = FMath::Max(Delta, 0.001f);
-			MadgwickFilter.SetSampleFreq(1.0f / safeDt);
-			MadgwickFilter.SetBeta(0.08f);
-			bMadgwickInitialized = true;
-		}
-
-		if (bIsResetGyroscope)
-		{
-			MadgwickFilter.Reset();
-			bIsResetGyroscope = false;
-		}
-
-		// Update Madgwick filter (IMU-only)
-		MadgwickFilter.UpdateImu(gx, gy, -gz, ax, ay, -az, Delta);
-
 		// Get quaternion directly to avoid Gimbal Lock
 		float qw, qx, qy, qz;
-		MadgwickFilter.GetQuaternion(qw, qx, qy, qz);
+		MotionFilter.GetQuaternion(qw, qx, qy, qz);
 
 		// Create Unreal quaternion and extract Euler angles
 		// Note: FQuat constructor is (X, Y, Z, W)
@@ -492,20 +419,16 @@ void UDualSenseLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageH
 		                             ControlRotation.Roll);
 
 		// Keep the same output vectors you already used elsewhere
-		const FVector Gyroscope = FVector(Gyro.X, Gyro.Z, Gyro.Y);
-		const FVector Accelerometer = FVector(Acc.X, Acc.Z, Acc.Y);
-
-		FVector Accel_MS2 = FVector(ax, az, ay);
-		const float GravityMagnitude = Accel_MS2.Size();
+		const float GravityMagnitude = MotionAccelMS2.Size();
 		FVector Gravity = (GravityMagnitude > KINDA_SMALL_NUMBER)
-		                      ? (Accel_MS2 / GravityMagnitude) * G_TO_MS2
+		                      ? (MotionAccelMS2 / GravityMagnitude) * G_TO_MS2
 		                      : FVector::ZeroVector;
 
-		InMessageHandler.Get().OnMotionDetected(Tilt, Gyroscope, Gravity, Accelerometer, UserId, InputDeviceId);
+		InMessageHandler.Get().OnMotionDetected(Tilt, MotionGyroscope, Gravity, MotionAccelerometer, UserId, InputDeviceId);
 	}
 
-	SetHasPhoneConnected(HIDInput[0x35] & 0x01);
-	SetLevelBattery(((HIDInput[0x34] & 0x0F) / 10.0) * 100, (HIDInput[0x35] & 0x00), (HIDInput[0x36] & 0x20));
+	SetHasPhoneConnected(InputState.PeripheralStatus & 0x01);
+	SetLevelBattery(((InputState.BatteryStatus & 0x0F) / 10.0) * 100, (InputState.PeripheralStatus & 0x00), (InputState.ChargingStatus & 0x20));
 }
 
 void UDualSenseLibrary::ResetGyroOrientation()
@@ -524,7 +447,7 @@ void UDualSenseLibrary::SetVibration(const FForceFeedbackValues& Vibration)
 	if (HidOutput->Rumbles.Left != OutputLeft || HidOutput->Rumbles.Right != OutputRight)
 	{
 		HidOutput->Rumbles = {OutputLeft, OutputRight};
-		SendOut();
+		MarkOutputDirty();
 	}
 }
 
@@ -541,7 +464,7 @@ void UDualSenseLibrary::SetHapticFeedback(int32 Hand, const FHapticFeedbackValue
 		HidOutput->RightTrigger.Frequency = FValidateHelpers::To255(Values->Frequency);
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetTriggerResistance(const FInputDeviceTriggerResistanceProperty& Resistance)
@@ -594,7 +517,7 @@ void UDualSenseLibrary::SetTriggerResistance(const FInputDeviceTriggerResistance
 		HidOutput->RightTrigger.Strengths.StrengthZones = StrengthZones;
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetAutomaticGun(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength,
@@ -626,7 +549,7 @@ void UDualSenseLibrary::SetAutomaticGun(int32 BeginStrength, int32 MiddleStrengt
 		HidOutput->RightTrigger.Strengths.Compose[9] = Frequency;
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetGameCube(const EControllerHand& Hand)
@@ -649,7 +572,7 @@ void UDualSenseLibrary::SetGameCube(const EControllerHand& Hand)
 		HidOutput->RightTrigger.Strengths.Compose[2] = 0xff;
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetContinuousResistance(int32 StartPosition, int32 Strength, const EControllerHand& Hand)
@@ -670,7 +593,7 @@ void UDualSenseLibrary::SetContinuousResistance(int32 StartPosition, int32 Stren
 		HidOutput->RightTrigger.Strengths.StrengthZones = FValidateHelpers::To255(Strength, 9);
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetResistance(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength,
@@ -696,7 +619,7 @@ void UDualSenseLibrary::SetResistance(int32 BeginStrength, int32 MiddleStrength,
 		HidOutput->RightTrigger.Strengths.Compose[3] = FValidateHelpers::To255(EndStrength, 7);
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetWeapon(int32 StartPosition, int32 EndPosition, int32 Strength,
@@ -718,7 +641,7 @@ void UDualSenseLibrary::SetWeapon(int32 StartPosition, int32 EndPosition, int32
 		HidOutput->RightTrigger.Strengths.StrengthZones = FValidateHelpers::To255(Strength);
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetGalloping(int32 StartPosition, int32 EndPosition, int32 FirstFoot, int32 SecondFoot,
@@ -750,7 +673,7 @@ void UDualSenseLibrary::SetGalloping(int32 StartPosition, int32 EndPosition, int
 		HidOutput->RightTrigger.Strengths.Compose[3] = static_cast<uint8>(Frequency);
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetMachine(int32 StartPosition, int32 EndPosition, int32 AmplitudeBegin,
@@ -789,7 +712,7 @@ void UDualSenseLibrary::SetMachine(int32 StartPosition, int32 EndPosition, int32
 		HidOutput->RightTrigger.Strengths.Compose[6] = static_cast<uint8>(Frequency);
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetMachine27(uint8 StartZone, uint8 BehaviorFlag, uint8 ForceAmplitude, uint8 Period,
@@ -819,7 +742,7 @@ void UDualSenseLibrary::SetMachine27(uint8 StartZone, uint8 BehaviorFlag, uint8
 		HidOutput->RightTrigger.Strengths.Compose[4] = Frequency;
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetBow(int32 StartPosition, int32 EndPosition, int32 BegingStrength, int32 EndStrength,
@@ -876,7 +799,7 @@ void UDualSenseLibrary::SetBow(int32 StartPosition, int32 EndPosition, int32 Beg
 		HidOutput->RightTrigger.Strengths.Compose[1] = EndPosition == 8 ? 0x01 : 0x00;
 		HidOutput->RightTrigger.Strengths.Compose[2] = (BegingStrength & 0x0F) << 4 | (EndStrength & 0x0F);
 	}
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::StopTrigger(const EControllerHand& Hand)
@@ -892,7 +815,7 @@ void UDualSenseLibrary::StopTrigger(const EControllerHand& Hand)
 		HidOutput->RightTrigger.Mode = 0x0;
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::StopAll()
@@ -907,7 +830,7 @@ void UDualSenseLibrary::StopAll()
 	}
 
 	HidOutput->PlayerLed.Led = static_cast<unsigned char>(ELedPlayerEnum::One);
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualSenseLibrary::SetLightbar(FColor Color, float BrithnessTime, float ToggleTime)
@@ -918,7 +841,7 @@ void UDualSenseLibrary::SetLightbar(FColor Color, float BrithnessTime, float Tog
 		HidOutput->Lightbar.R = Color.R;
 		HidOutput->Lightbar.G = Color.G;
 		HidOutput->Lightbar.B = Color.B;
-		SendOut();
+		MarkOutputDirty();
 	}
 }
 
@@ -930,7 +853,7 @@ void UDualSenseLibrary::SetPlayerLed(ELedPlayerEnum Led, ELedBrightnessEnum Brig
 	{
 		HidOutput->PlayerLed.Led = static_cast<unsigned char>(Led);
 		HidOutput->PlayerLed.Brightness = static_cast<unsigned char>(Brightness);
-		SendOut();
+		MarkOutputDirty();
 	}
 }
 
@@ -940,7 +863,7 @@ void UDualSenseLibrary::SetMicrophoneLed(ELedMicEnum Led)
 	if (HidOutput->MicLight.Mode != static_cast<unsigned char>(Led))
 	{
 		HidOutput->MicLight.Mode = static_cast<unsigned char>(Led);
-		SendOut();
+		MarkOutputDirty();
 	}
 }
 
@@ -949,9 +872,23 @@ void UDualSenseLibrary::EnableTouch(const bool bIsTouch)
 	bEnableTouch = bIsTouch;
 }
 
+void UDualSenseLibrary::EnableSubFrameInput(const bool bEnable)
+{
+	bEnableSubFrameInput = bEnable;
+	if (InputReader)
+	{
+		InputReader->SetQueueAllReports(bEnableSubFrameInput || bEnableAccelerometerAndGyroscope);
+	}
+}
+
 void UDualSenseLibrary::EnableMotionSensor(bool bIsMotionSensor)
 {
 	bEnableAccelerometerAndGyroscope = bIsMotionSensor;
+	bHasSensorTimestamp = false;
+	if (InputReader)
+	{
+		InputReader->SetQueueAllReports(bEnableSubFrameInput || bEnableAccelerometerAndGyroscope);
+	}
 }
 
 bool UDualSenseLibrary::GetMotionSensorCalibrationStatus(float& OutProgress)
@@ -967,25 +904,40 @@ bool UDualSenseLibrary::GetMotionSensorCalibrationStatus(float& OutProgress)
 
 	if (ElapsedTime >= CalibrationDuration)
 	{
-		if (CalibrationSampleCount > 0)
-		{
-			GyroBaseline.X = AccumulatedGyro.X / CalibrationSampleCount;
-			GyroBaseline.Y = AccumulatedGyro.Y / CalibrationSampleCount;
-			GyroBaseline.Z = AccumulatedGyro.Z / CalibrationSampleCount;
-
-			AccelBaseline.X = AccumulatedAccel.X / CalibrationSampleCount;
-			AccelBaseline.Y = AccumulatedAccel.Y / CalibrationSampleCount;
-			AccelBaseline.Z = AccumulatedAccel.Z / CalibrationSampleCount;
-		}
-		bIsCalibrating = false;
-		bHasMotionSensorBaseline = true;
+		FinishMotionSensorCalibration();
 		return false;
 	}
 
 	return true;
 }
 
-void UDualSenseLibrary::AudioHapticUpdate(TArray<int8> Data)
+void UDualSenseLibrary::FinishMotionSensorCalibration()
+{
+	if (CalibrationSampleCount > 0)
+	{
+		GyroBaseline.X = AccumulatedGyro.X / CalibrationSampleCount;
+		GyroBaseline.Y = AccumulatedGyro.Y / CalibrationSampleCount;
+		GyroBaseline.Z = AccumulatedGyro.Z / CalibrationSampleCount;
+
+		AccelBaseline.X = AccumulatedAccel.X / CalibrationSampleCount;
+		AccelBaseline.Y = AccumulatedAccel.Y / CalibrationSampleCount;
+		AccelBaseline.Z = AccumulatedAccel.Z / CalibrationSampleCount;
+
+		// An explicit calibration was held still on purpose; trust it fully and keep refining from there.
+		BiasEstimator.SetBias(GyroBaseline, 1.0f);
+	}
+	bIsCalibrating = false;
+	bHasMotionSensorBaseline = true;
+}
+
+bool UDualSenseLibrary::GetGyroBiasEstimate(FVector& OutBias, float& OutConfidence) const
+{
+	OutBias = BiasEstimator.GetBias() / DS_GYRO_RES_PER_DEG_S;
+	OutConfidence = BiasEstimator.GetConfidence();
+	return BiasEstimator.HasEstimate();
+}
+
+void UDualSenseLibrary::AudioHapticUpdate(const TConstArrayView<int8> Data)
 {
 	FDeviceContext* Context = &HIDDeviceContexts;
 	if (!Context || !Context->IsConnected)
@@ -997,7 +949,9 @@ void UDualSenseLibrary::AudioHapticUpdate(TArray<int8> Data)
 	AudioData[0] = (AudioVibrationSequence++) & 0xFF;
 	AudioData[1] = 0x92;
 	AudioData[2] = 0x40;
-	FMemory::Memcpy(&AudioData[3], Data.GetData(), 64);
+	const int32 Count = FMath::Min(Data.Num(), static_cast<int32>(FHapticFrame::Size));
+	FMemory::Memcpy(&AudioData[3], Data.GetData(), Count);
+	FMemory::Memzero(&AudioData[3 + Count], FHapticFrame::Size - Count);
 	FPlayStationOutputComposer::SendAudioHapticAdvanced(Context);
 }
 
@@ -1085,5 +1039,5 @@ void UDualSenseLibrary::CustomTrigger(const EControllerHand& Hand, const TArray<
 		FMemory::Memcpy(OutBuffer->RightTrigger.Strengths.Compose, Bytes, 10);
 	}
 
-	SendOut();
+	MarkOutputDirty();
 }
@@ -18,19 +18,44 @@ void UDualShockLibrary::Settings(const FDualShockFeatureReport& Settings)
 bool UDualShockLibrary::InitializeLibrary(const FDeviceContext& Context)
 {
 	HIDDeviceContexts = Context;
+	// Written synchronously, before the output writer is attached, so the controller shows it is connected
+	// as soon as the library is; later changes go through the writer and find this report already sent.
 	SetLightbar(FColor::Blue, 0.0f, 0.0f);
-	return true;
+	SendOut();
+
+	OutputWriter = MakeUnique<FOutputWriterThread>(&HIDDeviceContexts);
+	if (OutputWriter->Start())
+	{
+		HIDDeviceContexts.OutputWriter = OutputWriter.Get();
+		HIDDeviceContexts.HandledFailedWrites = 0;
+	}
+
+	ReportDecoder = FReportDecoders::Select(HIDDeviceContexts.DeviceType, HIDDeviceContexts.ConnectionType);
+	InputReader = MakeUnique<FInputReaderThread>(&HIDDeviceContexts);
+	return InputReader->Start();
 }
 
 void UDualShockLibrary::ShutdownLibrary()
 {
-	ButtonStates.Reset();
+	ButtonState.Reset();
+	InputState = FGamepadInputState();
+	if (InputReader)
+	{
+		InputReader->Shutdown();
+		InputReader.Reset();
+	}
+	if (OutputWriter)
+	{
+		HIDDeviceContexts.OutputWriter = nullptr;
+		OutputWriter->Shutdown();
+		OutputWriter.Reset();
+	}
 	IPlatformHardwareInfoInterface::Get().InvalidateHandle(&HIDDeviceContexts);
 }
 
 bool UDualShockLibrary::IsConnected()
 {
-	return HIDDeviceContexts.IsConnected;
+	return HIDDeviceContexts.IsConnected && !(InputReader && InputReader->IsDeviceLost());
 }
 
 void UDualShockLibrary::SendOut()
@@ -43,59 +68,59 @@ void UDualShockLibrary::SendOut()
 	FPlayStationOutputComposer::OutputDualShock(&HIDDeviceContexts);
 }
 
-void UDualShockLibrary::CheckButtonInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
-                                         const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
-                                         const FName ButtonName,
-                                         const bool IsButtonPressed)
+void UDualShockLibrary::FlushOutput()
 {
-	const bool PreviousState = ButtonStates.Contains(ButtonName) ? ButtonStates[ButtonName] : false;
-	if (IsButtonPressed && !PreviousState)
+	if (!bOutputDirty && !FPlayStationOutputComposer::IsResendDue(HIDDeviceContexts))
 	{
-		InMessageHandler.Get().OnControllerButtonPressed(ButtonName, UserId, InputDeviceId, false);
+		return;
 	}
 
-	if (!IsButtonPressed && PreviousState)
-	{
-		InMessageHandler.Get().OnControllerButtonReleased(ButtonName, UserId, InputDeviceId, false);
-	}
+	bOutputDirty = false;
+	SendOut();
+}
 
-	ButtonStates.Add(ButtonName, IsButtonPressed);
+void UDualShockLibrary::DispatchButtons(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+                                        const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+                                        const uint64 Buttons)
+{
+	ButtonState.Update(Buttons, EGamepadButton::DigitalBits, InMessageHandler, UserId, InputDeviceId,
+	                   bEnableSubFrameInput ? &SubFrameInputEvents : nullptr, CurrentReportTimestamp);
 }
 
 void UDualShockLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
                                     const FPlatformUserId UserId, const FInputDeviceId InputDeviceId, float Delta)
 {
-	FDeviceContext* Context = &HIDDeviceContexts;
-	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [NewContext = MoveTemp(Context)]() {
-		IPlatformHardwareInfoInterface::Get().Read(NewContext);
-	});
-
-	const unsigned char* HIDInput;
-	if (HIDDeviceContexts.ConnectionType == EDeviceConnection::Bluetooth)
-	{
-		HIDInput = &HIDDeviceContexts.BufferDS4[3];
-	}
-	else
+	SubFrameInputEvents.Reset();
+	if (InputReader && ReportDecoder)
 	{
-		HIDInput = &HIDDeviceContexts.Buffer[1];
-	}
+		if (bEnableSubFrameInput)
+		{
+			// Replay every report received since the last update so presses shorter than a frame are not lost.
+			FInputReport QueuedReport;
+			FGamepadInputState QueuedState;
+			while (InputReader->DequeueReport(QueuedReport))
+			{
+				CurrentReportTimestamp = QueuedReport.Timestamp;
+				ReportDecoder(QueuedReport.Data, QueuedState);
+				DispatchButtons(InMessageHandler, UserId, InputDeviceId, QueuedState.Buttons);
+			}
+		}
 
-	// Triggers
-	const bool bLeftTriggerThreshold = HIDInput[0x05] & BTN_LEFT_TRIGGER;
-	const bool bRightTriggerThreshold = HIDInput[0x05] & BTN_RIGHT_TRIGGER;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftTriggerThreshold,
-	                 bLeftTriggerThreshold);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightTriggerThreshold,
-	                 bRightTriggerThreshold);
+		if (InputReader->ConsumeLatest())
+		{
+			CurrentReportTimestamp = InputReader->GetLatest().Timestamp;
+			ReportDecoder(InputReader->GetLatest().Data, InputState);
+		}
+	}
 
 	// Triggers Analog 1D
-	const float TriggerL = HIDInput[0x07] / 256.0f;
-	const float TriggerR = HIDInput[0x08] / 256.0f;
+	const float TriggerL = InputState.LeftTrigger / 256.0f;
+	const float TriggerR = InputState.RightTrigger / 256.0f;
 	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::LeftTriggerAnalog, UserId, InputDeviceId, TriggerL);
 	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::RightTriggerAnalog, UserId, InputDeviceId, TriggerR);
 
 	// Analogs
-	const auto HandleAnalogInput = [&](const FName& AnalogKey, const FName& ButtonKeyPositive, const FName& ButtonKeyNegative, float NewAxisValue) {
+	const auto HandleAnalogInput = [&](const FName& AnalogKey, const EGamepadButton::Type ButtonPositive, const EGamepadButton::Type ButtonNegative, float NewAxisValue) {
 		if (FMath::Abs(NewAxisValue) < AnalogDeadZone)
 		{
 			NewAxisValue = 0;
@@ -111,89 +136,23 @@ void UDualShockLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageH
 		InMessageHandler->OnControllerAnalog(AnalogKey, UserId, InputDeviceId, NewAxisValue);
 		OldAxisValue = NewAxisValue;
 
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, ButtonKeyPositive, NewAxisValue > 0);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, ButtonKeyNegative, NewAxisValue < 0);
+		const uint64 AxisBits = EGamepadButton::Bit(ButtonPositive) | EGamepadButton::Bit(ButtonNegative);
+		const uint64 AxisButtons = NewAxisValue > 0 ? EGamepadButton::Bit(ButtonPositive) : NewAxisValue < 0 ? EGamepadButton::Bit(ButtonNegative) : 0;
+		ButtonState.Update(AxisButtons, AxisBits, InMessageHandler, UserId, InputDeviceId,
+		                   bEnableSubFrameInput ? &SubFrameInputEvents : nullptr, CurrentReportTimestamp);
 	};
 
-	const float LeftAnalogX = static_cast<float>(HIDInput[0x00] - 128) / 128;
-	const float LeftAnalogY = static_cast<float>(HIDInput[0x01] - 128) / -128;
-	const float RightAnalogX = static_cast<float>(HIDInput[0x02] - 128) / 128;
-	const float RightAnalogY = static_cast<float>(HIDInput[0x03] - 128) / -128;
-
-	HandleAnalogInput(FGamepadKeyNames::LeftAnalogX, FGamepadKeyNames::LeftStickRight, FGamepadKeyNames::LeftStickLeft, LeftAnalogX);
-	HandleAnalogInput(FGamepadKeyNames::LeftAnalogY, FGamepadKeyNames::LeftStickUp, FGamepadKeyNames::LeftStickDown, LeftAnalogY);
-	HandleAnalogInput(FGamepadKeyNames::RightAnalogX, FGamepadKeyNames::RightStickRight, FGamepadKeyNames::RightStickLeft, RightAnalogX);
-	HandleAnalogInput(FGamepadKeyNames::RightAnalogY, FGamepadKeyNames::RightStickUp, FGamepadKeyNames::RightStickDown, RightAnalogY);
+	const float LeftAnalogX = static_cast<float>(InputState.LeftStickX - 128) / 128;
+	const float LeftAnalogY = static_cast<float>(InputState.LeftStickY - 128) / -128;
+	const float RightAnalogX = static_cast<float>(InputState.RightStickX - 128) / 128;
+	const float RightAnalogY = static_cast<float>(InputState.RightStickY - 128) / -128;
 
-	uint8_t ButtonsMask = HIDInput[0x04] & 0xF0;
-	const bool bCross = ButtonsMask & BTN_CROSS;
-	const bool bSquare = ButtonsMask & BTN_SQUARE;
-	const bool bCircle = ButtonsMask & BTN_CIRCLE;
-	const bool bTriangle = ButtonsMask & BTN_TRIANGLE;
+	HandleAnalogInput(FGamepadKeyNames::LeftAnalogX, EGamepadButton::LeftStickRight, EGamepadButton::LeftStickLeft, LeftAnalogX);
+	HandleAnalogInput(FGamepadKeyNames::LeftAnalogY, EGamepadButton::LeftStickUp, EGamepadButton::LeftStickDown, LeftAnalogY);
+	HandleAnalogInput(FGamepadKeyNames::RightAnalogX, EGamepadButton::RightStickRight, EGamepadButton::RightStickLeft, RightAnalogX);
+	HandleAnalogInput(FGamepadKeyNames::RightAnalogY, EGamepadButton::RightStickUp, EGamepadButton::RightStickDown, RightAnalogY);
 
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonBottom, bCross);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonLeft, bSquare);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonRight, bCircle);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonTop, bTriangle);
-
-	switch (HIDInput[0x04] & 0x0F)
-	{
-		case 0x0:
-			ButtonsMask |= BTN_DPAD_UP;
-			break;
-		case 0x4:
-			ButtonsMask |= BTN_DPAD_DOWN;
-			break;
-		case 0x6:
-			ButtonsMask |= BTN_DPAD_LEFT;
-			break;
-		case 0x2:
-			ButtonsMask |= BTN_DPAD_RIGHT;
-			break;
-		case 0x5:
-			ButtonsMask |= BTN_DPAD_LEFT | BTN_DPAD_DOWN;
-			break;
-		case 0x7:
-			ButtonsMask |= BTN_DPAD_LEFT | BTN_DPAD_UP;
-			break;
-		case 0x1:
-			ButtonsMask |= BTN_DPAD_RIGHT | BTN_DPAD_UP;
-			break;
-		case 0x3:
-			ButtonsMask |= BTN_DPAD_RIGHT | BTN_DPAD_DOWN;
-			break;
-		default:;
-	}
-	const bool bDPadLeft = ButtonsMask & BTN_DPAD_LEFT;
-	const bool bDPadDown = ButtonsMask & BTN_DPAD_DOWN;
-	const bool bDPadRight = ButtonsMask & BTN_DPAD_RIGHT;
-	const bool bDPadUp = ButtonsMask & BTN_DPAD_UP;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadUp, bDPadUp);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadDown, bDPadDown);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadLeft, bDPadLeft);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadRight, bDPadRight);
-
-	// Shoulders
-	const bool bLeftShoulder = HIDInput[0x05] & BTN_LEFT_SHOLDER;
-	const bool bRightShoulder = HIDInput[0x05] & BTN_RIGHT_SHOLDER;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftShoulder, bLeftShoulder);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightShoulder, bRightShoulder);
-
-	// Push Stick
-	const bool PushLeftStick = HIDInput[0x05] & BTN_LEFT_STICK;
-	const bool PushRightStick = HIDInput[0x05] & BTN_RIGHT_STICK;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PushLeftStick"), PushLeftStick);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PushRightStick"), PushRightStick);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftThumb, PushLeftStick);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightThumb, PushRightStick);
-
-	const bool Start = HIDInput[0x05] & BTN_START;
-	const bool Select = HIDInput[0x05] & BTN_SELECT;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Menu"), Start);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Share"), Select);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::SpecialRight, Start);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::SpecialLeft, Select);
+	DispatchButtons(InMessageHandler, UserId, InputDeviceId, InputState.Buttons);
 }
 
 void UDualShockLibrary::SetVibration(const FForceFeedbackValues& Values)
@@ -207,7 +166,7 @@ void UDualShockLibrary::SetVibration(const FForceFeedbackValues& Values)
 	if (HidOutput->Rumbles.Left != OutputLeft || HidOutput->Rumbles.Right != OutputRight)
 	{
 		HidOutput->Rumbles = {OutputLeft, OutputRight};
-		SendOut();
+		MarkOutputDirty();
 	}
 }
 
@@ -220,7 +179,7 @@ void UDualShockLibrary::SetLightbar(FColor Color, float BrithnessTime, float Tog
 
 	HidOutput->FlashLigthbar.Bright_Time = static_cast<unsigned char>(FValidateHelpers::To255(BrithnessTime));
 	HidOutput->FlashLigthbar.Toggle_Time = static_cast<unsigned char>(FValidateHelpers::To255(ToggleTime));
-	SendOut();
+	MarkOutputDirty();
 }
 
 void UDualShockLibrary::SetPlayerLed(ELedPlayerEnum Led, ELedBrightnessEnum Brightness)
@@ -236,6 +195,15 @@ void UDualShockLibrary::EnableTouch(const bool bIsTouch)
 	bEnableTouch = bIsTouch;
 }
 
+void UDualShockLibrary::EnableSubFrameInput(const bool bEnable)
+{
+	bEnableSubFrameInput = bEnable;
+	if (InputReader)
+	{
+		InputReader->SetQueueAllReports(bEnable);
+	}
+}
+
 void UDualShockLibrary::EnableMotionSensor(bool bIsMotionSensor)
 {
 	EnableAccelerometerAndGyroscope = bIsMotionSensor;
@@ -243,5 +211,5 @@ void UDualShockLibrary::EnableMotionSensor(bool bIsMotionSensor)
 
 void UDualShockLibrary::StopAll()
 {
-	SendOut();
+	MarkOutputDirty();
 }
@@ -3,7 +3,6 @@
 // Planned Release Year: 2025
 
 #include "../../Public/Core/HapticsRegistry.h"
-#include "Async/Async.h"
 #include "AudioDevice.h"
 #include "Misc/App.h"
 #include "Runtime/Launch/Resources/Version.h"
@@ -13,15 +12,11 @@ TSharedPtr<FHapticsRegistry> FHapticsRegistry::Instance;
 FHapticsRegistry::~FHapticsRegistry()
 {
 	RemoveAllListeners();
-	if (Instance->GameThreadTickerHandle.IsValid())
-	{
-		FTSTicker::GetCoreTicker().RemoveTicker(Instance->GameThreadTickerHandle);
-	}
 }
 
 bool FHapticsRegistry::HasListenerForDevice(const FInputDeviceId& DeviceId) const
 {
-	return ControllerListeners.Contains(DeviceId);
+	return DeviceSubmixes.Contains(DeviceId);
 }
 
 TSharedPtr<FHapticsRegistry> FHapticsRegistry::Get()
@@ -30,84 +25,99 @@ TSharedPtr<FHapticsRegistry> FHapticsRegistry::Get()
 	{
 		check(IsInGameThread());
 		Instance = MakeShared<FHapticsRegistry>();
-
-		Instance->GameThreadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
-		    FTickerDelegate::CreateSP(Instance.Get(), &FHapticsRegistry::Tick));
 	}
 	return Instance;
 }
 
-void FHapticsRegistry::CreateListenerForDevice(const FInputDeviceId& DeviceId, USoundSubmix* Submix)
+void FHapticsRegistry::CreateListenerForDevice(const FInputDeviceId& DeviceId, USoundSubmix* Submix, const float Gain)
 {
 	if (!Submix)
 	{
 		return;
 	}
 
-	if (ControllerListeners.Contains(DeviceId))
+	if (DeviceSubmixes.Contains(DeviceId))
 	{
 		UE_LOG(LogTemp, Log, TEXT("Haptics listener already registered for device %d"), DeviceId.GetId());
 		RemoveListenerForDevice(DeviceId);
-	};
+	}
 
-	const TSharedPtr<FAudioHapticsListener> Listener = MakeShared<FAudioHapticsListener>(DeviceId, Submix);
-	if (FAudioDeviceHandle AudioDevice = GEngine->GetActiveAudioDevice())
+	TSharedPtr<FAudioHapticsListener> Listener = SubmixListeners.FindRef(Submix);
+	if (!Listener.IsValid())
 	{
+		FAudioDeviceHandle AudioDevice = GEngine->GetActiveAudioDevice();
+		if (!AudioDevice)
+		{
+			return;
+		}
+
+		Listener = MakeShared<FAudioHapticsListener>(Submix);
 #if ENGINE_MINOR_VERSION > 3 && ENGINE_MAJOR_VERSION == 5
 		AudioDevice->RegisterSubmixBufferListener(Listener.ToSharedRef(), *Submix);
 #else
 		AudioDevice->RegisterSubmixBufferListener(Listener.Get(), Submix);
 #endif
-		UE_LOG(LogTemp, Log, TEXT("Registering listener for device %d num %d"), DeviceId.GetId(), ControllerListeners.Num());
-
-		ControllerListeners.Add(DeviceId, Listener);
+		SubmixListeners.Add(Submix, Listener);
 	}
+
+	UE_LOG(LogTemp, Log, TEXT("Registering listener for device %d num %d"), DeviceId.GetId(), DeviceSubmixes.Num());
+	Listener->AddDevice(DeviceId, Gain);
+	DeviceSubmixes.Add(DeviceId, Submix);
 }
 
 void FHapticsRegistry::RemoveAllListeners()
 {
-	if (FAudioDeviceHandle AudioDevice = GEngine->GetActiveAudioDevice())
+	for (auto& Pair : SubmixListeners)
 	{
-		for (auto& Pair : ControllerListeners)
-		{
-#if ENGINE_MINOR_VERSION > 3 && ENGINE_MAJOR_VERSION == 5
-			AudioDevice->UnregisterSubmixBufferListener(Pair.Value.ToSharedRef(), *Pair.Value.ToSharedRef()->GetSubmix());
-#else
-			AudioDevice->UnregisterSubmixBufferListener(Pair.Value.Get());
-#endif
-		}
+		Pair.Value->RemoveAllDevices();
+		UnregisterListener(Pair.Value);
 	}
-	ControllerListeners.Empty();
+	SubmixListeners.Empty();
+	DeviceSubmixes.Empty();
 }
 
-bool FHapticsRegistry::Tick(float DeltaTime)
+TSharedPtr<FAudioHapticsListener> FHapticsRegistry::GetListenerForDevice(const FInputDeviceId& DeviceId) const
 {
-	for (auto& Pair : ControllerListeners)
+	USoundSubmix* const* Submix = DeviceSubmixes.Find(DeviceId);
+	return Submix ? SubmixListeners.FindRef(*Submix) : nullptr;
+}
+
+void FHapticsRegistry::SetDeviceGain(const FInputDeviceId& DeviceId, const float Gain)
+{
+	if (const TSharedPtr<FAudioHapticsListener> Listener = GetListenerForDevice(DeviceId))
 	{
-		if (Pair.Value.IsValid())
-		{
-			TSharedPtr<FAudioHapticsListener> Context = Pair.Value;
-			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [NewContext = MoveTemp(Context)]() {
-				NewContext->ConsumeHapticsQueue();
-			});
-		}
+		Listener->SetDeviceGain(DeviceId, Gain);
 	}
-	return true;
 }
 
 void FHapticsRegistry::RemoveListenerForDevice(const FInputDeviceId& DeviceId)
 {
-	if (const TSharedPtr<FAudioHapticsListener>* ExistingListener = ControllerListeners.Find(DeviceId))
+	USoundSubmix* Submix = nullptr;
+	if (!DeviceSubmixes.RemoveAndCopyValue(DeviceId, Submix))
+	{
+		return;
+	}
+
+	if (const TSharedPtr<FAudioHapticsListener>* ExistingListener = SubmixListeners.Find(Submix))
 	{
-		if (FAudioDeviceHandle AudioDevice = GEngine->GetActiveAudioDevice())
+		(*ExistingListener)->RemoveDevice(DeviceId);
+		if (!(*ExistingListener)->HasDevices())
 		{
+			UnregisterListener(*ExistingListener);
+			SubmixListeners.Remove(Submix);
+		}
+		UE_LOG(LogTemp, Log, TEXT("Unregistered haptics listener for device %d"), DeviceId.GetId());
+	}
+}
+
+void FHapticsRegistry::UnregisterListener(const TSharedPtr<FAudioHapticsListener>& Listener)
+{
+	if (FAudioDeviceHandle AudioDevice = GEngine->GetActiveAudioDevice())
+	{
 #if ENGINE_MINOR_VERSION > 3 && ENGINE_MAJOR_VERSION == 5
-			AudioDevice->UnregisterSubmixBufferListener(ExistingListener->ToSharedRef(), *ExistingListener->ToSharedRef()->GetSubmix());
+		AudioDevice->UnregisterSubmixBufferListener(Listener.ToSharedRef(), *Listener->GetSubmix());
 #else
-			AudioDevice->UnregisterSubmixBufferListener(ExistingListener->Get());
+		AudioDevice->UnregisterSubmixBufferListener(Listener.Get());
 #endif
-			UE_LOG(LogTemp, Log, TEXT("Unregistered haptics listener for device %d"), DeviceId.GetId());
-		}
-		ControllerListeners.Remove(DeviceId);
 	}
 }
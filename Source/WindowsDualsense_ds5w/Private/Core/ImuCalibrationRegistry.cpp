@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/ImuCalibrationRegistry.h"
+#include "Core/Interfaces/PlatformHardwareInfoInterface.h"
+#include "Misc/ScopeLock.h"
+
+FCriticalSection FImuCalibrationRegistry::Mutex;
+TMap<uint64, FImuCalibration> FImuCalibrationRegistry::Calibrations;
+
+FImuCalibration FImuCalibrationRegistry::Load(FDeviceContext* Context)
+{
+	if (!Context || (Context->DeviceType != EDeviceType::DualSense && Context->DeviceType != EDeviceType::DualSenseEdge))
+	{
+		return FImuCalibration();
+	}
+
+	unsigned char Pairing[DualSensePairingReportSize] = {};
+	Pairing[0] = DualSensePairingReportId;
+	uint64 Address = 0;
+	const bool bHasAddress = IPlatformHardwareInfoInterface::Get().GetFeatureReport(Context, Pairing, sizeof(Pairing)) &&
+	                         ParseDualSenseAddress(Pairing, sizeof(Pairing), Address);
+	if (bHasAddress)
+	{
+		FScopeLock Lock(&Mutex);
+		if (const FImuCalibration* Cached = Calibrations.Find(Address))
+		{
+			return *Cached;
+		}
+	}
+
+	unsigned char Report[FImuCalibration::DualSenseReportSize] = {};
+	Report[0] = FImuCalibration::DualSenseReportId;
+	if (!IPlatformHardwareInfoInterface::Get().GetFeatureReport(Context, Report, sizeof(Report)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DualSense: Failed to read the motion sensor calibration of %s."), *Context->Path);
+		return FImuCalibration();
+	}
+
+	FImuCalibration Calibration;
+	if (!FImuCalibration::ParseDualSense(Report, sizeof(Report), Calibration))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DualSense: Ignoring invalid motion sensor calibration of %s."), *Context->Path);
+		return FImuCalibration();
+	}
+
+	if (bHasAddress)
+	{
+		FScopeLock Lock(&Mutex);
+		Calibrations.Add(Address, Calibration);
+	}
+	return Calibration;
+}
+
+bool FImuCalibrationRegistry::ParseDualSenseAddress(const unsigned char* Report, const int32 Length, uint64& OutAddress)
+{
+	if (!Report || Length < 7 || Report[0] != DualSensePairingReportId)
+	{
+		return false;
+	}
+
+	// Six bytes after the report id, least significant first.
+	uint64 Address = 0;
+	for (int32 Byte = 0; Byte < 6; ++Byte)
+	{
+		Address |= static_cast<uint64>(Report[1 + Byte]) << (Byte * 8);
+	}
+	// Clones that do not implement the report answer with a blank address, which would make them all share one entry.
+	if (Address == 0 || Address == 0xFFFFFFFFFFFFull)
+	{
+		return false;
+	}
+
+	OutAddress = Address;
+	return true;
+}
+
+void FImuCalibrationRegistry::StoreDualSenseReport(const uint64 Address, const unsigned char* Report, const int32 Length)
+{
+	FImuCalibration Calibration;
+	if (!FImuCalibration::ParseDualSense(Report, Length, Calibration))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DualSense: Ignoring invalid motion sensor calibration of controller %012llX."), Address);
+		return;
+	}
+
+	FScopeLock Lock(&Mutex);
+	Calibrations.Add(Address, Calibration);
+}
@@ -3,6 +3,7 @@
 // Planned Release Year: 2025
 
 #include "../../../Public/Core/Interfaces/PlatformHardwareInfoInterface.h"
+#include "Core/Platforms/Virtual/VirtualDeviceInfo.h"
 
 #if PLATFORM_WINDOWS
 #include "Core/Platforms/Windows/WindowsDeviceInfo.h"
@@ -18,6 +19,8 @@ TUniquePtr<IPlatformHardwareInfoInterface> IPlatformHardwareInfoInterface::Platf
  * Retrieves a reference to the platform-specific hardware information interface instance.
  * If the instance does not already exist, it is initialized based on the current platform.
  *
+ * - If the virtual backend is requested (ds.Virtual.Enable or -DualSenseVirtual), it is used on
+ *   every platform in place of the hardware, e.g. for load tests on machines without controllers.
  * - For Windows, the instance is initialized using HID (Human Interface Device) for
  *   DualSense controller support.
  * - For other platforms, the interface is currently not supported and will return nullptr.
@@ -27,6 +30,11 @@ TUniquePtr<IPlatformHardwareInfoInterface> IPlatformHardwareInfoInterface::Platf
  */
 IPlatformHardwareInfoInterface& IPlatformHardwareInfoInterface::Get()
 {
+	if (!PlatformInfoInstance && FVirtualDeviceInfo::IsRequested())
+	{
+		PlatformInfoInstance = MakeUnique<FVirtualDeviceInfo>();
+	}
+
 	if (!PlatformInfoInstance)
 	{
 		// Platform-specific initialization of hardware info interface
@@ -8,46 +8,196 @@
 #else
 #include "SDL_hidapi.h"
 
+#if PLATFORM_LINUX
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include <atomic>
+#include <errno.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 static const uint16 SONY_VENDOR_ID = 0x054C;
 static const uint16 DUALSHOCK4_PID_V1 = 0x05C4;
 static const uint16 DUALSHOCK4_PID_V2 = 0x09CC;
 static const uint16 DUALSENSE_PID = 0x0CE6;
 static const uint16 DUALSENSE_EDGE_PID = 0x0DF2;
 
-void FCommonsDeviceInfo::Read(FDeviceContext* Context)
+#if PLATFORM_LINUX
+/**
+ * Thread reading kernel uevents from a NETLINK_KOBJECT_UEVENT socket and forwarding hidraw ones.
+ */
+class FCommonsDeviceInfo::FHotplugMonitor final : public FRunnable
 {
-	if (!Context || !Context->Handle)
+public:
+	FHotplugMonitor(const int InSocket, TFunction<void()> InOnDevicesChanged)
+	    : Socket(InSocket)
+	    , OnDevicesChanged(MoveTemp(InOnDevicesChanged))
 	{
-		return;
 	}
 
-	int BytesRead = 0;
-	if (Context->ConnectionType == EDeviceConnection::Bluetooth && Context->DeviceType == EDeviceType::DualShock4)
+	virtual ~FHotplugMonitor() override
+	{
+		Shutdown();
+	}
+
+	bool Start()
 	{
-		const size_t InputReportLength = 547;
-		BytesRead = SDL_hid_read(Context->Handle, Context->BufferDS4, InputReportLength);
-		if (BytesRead < 0)
+		Thread = FRunnableThread::Create(this, TEXT("DualSenseHotplugMonitor"), 0, TPri_BelowNormal);
+		return Thread != nullptr;
+	}
+
+	void Shutdown()
+	{
+		if (Thread)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("hid_api: Failed to read from device (likely disconnected)"));
-			InvalidateHandle(Context);
+			Stop();
+			Thread->WaitForCompletion();
+			delete Thread;
+			Thread = nullptr;
+		}
+		if (Socket >= 0)
+		{
+			close(Socket);
+			Socket = -1;
 		}
-		return;
 	}
 
-	const size_t InputReportLength = (Context->ConnectionType == EDeviceConnection::Bluetooth) ? 78 : 64;
-	if (sizeof(Context->Buffer) < InputReportLength)
+	virtual uint32 Run() override
 	{
-		UE_LOG(LogTemp, Warning, TEXT("hid_api: Main buffer is too small for report input."));
-		InvalidateHandle(Context);
-		return;
+		char Message[4096];
+		while (!bStopRequested.load(std::memory_order_relaxed))
+		{
+			pollfd PollFd = {Socket, POLLIN, 0};
+			if (poll(&PollFd, 1, PollTimeoutMs) <= 0)
+			{
+				continue;
+			}
+
+			sockaddr_nl Sender = {};
+			socklen_t SenderLength = sizeof(Sender);
+			const ssize_t Length = recvfrom(Socket, Message, sizeof(Message) - 1, MSG_DONTWAIT,
+			                                reinterpret_cast<sockaddr*>(&Sender), &SenderLength);
+			// Only the kernel, port 0, may announce devices; anything else on the socket is ignored.
+			if (Length <= 0 || Sender.nl_pid != 0)
+			{
+				continue;
+			}
+
+			Message[Length] = '\0';
+			if (IsHidrawChange(Message, Length))
+			{
+				OnDevicesChanged();
+			}
+		}
+		return 0;
 	}
 
-	BytesRead = SDL_hid_read(Context->Handle, Context->Buffer, InputReportLength);
+	virtual void Stop() override
+	{
+		bStopRequested.store(true, std::memory_order_relaxed);
+	}
+
+private:
+	/**
+	 * Upper bound for a single wait, so stop requests are honoured without a wake-up.
+	 */
+	static constexpr int PollTimeoutMs = 100;
+
+	/**
+	 * Checks whether a uevent, "ACTION@DEVPATH" followed by NUL-separated KEY=VALUE pairs, adds or removes a hidraw node.
+	 */
+	static bool IsHidrawChange(const char* Message, const ssize_t Length)
+	{
+		bool bHidraw = false;
+		bool bAddOrRemove = false;
+		for (const char* Field = Message; Field < Message + Length; Field += FCStringAnsi::Strlen(Field) + 1)
+		{
+			if (FCStringAnsi::Strcmp(Field, "SUBSYSTEM=hidraw") == 0)
+			{
+				bHidraw = true;
+			}
+			else if (FCStringAnsi::Strcmp(Field, "ACTION=add") == 0 || FCStringAnsi::Strcmp(Field, "ACTION=remove") == 0)
+			{
+				bAddOrRemove = true;
+			}
+		}
+		return bHidraw && bAddOrRemove;
+	}
+
+	int Socket;
+	TFunction<void()> OnDevicesChanged;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopRequested{false};
+};
+#endif
+
+FCommonsDeviceInfo::~FCommonsDeviceInfo()
+{
+#if PLATFORM_LINUX
+	StopHotplugNotifications();
+#endif
+}
+
+#if PLATFORM_LINUX
+bool FCommonsDeviceInfo::StartHotplugNotifications(TFunction<void()> OnDevicesChanged)
+{
+	if (HotplugMonitor)
+	{
+		return true;
+	}
+
+	const int Socket = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+	if (Socket < 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("hid_api: Failed to open the uevent socket (%d), polling for controllers instead"), errno);
+		return false;
+	}
+
+	// Multicast group 1 carries the kernel's own uevents, before udev processed them.
+	sockaddr_nl Address = {};
+	Address.nl_family = AF_NETLINK;
+	Address.nl_groups = 1;
+	if (bind(Socket, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) < 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("hid_api: Failed to bind the uevent socket (%d), polling for controllers instead"), errno);
+		close(Socket);
+		return false;
+	}
+
+	HotplugMonitor = MakeUnique<FHotplugMonitor>(Socket, MoveTemp(OnDevicesChanged));
+	if (!HotplugMonitor->Start())
+	{
+		HotplugMonitor.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FCommonsDeviceInfo::StopHotplugNotifications()
+{
+	// Joins the monitor thread, so the callback is not running anymore once this returns.
+	HotplugMonitor.Reset();
+}
+#endif
+
+int32 FCommonsDeviceInfo::Read(FDeviceContext* Context, unsigned char* Buffer, const int32 Length, const int32 TimeoutMs)
+{
+	if (!Context || !Context->Handle)
+	{
+		return -1;
+	}
+
+	// hidapi allows reads and writes on the same handle from different threads, so the
+	// reader thread shares Handle instead of opening a dedicated one.
+	const int BytesRead = SDL_hid_read_timeout(Context->Handle, Buffer, Length, TimeoutMs);
 	if (BytesRead < 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("hid_api: Failed to read from device (likely disconnected)"));
-		InvalidateHandle(Context);
 	}
+	return BytesRead;
 }
 
 void FCommonsDeviceInfo::ProcessAudioHapitc(FDeviceContext* Context)
@@ -83,6 +233,38 @@ void FCommonsDeviceInfo::Write(FDeviceContext* Context)
 	}
 }
 
+bool FCommonsDeviceInfo::GetFeatureReport(FDeviceContext* Context, unsigned char* Buffer, const int32 Length)
+{
+	if (!Context || !Context->Handle)
+	{
+		return false;
+	}
+
+	if (SDL_hid_get_feature_report(Context->Handle, Buffer, Length) < 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("hid_api: Failed to get feature report 0x%02X"), Buffer[0]);
+		return false;
+	}
+	return true;
+}
+
+bool FCommonsDeviceInfo::WriteReport(FDeviceContext* Context, const unsigned char* Buffer, const int32 Length)
+{
+	if (!Context || !Context->Handle)
+	{
+		return false;
+	}
+
+	// Unlike Write, the handle is left alone on failure: this runs on the output writer thread, and
+	// disconnections are detected by the input reader and the device registry.
+	if (SDL_hid_write(Context->Handle, Buffer, Length) < 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("hid_api: Failed to write to device"));
+		return false;
+	}
+	return true;
+}
+
 void FCommonsDeviceInfo::Detect(TArray<FDeviceContext>& Devices)
 {
 	Devices.Empty();
@@ -0,0 +1,725 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Platforms/Virtual/VirtualDeviceInfo.h"
+#include "Core/Decoders/ReportDecoders.h"
+#include "Core/ImuCalibrationRegistry.h"
+#include "Core/Structs/ImuCalibration.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarVirtualEnable(
+    TEXT("ds.Virtual.Enable"),
+    0,
+    TEXT("Replaces the platform HID backend with virtual controllers. Read once, when the backend is first created;\n")
+    TEXT("set it in the [ConsoleVariables] section of an ini file or pass -DualSenseVirtual on the command line."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVirtualCount(
+    TEXT("ds.Virtual.Count"),
+    1,
+    TEXT("Number of virtual controllers plugged when the virtual backend starts, up to 16.\n")
+    TEXT("-DualSenseVirtual=<Count> on the command line overrides it."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVirtualDeviceType(
+    TEXT("ds.Virtual.DeviceType"),
+    0,
+    TEXT("Type of the virtual controllers plugged at startup: 0 = DualSense, 1 = DualSense Edge, 2 = DualShock 4."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVirtualConnection(
+    TEXT("ds.Virtual.Connection"),
+    0,
+    TEXT("Connection of the virtual controllers plugged at startup: 0 = USB, 1 = Bluetooth."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVirtualReportRate(
+    TEXT("ds.Virtual.ReportRate"),
+    250.0f,
+    TEXT("Input reports per second sent by each virtual controller. 0 sends them as fast as they are read."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVirtualRandomInput(
+    TEXT("ds.Virtual.RandomInput"),
+    1,
+    TEXT("When a virtual controller has no script: 1 = seeded random walk of sticks, triggers and buttons, 0 = resting controller."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVirtualSeed(
+    TEXT("ds.Virtual.Seed"),
+    1,
+    TEXT("Seed of the random input; controller N uses Seed + N, so every run sends the same reports."),
+    ECVF_Default);
+
+FVirtualDeviceInfo* FVirtualDeviceInfo::Active = nullptr;
+
+namespace
+{
+	/**
+	 * Sensor timestamp ticks per second, a 3 MHz clock like the controller's.
+	 */
+	constexpr double SensorTicksPerSecond = 3000000.0;
+	/**
+	 * Report period assumed for the sensor timestamp when reports are not paced.
+	 */
+	constexpr double UnpacedReportPeriod = 1.0 / 250.0;
+	/**
+	 * Lateness, in periods, after which the report schedule restarts from now instead of catching up.
+	 */
+	constexpr int32 MaxLatePeriods = 4;
+	/**
+	 * Bits of a handle holding the slot index plus one; the plug generation sits above them.
+	 */
+	constexpr int32 HandleIndexBits = 5;
+	static_assert(FVirtualDeviceInfo::MaxDevices < (1 << HandleIndexBits), "Slot indices must fit the handle.");
+
+	FPlatformDeviceHandle MakeHandle(const int32 Index, const uint32 Generation)
+	{
+		const UPTRINT Value = (static_cast<UPTRINT>(Generation) << HandleIndexBits) | static_cast<UPTRINT>(Index + 1);
+		return reinterpret_cast<FPlatformDeviceHandle>(Value);
+	}
+
+	int32 GetHandleIndex(const FPlatformDeviceHandle Handle)
+	{
+		const UPTRINT Value = reinterpret_cast<UPTRINT>(Handle);
+		const int32 Index = static_cast<int32>(Value & ((1 << HandleIndexBits) - 1)) - 1;
+		return Index >= 0 && Index < FVirtualDeviceInfo::MaxDevices ? Index : INDEX_NONE;
+	}
+
+	void WriteInt16(unsigned char* Report, const int32 Offset, const int16 Value)
+	{
+		Report[Offset] = static_cast<unsigned char>(Value & 0xFF);
+		Report[Offset + 1] = static_cast<unsigned char>((Value >> 8) & 0xFF);
+	}
+
+	/**
+	 * Inverse of DecodeInputReport: writes a frame at the offsets of Layout. The report must be zeroed.
+	 */
+	template<typename Layout>
+	void EncodeInputReport(const FVirtualInputFrame& Frame, const uint32 SensorTimestamp, unsigned char* Report)
+	{
+		Report[Layout::LeftStickX] = Frame.LeftStickX;
+		Report[Layout::LeftStickY] = Frame.LeftStickY;
+		Report[Layout::RightStickX] = Frame.RightStickX;
+		Report[Layout::RightStickY] = Frame.RightStickY;
+		Report[Layout::LeftTrigger] = Frame.LeftTrigger;
+		Report[Layout::RightTrigger] = Frame.RightTrigger;
+		Report[Layout::FaceAndHat] = Frame.FaceAndHat;
+		Report[Layout::Misc] = Frame.Misc;
+
+		if constexpr (Layout::bHasSpecialButtons)
+		{
+			Report[Layout::Special] = Frame.Special & Layout::SpecialButtonsMask;
+		}
+
+		if constexpr (Layout::bHasMotion)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				WriteInt16(Report, Layout::Gyro + Axis * 2, Frame.Gyro[Axis]);
+				WriteInt16(Report, Layout::Accel + Axis * 2, Frame.Accel[Axis]);
+			}
+			for (int32 Byte = 0; Byte < 4; ++Byte)
+			{
+				Report[Layout::SensorTimestamp + Byte] = static_cast<unsigned char>((SensorTimestamp >> (Byte * 8)) & 0xFF);
+			}
+		}
+
+		if constexpr (Layout::bHasTouch)
+		{
+			// Bit 7 of the contact byte set means the finger is not touching.
+			Report[Layout::Touch] = 0x80;
+			Report[Layout::Touch + 4] = 0x80;
+		}
+
+		if constexpr (Layout::bHasStatus)
+		{
+			// 80% battery, discharging.
+			Report[Layout::Status] = 0x08;
+		}
+	}
+
+	using FReportEncodeFunction = void (*)(const FVirtualInputFrame& Frame, uint32 SensorTimestamp, unsigned char* Report);
+
+	FReportEncodeFunction SelectEncoder(const EDeviceType DeviceType, const EDeviceConnection ConnectionType)
+	{
+		const bool bIsBluetooth = ConnectionType == EDeviceConnection::Bluetooth;
+		switch (DeviceType)
+		{
+			case EDeviceType::DualSense:
+				return bIsBluetooth ? &EncodeInputReport<FDualSenseBluetoothLayout> : &EncodeInputReport<FDualSenseUsbLayout>;
+			case EDeviceType::DualSenseEdge:
+				return bIsBluetooth ? &EncodeInputReport<FDualSenseEdgeBluetoothLayout> : &EncodeInputReport<FDualSenseEdgeUsbLayout>;
+			case EDeviceType::DualShock4:
+				return bIsBluetooth ? &EncodeInputReport<FDualShockBluetoothLayout> : &EncodeInputReport<FDualShockUsbLayout>;
+			default:
+				return nullptr;
+		}
+	}
+
+	/**
+	 * Writes the report id and, over Bluetooth, the header bytes that precede the layout offsets.
+	 */
+	void WriteReportHeader(const EDeviceType DeviceType, const EDeviceConnection ConnectionType, const uint8 Sequence, unsigned char* Report)
+	{
+		if (ConnectionType != EDeviceConnection::Bluetooth)
+		{
+			Report[0] = 0x01;
+			return;
+		}
+
+		if (DeviceType == EDeviceType::DualShock4)
+		{
+			Report[0] = 0x11;
+			Report[1] = 0xC0;
+			return;
+		}
+
+		Report[0] = 0x31;
+		Report[1] = static_cast<unsigned char>(Sequence << 4);
+	}
+
+	const TCHAR* GetDeviceTypeName(const EDeviceType DeviceType)
+	{
+		switch (DeviceType)
+		{
+			case EDeviceType::DualSenseEdge:
+				return TEXT("dualsense-edge");
+			case EDeviceType::DualShock4:
+				return TEXT("dualshock4");
+			default:
+				return TEXT("dualsense");
+		}
+	}
+} // namespace
+
+void FVirtualDeviceInfo::FCaptureRing::Add(const unsigned char* Buffer, const int32 Length)
+{
+	if (Reports.Num() == 0)
+	{
+		return;
+	}
+
+	FVirtualCapturedReport& Report = Reports[Written % CaptureCapacity];
+	Report.Timestamp = FPlatformTime::Seconds();
+	Report.Length = Length;
+	FMemory::Memcpy(Report.Data, Buffer, FMath::Clamp(Length, 0, FVirtualCapturedReport::MaxLength));
+	++Written;
+}
+
+void FVirtualDeviceInfo::FCaptureRing::Reset()
+{
+	// Allocated up front, so recording a report never allocates on the writer threads.
+	if (Reports.Num() == 0)
+	{
+		Reports.SetNum(CaptureCapacity);
+	}
+	Written = 0;
+}
+
+FVirtualDeviceInfo::FVirtualDeviceInfo()
+{
+	Active = this;
+
+	int32 Count = CVarVirtualCount.GetValueOnAnyThread();
+	FParse::Value(FCommandLine::Get(), TEXT("DualSenseVirtual="), Count);
+	Count = FMath::Clamp(Count, 0, MaxDevices);
+
+	const int32 TypeIndex = FMath::Clamp(CVarVirtualDeviceType.GetValueOnAnyThread(), 0, 2);
+	const EDeviceType DeviceType = static_cast<EDeviceType>(TypeIndex);
+	const EDeviceConnection ConnectionType = CVarVirtualConnection.GetValueOnAnyThread() != 0 ? EDeviceConnection::Bluetooth : EDeviceConnection::Usb;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Plug(DeviceType, ConnectionType);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("DualSense: Using the virtual controller backend with %d device(s)."), Count);
+}
+
+FVirtualDeviceInfo::~FVirtualDeviceInfo()
+{
+	StopHotplugNotifications();
+	if (Active == this)
+	{
+		Active = nullptr;
+	}
+}
+
+bool FVirtualDeviceInfo::IsRequested()
+{
+	int32 Count = 0;
+	return CVarVirtualEnable.GetValueOnAnyThread() != 0 ||
+	       FParse::Param(FCommandLine::Get(), TEXT("DualSenseVirtual")) ||
+	       FParse::Value(FCommandLine::Get(), TEXT("DualSenseVirtual="), Count);
+}
+
+FVirtualDeviceInfo* FVirtualDeviceInfo::GetActive()
+{
+	return Active;
+}
+
+int32 FVirtualDeviceInfo::Plug(const EDeviceType DeviceType, const EDeviceConnection ConnectionType)
+{
+	for (int32 Index = 0; Index < MaxDevices; ++Index)
+	{
+		FVirtualDevice& Device = Devices[Index];
+		if (Device.bPlugged.load(std::memory_order_acquire))
+		{
+			continue;
+		}
+
+		{
+			FScopeLock Lock(&Device.Lock);
+			Device.DeviceType = DeviceType;
+			Device.ConnectionType = ConnectionType;
+			// Stable per slot and kind, so replugging the same controller looks like a reconnect to the registry.
+			Device.Path = FString::Printf(TEXT("virtual://%s/%s/%d"), GetDeviceTypeName(DeviceType),
+			                              ConnectionType == EDeviceConnection::Bluetooth ? TEXT("bt") : TEXT("usb"), Index);
+			Device.Script.Reset();
+			Device.bLoopScript = true;
+			Device.Captures[static_cast<int32>(EVirtualCapture::Output)].Reset();
+			Device.Captures[static_cast<int32>(EVirtualCapture::AudioHaptic)].Reset();
+			ResetInput(Index);
+			Device.Generation.fetch_add(1, std::memory_order_relaxed);
+			Device.bPlugged.store(true, std::memory_order_release);
+		}
+
+		NotifyDevicesChanged();
+		return Index;
+	}
+	return INDEX_NONE;
+}
+
+bool FVirtualDeviceInfo::Unplug(const int32 Index)
+{
+	if (Index < 0 || Index >= MaxDevices)
+	{
+		return false;
+	}
+
+	FVirtualDevice& Device = Devices[Index];
+	{
+		FScopeLock Lock(&Device.Lock);
+		if (!Device.bPlugged.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+		Device.bPlugged.store(false, std::memory_order_release);
+		Device.Generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	NotifyDevicesChanged();
+	return true;
+}
+
+int32 FVirtualDeviceInfo::Num() const
+{
+	int32 Count = 0;
+	for (const FVirtualDevice& Device : Devices)
+	{
+		Count += Device.bPlugged.load(std::memory_order_relaxed) ? 1 : 0;
+	}
+	return Count;
+}
+
+FString FVirtualDeviceInfo::GetPath(const int32 Index) const
+{
+	if (Index < 0 || Index >= MaxDevices || !Devices[Index].bPlugged.load(std::memory_order_acquire))
+	{
+		return FString();
+	}
+
+	const FVirtualDevice& Device = Devices[Index];
+	FScopeLock Lock(&Device.Lock);
+	return Device.Path;
+}
+
+void FVirtualDeviceInfo::SetScript(const int32 Index, TArray<FVirtualInputFrame> Frames, const bool bLoop)
+{
+	if (Index < 0 || Index >= MaxDevices)
+	{
+		return;
+	}
+
+	FVirtualDevice& Device = Devices[Index];
+	FScopeLock Lock(&Device.Lock);
+	Device.Script = MoveTemp(Frames);
+	Device.ScriptPosition = 0;
+	Device.bLoopScript = bLoop;
+}
+
+bool FVirtualDeviceInfo::GetCapturedReports(const int32 Index, const EVirtualCapture Kind, TArray<FVirtualCapturedReport>& OutReports) const
+{
+	OutReports.Reset();
+	if (Index < 0 || Index >= MaxDevices || !Devices[Index].bPlugged.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	const FVirtualDevice& Device = Devices[Index];
+	FScopeLock Lock(&Device.Lock);
+	const FCaptureRing& Ring = Device.Captures[static_cast<int32>(Kind)];
+	const uint64 Count = FMath::Min<uint64>(Ring.Written, CaptureCapacity);
+	OutReports.Reserve(static_cast<int32>(Count));
+	for (uint64 Position = Ring.Written - Count; Position < Ring.Written; ++Position)
+	{
+		OutReports.Add(Ring.Reports[Position % CaptureCapacity]);
+	}
+	return true;
+}
+
+bool FVirtualDeviceInfo::GetCaptureStats(const int32 Index, const EVirtualCapture Kind, FVirtualCaptureStats& OutStats) const
+{
+	if (Index < 0 || Index >= MaxDevices || !Devices[Index].bPlugged.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	const FVirtualDevice& Device = Devices[Index];
+	FScopeLock Lock(&Device.Lock);
+	const FCaptureRing& Ring = Device.Captures[static_cast<int32>(Kind)];
+	OutStats.TotalReports = Ring.Written;
+	OutStats.OverwrittenReports = Ring.Written > static_cast<uint64>(CaptureCapacity) ? Ring.Written - CaptureCapacity : 0;
+	OutStats.InputReports = Device.InputReports;
+	OutStats.CalibrationRequests = Device.CalibrationRequests;
+	return true;
+}
+
+void FVirtualDeviceInfo::ClearCaptures(const int32 Index)
+{
+	if (Index < 0 || Index >= MaxDevices)
+	{
+		return;
+	}
+
+	FVirtualDevice& Device = Devices[Index];
+	FScopeLock Lock(&Device.Lock);
+	for (FCaptureRing& Ring : Device.Captures)
+	{
+		Ring.Reset();
+	}
+}
+
+int32 FVirtualDeviceInfo::Read(FDeviceContext* Context, unsigned char* Buffer, const int32 Length, const int32 TimeoutMs)
+{
+	if (!Context)
+	{
+		return -1;
+	}
+
+	const FReportEncodeFunction Encode = SelectEncoder(Context->DeviceType, Context->ConnectionType);
+	int32 Index = FindDevice(Context->Handle);
+	if (Index == INDEX_NONE || !Encode || Length < 64)
+	{
+		return -1;
+	}
+
+	FVirtualDevice& Device = Devices[Index];
+	const float ReportRate = CVarVirtualReportRate.GetValueOnAnyThread();
+	const double Period = ReportRate > 0.0f ? 1.0 / ReportRate : 0.0;
+
+	double Wait;
+	{
+		FScopeLock Lock(&Device.Lock);
+		Wait = Device.NextReportTime - FPlatformTime::Seconds();
+	}
+	if (Wait > 0.0)
+	{
+		const double MaxWait = TimeoutMs / 1000.0;
+		FPlatformProcess::SleepNoStats(static_cast<float>(FMath::Min(Wait, MaxWait)));
+		if (Wait > MaxWait)
+		{
+			return 0;
+		}
+	}
+
+	// The device may have been unplugged while this thread slept.
+	Index = FindDevice(Context->Handle);
+	if (Index == INDEX_NONE)
+	{
+		return -1;
+	}
+
+	FScopeLock Lock(&Device.Lock);
+	const double Now = FPlatformTime::Seconds();
+	if (Now - Device.NextReportTime > Period * MaxLatePeriods)
+	{
+		Device.NextReportTime = Now;
+	}
+	Device.NextReportTime += Period;
+
+	AdvanceFrame(Device);
+	const double TimestampPeriod = Period > 0.0 ? Period : UnpacedReportPeriod;
+	Device.SensorTimestamp += static_cast<uint32>(TimestampPeriod * SensorTicksPerSecond);
+	++Device.Sequence;
+	++Device.InputReports;
+
+	FMemory::Memzero(Buffer, Length);
+	WriteReportHeader(Context->DeviceType, Context->ConnectionType, Device.Sequence, Buffer);
+	Encode(Device.Frame, Device.SensorTimestamp, Buffer);
+	return Length;
+}
+
+void FVirtualDeviceInfo::Write(FDeviceContext* Context)
+{
+	if (!Context)
+	{
+		return;
+	}
+
+	const int32 InReportLength = (Context->DeviceType == EDeviceType::DualShock4) ? 32 : 74;
+	const int32 OutputReportLength = (Context->ConnectionType == EDeviceConnection::Bluetooth) ? 78 : InReportLength;
+	if (FindDevice(Context->Handle) == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DualSense: Failed to write to virtual device %s (unplugged)"), *Context->Path);
+		InvalidateHandle(Context);
+		return;
+	}
+	Capture(Context->Handle, EVirtualCapture::Output, Context->BufferOutput, OutputReportLength);
+}
+
+bool FVirtualDeviceInfo::WriteReport(FDeviceContext* Context, const unsigned char* Buffer, const int32 Length)
+{
+	if (!Context || FindDevice(Context->Handle) == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Capture(Context->Handle, EVirtualCapture::Output, Buffer, Length);
+	return true;
+}
+
+bool FVirtualDeviceInfo::GetFeatureReport(FDeviceContext* Context, unsigned char* Buffer, const int32 Length)
+{
+	const int32 Index = Context ? FindDevice(Context->Handle) : INDEX_NONE;
+	if (Index == INDEX_NONE || !Buffer || Context->DeviceType == EDeviceType::DualShock4)
+	{
+		return false;
+	}
+
+	if (Buffer[0] == FImuCalibrationRegistry::DualSensePairingReportId && Length >= FImuCalibrationRegistry::DualSensePairingReportSize)
+	{
+		// Replugging a slot with the same model looks like the same controller, whatever the connection.
+		FMemory::Memzero(Buffer + 1, Length - 1);
+		Buffer[1] = static_cast<unsigned char>(Index + 1);
+		Buffer[2] = static_cast<unsigned char>(Context->DeviceType);
+		Buffer[6] = 0xAC;
+		return true;
+	}
+
+	if (Buffer[0] != FImuCalibration::DualSenseReportId || Length < FImuCalibration::DualSenseReportSize)
+	{
+		return false;
+	}
+
+	{
+		FVirtualDevice& Device = Devices[Index];
+		FScopeLock Lock(&Device.Lock);
+		++Device.CalibrationRequests;
+	}
+
+	// Zero gyro bias, +-8704 counts at +-540 deg/s on every axis, and +-8192 counts at +-1 g.
+	FMemory::Memzero(Buffer + 1, Length - 1);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		WriteInt16(Buffer, 7 + Axis * 4, 8704);
+		WriteInt16(Buffer, 9 + Axis * 4, -8704);
+		WriteInt16(Buffer, 23 + Axis * 4, 8192);
+		WriteInt16(Buffer, 25 + Axis * 4, -8192);
+	}
+	WriteInt16(Buffer, 19, 540);
+	WriteInt16(Buffer, 21, 540);
+	return true;
+}
+
+void FVirtualDeviceInfo::Detect(TArray<FDeviceContext>& DetectedDevices)
+{
+	DetectedDevices.Reset();
+	for (const FVirtualDevice& Device : Devices)
+	{
+		if (!Device.bPlugged.load(std::memory_order_acquire))
+		{
+			continue;
+		}
+
+		FScopeLock Lock(&Device.Lock);
+		FDeviceContext& NewDeviceContext = DetectedDevices.AddDefaulted_GetRef();
+		NewDeviceContext.Path = Device.Path;
+		NewDeviceContext.DeviceType = Device.DeviceType;
+		NewDeviceContext.ConnectionType = Device.ConnectionType;
+		NewDeviceContext.IsConnected = true;
+	}
+}
+
+bool FVirtualDeviceInfo::CreateHandle(FDeviceContext* Context)
+{
+	if (!Context || Context->Path.IsEmpty())
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < MaxDevices; ++Index)
+	{
+		FVirtualDevice& Device = Devices[Index];
+		FScopeLock Lock(&Device.Lock);
+		if (Device.bPlugged.load(std::memory_order_relaxed) && Device.Path == Context->Path)
+		{
+			// Every connection starts from the same input, so repeated runs see identical reports.
+			ResetInput(Index);
+			Context->Handle = MakeHandle(Index, Device.Generation.load(std::memory_order_relaxed));
+			return true;
+		}
+	}
+	return false;
+}
+
+void FVirtualDeviceInfo::InvalidateHandle(FDeviceContext* Context)
+{
+	if (Context && Context->Handle != INVALID_PLATFORM_HANDLE)
+	{
+		Context->Handle = INVALID_PLATFORM_HANDLE;
+		Context->IsConnected = false;
+
+		Context->Path = nullptr;
+		memset(Context->Buffer, 0, sizeof(Context->Buffer));
+		memset(Context->BufferDS4, 0, sizeof(Context->BufferDS4));
+		memset(Context->BufferOutput, 0, sizeof(Context->BufferOutput));
+		memset(Context->BufferAudio, 0, sizeof(Context->BufferAudio));
+	}
+}
+
+void FVirtualDeviceInfo::ProcessAudioHapitc(FDeviceContext* Context)
+{
+	if (!Context || FindDevice(Context->Handle) == INDEX_NONE)
+	{
+		return;
+	}
+
+	Capture(Context->Handle, EVirtualCapture::AudioHaptic, Context->BufferAudio, sizeof(Context->BufferAudio));
+}
+
+bool FVirtualDeviceInfo::StartHotplugNotifications(TFunction<void()> OnDevicesChanged)
+{
+	FScopeLock Lock(&HotplugLock);
+	OnHotplug = MoveTemp(OnDevicesChanged);
+	return true;
+}
+
+void FVirtualDeviceInfo::StopHotplugNotifications()
+{
+	FScopeLock Lock(&HotplugLock);
+	OnHotplug.Reset();
+}
+
+int32 FVirtualDeviceInfo::FindDevice(const FPlatformDeviceHandle Handle) const
+{
+	const int32 Index = GetHandleIndex(Handle);
+	if (Index == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const FVirtualDevice& Device = Devices[Index];
+	if (!Device.bPlugged.load(std::memory_order_acquire) ||
+	    MakeHandle(Index, Device.Generation.load(std::memory_order_acquire)) != Handle)
+	{
+		return INDEX_NONE;
+	}
+	return Index;
+}
+
+void FVirtualDeviceInfo::ResetInput(const int32 Index)
+{
+	FVirtualDevice& Device = Devices[Index];
+	Device.Frame = FVirtualInputFrame();
+	Device.Random.Initialize(CVarVirtualSeed.GetValueOnAnyThread() + Index);
+	Device.ScriptPosition = 0;
+	Device.NextReportTime = 0.0;
+	Device.SensorTimestamp = 0;
+	Device.Sequence = 0;
+	Device.InputReports = 0;
+	Device.CalibrationRequests = 0;
+}
+
+void FVirtualDeviceInfo::AdvanceFrame(FVirtualDevice& Device)
+{
+	if (Device.Script.Num() > 0)
+	{
+		Device.Frame = Device.Script[Device.ScriptPosition];
+		if (++Device.ScriptPosition >= Device.Script.Num())
+		{
+			Device.ScriptPosition = Device.bLoopScript ? 0 : Device.Script.Num() - 1;
+		}
+		return;
+	}
+
+	if (CVarVirtualRandomInput.GetValueOnAnyThread() == 0)
+	{
+		return;
+	}
+
+	// A bounded random walk, so the analog values move like a hand would move them rather than jumping.
+	FRandomStream& Random = Device.Random;
+	FVirtualInputFrame& Frame = Device.Frame;
+	const auto Walk = [&Random](uint8& Value, const int32 Step) {
+		Value = static_cast<uint8>(FMath::Clamp(Value + Random.RandRange(-Step, Step), 0, 255));
+	};
+	Walk(Frame.LeftStickX, 6);
+	Walk(Frame.LeftStickY, 6);
+	Walk(Frame.RightStickX, 6);
+	Walk(Frame.RightStickY, 6);
+	Walk(Frame.LeftTrigger, 10);
+	Walk(Frame.RightTrigger, 10);
+
+	if (Random.RandHelper(32) == 0)
+	{
+		Frame.FaceAndHat ^= static_cast<uint8>(0x10 << Random.RandHelper(4));
+	}
+	if (Random.RandHelper(64) == 0)
+	{
+		Frame.FaceAndHat = static_cast<uint8>((Frame.FaceAndHat & 0xF0) | Random.RandHelper(9));
+	}
+	if (Random.RandHelper(64) == 0)
+	{
+		Frame.Misc ^= static_cast<uint8>(1 << Random.RandHelper(8));
+	}
+	if (Random.RandHelper(256) == 0)
+	{
+		Frame.Special ^= static_cast<uint8>(1 << Random.RandHelper(8));
+	}
+
+	const FVirtualInputFrame Resting;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		Frame.Gyro[Axis] = static_cast<int16>(Random.RandRange(-16, 16));
+		Frame.Accel[Axis] = static_cast<int16>(Resting.Accel[Axis] + Random.RandRange(-32, 32));
+	}
+}
+
+void FVirtualDeviceInfo::Capture(const FPlatformDeviceHandle Handle, const EVirtualCapture Kind, const unsigned char* Buffer, const int32 Length)
+{
+	const int32 Index = GetHandleIndex(Handle);
+	if (Index == INDEX_NONE || !Buffer)
+	{
+		return;
+	}
+
+	FVirtualDevice& Device = Devices[Index];
+	FScopeLock Lock(&Device.Lock);
+	Device.Captures[static_cast<int32>(Kind)].Add(Buffer, Length);
+}
+
+void FVirtualDeviceInfo::NotifyDevicesChanged()
+{
+	FScopeLock Lock(&HotplugLock);
+	if (OnHotplug)
+	{
+		OnHotplug();
+	}
+}
@@ -3,13 +3,99 @@
 // Planned Release Year: 2025
 
 #include "Core/Platforms/Windows/WindowsDeviceInfo.h"
+#include "Core/ImuCalibrationRegistry.h"
 #include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
 #include "Runtime/ApplicationCore/Public/GenericPlatform/IInputInterface.h"
 #include <hidsdi.h>
 #include <setupapi.h>
 
+namespace
+{
+	/**
+	 * Parses Digits hexadecimal characters and keeps the low 16 bits.
+	 */
+	bool ParseHexId(const WCHAR* Text, const int32 Digits, uint16& OutValue)
+	{
+		uint32 Value = 0;
+		for (int32 i = 0; i < Digits; ++i)
+		{
+			const WCHAR Character = Text[i];
+			uint32 Nibble;
+			if (Character >= TEXT('0') && Character <= TEXT('9'))
+			{
+				Nibble = Character - TEXT('0');
+			}
+			else if (Character >= TEXT('a') && Character <= TEXT('f'))
+			{
+				Nibble = Character - TEXT('a') + 10;
+			}
+			else if (Character >= TEXT('A') && Character <= TEXT('F'))
+			{
+				Nibble = Character - TEXT('A') + 10;
+			}
+			else
+			{
+				return false;
+			}
+			Value = (Value << 4) | Nibble;
+		}
+		OutValue = static_cast<uint16>(Value);
+		return true;
+	}
+
+	/**
+	 * Reads the vendor and product ids out of a HID interface path without opening the device.
+	 * USB paths carry "VID_054C&PID_0CE6", Bluetooth paths "VID&0002054C_PID&0CE6", where 0002 is the id source.
+	 */
+	bool ParseVendorAndProduct(const WCHAR* Path, uint16& OutVendorId, uint16& OutProductId)
+	{
+		const WCHAR* Vendor = FCString::Stristr(Path, TEXT("VID"));
+		const WCHAR* Product = Vendor ? FCString::Stristr(Vendor, TEXT("PID")) : nullptr;
+		if (!Product)
+		{
+			return false;
+		}
+
+		const bool bVendorParsed = Vendor[3] == TEXT('_') ? ParseHexId(Vendor + 4, 4, OutVendorId)
+		                                                   : Vendor[3] == TEXT('&') && ParseHexId(Vendor + 4, 8, OutVendorId);
+		const bool bProductParsed = (Product[3] == TEXT('_') || Product[3] == TEXT('&')) && ParseHexId(Product + 4, 4, OutProductId);
+		return bVendorParsed && bProductParsed;
+	}
+
+	/**
+	 * Maps the ids of a supported controller to its model.
+	 *
+	 * @return False if the ids are not those of a supported controller.
+	 */
+	bool GetControllerType(const uint16 VendorId, const uint16 ProductId, EDeviceType& OutDeviceType)
+	{
+		if (VendorId != 0x054C)
+		{
+			return false;
+		}
+
+		switch (ProductId)
+		{
+			case 0x05C4:
+			case 0x09CC:
+				OutDeviceType = EDeviceType::DualShock4;
+				return true;
+			case 0x0DF2:
+				OutDeviceType = EDeviceType::DualSenseEdge;
+				return true;
+			case 0x0CE6:
+				OutDeviceType = EDeviceType::DualSense;
+				return true;
+			default:
+				return false;
+		}
+	}
+} // namespace
+
 void FWindowsDeviceInfo::Detect(TArray<FDeviceContext>& Devices)
 {
+	bIdentificationFailed = false;
+
 	GUID HidGuid;
 	HidD_GetHidGuid(&HidGuid);
 
@@ -18,133 +104,219 @@ void FWindowsDeviceInfo::Detect(TArray<FDeviceContext>& Devices)
 	if (DeviceInfoSet == INVALID_HANDLE_VALUE)
 	{
 		UE_LOG(LogTemp, Error, TEXT("HIDManager: Falha ao obter informações dos dispositivos HID."));
+		bIdentificationFailed = true;
 		return;
 	}
 
 	SP_DEVICE_INTERFACE_DATA DeviceInterfaceData = {};
 	DeviceInterfaceData.cbSize = sizeof(SP_DEVICE_INTERFACE_DATA);
 
-	TMap<int32, FString> DevicePaths;
+	TSet<FString> CandidatePaths;
 	for (int32 DeviceIndex = 0; SetupDiEnumDeviceInterfaces(DeviceInfoSet, nullptr, &HidGuid, DeviceIndex,
 	                                                        &DeviceInterfaceData);
 	     DeviceIndex++)
 	{
 		DWORD RequiredSize = 0;
 		SetupDiGetDeviceInterfaceDetail(DeviceInfoSet, &DeviceInterfaceData, nullptr, 0, &RequiredSize, nullptr);
+		if (RequiredSize < sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA))
+		{
+			continue;
+		}
 
-		const auto DetailDataBuffer = static_cast<PSP_DEVICE_INTERFACE_DETAIL_DATA>(malloc(RequiredSize));
-		if (!DetailDataBuffer)
+		if (DetailDataBuffer.Num() < static_cast<int32>(RequiredSize))
+		{
+			DetailDataBuffer.SetNumUninitialized(RequiredSize);
+		}
+		const auto DetailData = reinterpret_cast<PSP_DEVICE_INTERFACE_DETAIL_DATA>(DetailDataBuffer.GetData());
+		DetailData->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA);
+		if (!SetupDiGetDeviceInterfaceDetail(DeviceInfoSet, &DeviceInterfaceData, DetailData, RequiredSize,
+		                                     nullptr, nullptr))
 		{
-			UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to allocate memory for device details."));
 			continue;
 		}
 
-		DetailDataBuffer->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA);
-		if (SetupDiGetDeviceInterfaceDetail(DeviceInfoSet, &DeviceInterfaceData, DetailDataBuffer, RequiredSize,
-		                                    nullptr, nullptr))
+		// Keyboards, mice, headsets and the like are rejected from their path alone, without being opened.
+		if (!IsCandidateControllerPath(DetailData->DevicePath))
 		{
-			const HANDLE TempDeviceHandle = CreateFileW(
-			    DetailDataBuffer->DevicePath,
-			    GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, NULL, nullptr);
+			continue;
+		}
 
-			if (TempDeviceHandle != INVALID_HANDLE_VALUE)
+		FString PathStr(DetailData->DevicePath);
+		CandidatePaths.Add(PathStr);
+
+		const FDetectedInterface* Detected = DetectedInterfaces.Find(PathStr);
+		if (!Detected)
+		{
+			FDetectedInterface Identified;
+			if (!IdentifyInterface(DetailData->DevicePath, PathStr, Identified))
 			{
-				HIDD_ATTRIBUTES Attributes = {};
-				Attributes.Size = sizeof(HIDD_ATTRIBUTES);
+				// Not cached, so the next detection opens it again; make sure one runs without a notification.
+				bIdentificationFailed = true;
+				continue;
+			}
+			Detected = &DetectedInterfaces.Add(PathStr, Identified);
+		}
+
+		if (Detected->bIsController)
+		{
+			FDeviceContext Context = {};
+			Context.Path = PathStr;
+			Context.DeviceType = Detected->DeviceType;
+			Context.ConnectionType = Detected->ConnectionType;
+			Context.IsConnected = true;
+			Devices.Add(Context);
+		}
+	}
+
+	SetupDiDestroyDeviceInfoList(DeviceInfoSet);
 
-				if (HidD_GetAttributes(TempDeviceHandle, &Attributes))
+	// Forget interfaces that went away, so a controller reappearing on the same path is identified and configured again.
+	for (auto It = DetectedInterfaces.CreateIterator(); It; ++It)
+	{
+		if (!CandidatePaths.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FWindowsDeviceInfo::IdentifyInterface(const WCHAR* DevicePath, const FString& PathStr, FDetectedInterface& OutInterface)
+{
+	const HANDLE TempDeviceHandle = CreateFileW(
+	    DevicePath,
+	    GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, NULL, nullptr);
+	if (TempDeviceHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	bool bIdentified = true;
+	OutInterface = FDetectedInterface();
+	HIDD_ATTRIBUTES Attributes = {};
+	Attributes.Size = sizeof(HIDD_ATTRIBUTES);
+	if (!HidD_GetAttributes(TempDeviceHandle, &Attributes))
+	{
+		bIdentified = false;
+	}
+	else if (GetControllerType(Attributes.VendorID, Attributes.ProductID, OutInterface.DeviceType))
+	{
+		WCHAR DeviceProductString[260];
+		if (HidD_GetProductString(TempDeviceHandle, DeviceProductString, 260))
+		{
+			OutInterface.bIsController = true;
+			OutInterface.ConnectionType = EDeviceConnection::Usb;
+			if (PathStr.Contains(TEXT("{00001124-0000-1000-8000-00805f9b34fb}")) ||
+			    PathStr.Contains(TEXT("bth")) ||
+			    PathStr.Contains(TEXT("BTHENUM")))
+			{
+				OutInterface.ConnectionType = EDeviceConnection::Bluetooth;
+				if (!ConfigureBluetoothFeatures(TempDeviceHandle, OutInterface.DeviceType))
 				{
-					if (
-					    Attributes.VendorID == 0x054C &&
-					    (Attributes.ProductID == 0x0CE6 ||
-					     Attributes.ProductID == 0x0DF2 ||
-					     Attributes.ProductID == 0x05C4 ||
-					     Attributes.ProductID == 0x09CC))
-					{
-						FDeviceContext Context = {};
-						WCHAR DeviceProductString[260];
-						if (HidD_GetProductString(TempDeviceHandle, DeviceProductString, 260))
-						{
-							if (!DevicePaths.Contains(DeviceIndex))
-							{
-								FString PathStr(DetailDataBuffer->DevicePath);
-								Context.Path = PathStr;
-								DevicePaths.Add(DeviceIndex, PathStr);
-								switch (Attributes.ProductID)
-								{
-									case 0x05C4:
-									case 0x09CC:
-										Context.DeviceType = EDeviceType::DualShock4;
-										break;
-									case 0x0DF2:
-										Context.DeviceType = EDeviceType::DualSenseEdge;
-										break;
-									default: Context.DeviceType = EDeviceType::DualSense;
-								}
-
-								Context.IsConnected = true;
-								Context.ConnectionType = EDeviceConnection::Usb;
-								FString DevicePath(Context.Path);
-								if (DevicePath.Contains(TEXT("{00001124-0000-1000-8000-00805f9b34fb}")) ||
-								    DevicePath.Contains(TEXT("bth")) ||
-								    DevicePath.Contains(TEXT("BTHENUM")))
-								{
-									Context.ConnectionType = EDeviceConnection::Bluetooth;
-									if (!ConfigureBluetoothFeatures(TempDeviceHandle))
-									{
-										UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to configure Bluetooth features."));
-									}
-								}
-								Devices.Add(Context);
-							}
-						}
-						else
-						{
-							UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to obtain device path for the DualSense."));
-						}
-					}
+					UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to configure Bluetooth features."));
 				}
-				CloseHandle(TempDeviceHandle);
 			}
 		}
-		free(DetailDataBuffer);
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to obtain device path for the DualSense."));
+			bIdentified = false;
+		}
 	}
 
-	SetupDiDestroyDeviceInfoList(DeviceInfoSet);
+	CloseHandle(TempDeviceHandle);
+	return bIdentified;
 }
 
-void FWindowsDeviceInfo::Read(FDeviceContext* Context)
+bool FWindowsDeviceInfo::StartHotplugNotifications(TFunction<void()> OnDevicesChanged)
 {
-	if (!Context)
+	if (HotplugNotification)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Context nto found!"));
-		return;
+		return true;
 	}
 
-	if (Context->Handle == INVALID_HANDLE_VALUE)
+	CM_NOTIFY_FILTER Filter = {};
+	Filter.cbSize = sizeof(CM_NOTIFY_FILTER);
+	Filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+	HidD_GetHidGuid(&Filter.u.DeviceInterface.ClassGuid);
+
+	OnHotplug = MoveTemp(OnDevicesChanged);
+	const CONFIGRET Result = CM_Register_Notification(&Filter, this, &FWindowsDeviceInfo::OnHotplugNotification, &HotplugNotification);
+	if (Result != CR_SUCCESS)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Invalid device handle before attempting to read"));
-		return;
+		UE_LOG(LogTemp, Warning, TEXT("HIDManager: CM_Register_Notification failed (%u), falling back to polling."), Result);
+		HotplugNotification = nullptr;
+		OnHotplug = nullptr;
+		return false;
 	}
+	return true;
+}
 
-	if (!Context->IsConnected)
+void FWindowsDeviceInfo::StopHotplugNotifications()
+{
+	if (!HotplugNotification)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Dualsense: DeviceContext->Connected, false"));
 		return;
 	}
 
-	DWORD BytesRead = 0;
-	HidD_FlushQueue(Context->Handle);
+	// Blocks until a callback in flight has returned, so OnHotplug can be released afterwards.
+	CM_Unregister_Notification(HotplugNotification);
+	HotplugNotification = nullptr;
+	OnHotplug = nullptr;
+}
+
+DWORD CALLBACK FWindowsDeviceInfo::OnHotplugNotification(HCMNOTIFICATION Notification, PVOID Context, const CM_NOTIFY_ACTION Action,
+                                                         PCM_NOTIFY_EVENT_DATA EventData, DWORD EventDataSize)
+{
+	if (Action != CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL && Action != CM_NOTIFY_ACTION_DEVICEINTERFACEREMOVAL)
+	{
+		return ERROR_SUCCESS;
+	}
 
-	if (Context->ConnectionType == EDeviceConnection::Bluetooth && Context->DeviceType == EDeviceType::DualShock4)
+	if (!EventData || !IsCandidateControllerPath(EventData->u.DeviceInterface.SymbolicLink))
 	{
-		constexpr size_t InputReportLength = 547;
-		PollTick(Context->Handle, Context->BufferDS4, InputReportLength, BytesRead);
+		return ERROR_SUCCESS;
 	}
-	else
+
+	const FWindowsDeviceInfo* DeviceInfo = static_cast<const FWindowsDeviceInfo*>(Context);
+	if (DeviceInfo->OnHotplug)
 	{
-		const size_t InputBufferSize = Context->ConnectionType == EDeviceConnection::Bluetooth ? 78 : 64;
-		PollTick(Context->Handle, Context->Buffer, InputBufferSize, BytesRead);
+		DeviceInfo->OnHotplug();
+	}
+	return ERROR_SUCCESS;
+}
+
+bool FWindowsDeviceInfo::IsCandidateControllerPath(const WCHAR* Path)
+{
+	if (!Path)
+	{
+		return false;
+	}
+
+	// Paths in an unexpected format are opened to be safe; only a parsed foreign id rules an interface out.
+	uint16 VendorId = 0;
+	uint16 ProductId = 0;
+	EDeviceType DeviceType;
+	return !ParseVendorAndProduct(Path, VendorId, ProductId) || GetControllerType(VendorId, ProductId, DeviceType);
+}
+
+int32 FWindowsDeviceInfo::Read(FDeviceContext* Context, unsigned char* Buffer, const int32 Length, const int32 TimeoutMs)
+{
+	if (!Context || Context->InputHandle == INVALID_HANDLE_VALUE)
+	{
+		return -1;
+	}
+
+	DWORD BytesRead = 0;
+	switch (PollTick(Context->InputHandle, Buffer, Length, TimeoutMs, BytesRead))
+	{
+		case EPollResult::ReadOk:
+			return static_cast<int32>(BytesRead);
+		case EPollResult::Disconnected:
+			return -1;
+		case EPollResult::TransientError:
+			return ReadTransientError;
+		default:
+			return 0;
 	}
 }
 
@@ -157,13 +329,24 @@ void FWindowsDeviceInfo::Write(FDeviceContext* Context)
 
 	size_t InReportLength = Context->DeviceType == EDeviceType::DualShock4 ? 32 : 74;
 	size_t OutputReportLength = Context->ConnectionType == EDeviceConnection::Bluetooth ? 78 : InReportLength;
+	WriteReport(Context, Context->BufferOutput, static_cast<int32>(OutputReportLength));
+}
+
+bool FWindowsDeviceInfo::WriteReport(FDeviceContext* Context, const unsigned char* Buffer, const int32 Length)
+{
+	if (!Context || Context->Handle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
 
 	DWORD BytesWritten = 0;
-	if (!WriteFile(Context->Handle, Context->BufferOutput, OutputReportLength, &BytesWritten, nullptr))
+	if (!WriteFile(Context->Handle, Buffer, Length, &BytesWritten, nullptr))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to write output report 0x02/0x31 data to device. report %llu error Code: %d"),
-		       OutputReportLength, GetLastError());
+		UE_LOG(LogTemp, Error, TEXT("Failed to write output report 0x%02X data to device. report %d error Code: %d"),
+		       Buffer[0], Length, GetLastError());
+		return false;
 	}
+	return true;
 }
 
 bool FWindowsDeviceInfo::CreateHandle(FDeviceContext* DeviceContext)
@@ -179,7 +362,26 @@ bool FWindowsDeviceInfo::CreateHandle(FDeviceContext* DeviceContext)
 		return false;
 	}
 
+	// Input reports are read through a separate overlapped handle owned by the reader thread. Synchronous I/O
+	// on a single handle is serialized by the I/O manager, so sharing it would stall every output write behind
+	// a pending read.
+	const HANDLE InputHandle = CreateFileW(
+	    *DeviceContext->Path,
+	    GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
+
+	if (InputHandle == INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(DeviceHandle);
+		DeviceContext->Handle = INVALID_HANDLE_VALUE;
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to open input handle for the DualSense."));
+		return false;
+	}
+
+	// Give the driver room to hold reports while the reader thread is descheduled, so bursts are queued rather than overwritten.
+	HidD_SetNumInputBuffers(InputHandle, 128);
+
 	DeviceContext->Handle = DeviceHandle;
+	DeviceContext->InputHandle = InputHandle;
 	return true;
 }
 
@@ -190,6 +392,12 @@ void FWindowsDeviceInfo::InvalidateHandle(FDeviceContext* Context)
 		return;
 	}
 
+	if (Context->InputHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(Context->InputHandle);
+		Context->InputHandle = INVALID_HANDLE_VALUE;
+	}
+
 	if (Context->Handle != INVALID_HANDLE_VALUE)
 	{
 		CloseHandle(Context->Handle);
@@ -213,18 +421,58 @@ void FWindowsDeviceInfo::InvalidateHandle(HANDLE Handle)
 	}
 }
 
-EPollResult FWindowsDeviceInfo::PollTick(HANDLE Handle, unsigned char* Buffer, int32 Length, DWORD& OutBytesRead)
+EPollResult FWindowsDeviceInfo::PollTick(HANDLE Handle, unsigned char* Buffer, int32 Length, int32 TimeoutMs, DWORD& OutBytesRead)
 {
-	int32 Err = ERROR_SUCCESS;
-	PingOnce(Handle, &Err);
+	// One event per reader thread; ReadFile resets it when the next overlapped read is queued.
+	struct FReadEvent
+	{
+		HANDLE Event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+		~FReadEvent()
+		{
+			if (Event)
+			{
+				CloseHandle(Event);
+			}
+		}
+	};
+	thread_local FReadEvent ReadEvent;
 
 	OutBytesRead = 0;
-	if (!ReadFile(Handle, Buffer, Length, &OutBytesRead, nullptr))
+	if (!ReadEvent.Event)
 	{
-		return EPollResult::Disconnected;
+		return EPollResult::TransientError;
 	}
 
-	return EPollResult::ReadOk;
+	OVERLAPPED Overlapped = {};
+	Overlapped.hEvent = ReadEvent.Event;
+	if (ReadFile(Handle, Buffer, Length, &OutBytesRead, &Overlapped))
+	{
+		return EPollResult::ReadOk;
+	}
+
+	DWORD Error = GetLastError();
+	if (Error == ERROR_IO_PENDING)
+	{
+		if (WaitForSingleObject(Overlapped.hEvent, TimeoutMs) == WAIT_TIMEOUT)
+		{
+			CancelIoEx(Handle, &Overlapped);
+			// The read may have completed while it was being cancelled; keep that report instead of dropping it.
+			if (GetOverlappedResult(Handle, &Overlapped, &OutBytesRead, TRUE) && OutBytesRead > 0)
+			{
+				return EPollResult::ReadOk;
+			}
+			OutBytesRead = 0;
+			return EPollResult::NoIoThisTick;
+		}
+
+		if (GetOverlappedResult(Handle, &Overlapped, &OutBytesRead, FALSE))
+		{
+			return EPollResult::ReadOk;
+		}
+		Error = GetLastError();
+	}
+
+	return ShouldTreatAsDisconnected(Error) ? EPollResult::Disconnected : EPollResult::TransientError;
 }
 
 bool FWindowsDeviceInfo::PingOnce(HANDLE Handle, int32* OutLastError)
@@ -274,7 +522,22 @@ void FWindowsDeviceInfo::ProcessAudioHapitc(FDeviceContext* Context)
 	}
 }
 
-bool FWindowsDeviceInfo::ConfigureBluetoothFeatures(HANDLE DeviceHandle)
+bool FWindowsDeviceInfo::GetFeatureReport(FDeviceContext* Context, unsigned char* Buffer, const int32 Length)
+{
+	if (!Context || Context->Handle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	if (!HidD_GetFeature(Context->Handle, Buffer, Length))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to get Feature 0x%02X. Error: %d"), Buffer[0], GetLastError());
+		return false;
+	}
+	return true;
+}
+
+bool FWindowsDeviceInfo::ConfigureBluetoothFeatures(HANDLE DeviceHandle, const EDeviceType DeviceType)
 {
 	// Feature Report 0x05 - Enables advanced Bluetooth features
 	unsigned char FeatureBuffer[41];
@@ -287,5 +550,18 @@ bool FWindowsDeviceInfo::ConfigureBluetoothFeatures(HANDLE DeviceHandle)
 		return false;
 	}
 
+	// The report carries the motion sensor calibration; keep it under the controller's address for the library.
+	if (DeviceType == EDeviceType::DualSense || DeviceType == EDeviceType::DualSenseEdge)
+	{
+		unsigned char PairingBuffer[FImuCalibrationRegistry::DualSensePairingReportSize];
+		FMemory::Memzero(PairingBuffer, sizeof(PairingBuffer));
+		PairingBuffer[0] = FImuCalibrationRegistry::DualSensePairingReportId;
+		uint64 Address = 0;
+		if (HidD_GetFeature(DeviceHandle, PairingBuffer, sizeof(PairingBuffer)) &&
+		    FImuCalibrationRegistry::ParseDualSenseAddress(PairingBuffer, sizeof(PairingBuffer), Address))
+		{
+			FImuCalibrationRegistry::StoreDualSenseReport(Address, FeatureBuffer, sizeof(FeatureBuffer));
+		}
+	}
 	return true;
 }
@@ -5,9 +5,20 @@
 #include "Core/PlayStationOutputComposer.h"
 #include "Core/Interfaces/PlatformHardwareInfoInterface.h"
 #include "Core/Structs/DeviceContext.h"
+#include "Core/Threads/OutputWriterThread.h"
+#include "HAL/IConsoleManager.h"
 
 const uint32 FPlayStationOutputComposer::CRCSeed = 0xeada2d49;
 
+static_assert(FCrc32::ExtendByte(0, 0xA2) == FPlayStationOutputComposer::CRCSeed, "CRCSeed must be the CRC32 of the 0xA2 HID header byte.");
+
+static TAutoConsoleVariable<float> CVarOutputKeepAliveInterval(
+    TEXT("ds.OutputKeepAliveInterval"),
+    0.0f,
+    TEXT("Seconds after which an unchanged output report is sent again.\n")
+    TEXT("Reports identical to the last one sent are otherwise suppressed. 0 never resends."),
+    ECVF_Default);
+
 void FPlayStationOutputComposer::OutputDualShock(FDeviceContext* DeviceContext)
 {
 	const FOutputContext* HidOut = &DeviceContext->Output;
@@ -42,14 +53,14 @@ void FPlayStationOutputComposer::OutputDualShock(FDeviceContext* DeviceContext)
 
 	if (DeviceContext->ConnectionType == EDeviceConnection::Bluetooth)
 	{
-		const uint32 CrcChecksum = Compute(DeviceContext->BufferOutput, 74);
+		const uint32 CrcChecksum = ComputeAfterPrefix(DeviceContext->BufferOutput, 74, DualShockOutputPrefixCrc);
 		DeviceContext->BufferOutput[0x4A] = static_cast<unsigned char>((CrcChecksum & 0x000000FF) >> 0UL);
 		DeviceContext->BufferOutput[0x4B] = static_cast<unsigned char>((CrcChecksum & 0x0000FF00) >> 8UL);
 		DeviceContext->BufferOutput[0x4C] = static_cast<unsigned char>((CrcChecksum & 0x00FF0000) >> 16UL);
 		DeviceContext->BufferOutput[0x4D] = static_cast<unsigned char>((CrcChecksum & 0xFF000000) >> 24UL);
 	}
 
-	IPlatformHardwareInfoInterface::Get().Write(DeviceContext);
+	Submit(DeviceContext);
 }
 
 void FPlayStationOutputComposer::OutputDualSense(FDeviceContext* DeviceContext)
@@ -95,14 +106,63 @@ void FPlayStationOutputComposer::OutputDualSense(FDeviceContext* DeviceContext)
 
 	if (DeviceContext->ConnectionType == EDeviceConnection::Bluetooth)
 	{
-		const int32 CrcChecksum = Compute(DeviceContext->BufferOutput, 74);
+		const int32 CrcChecksum = ComputeAfterPrefix(DeviceContext->BufferOutput, 74, DualSenseOutputPrefixCrc);
 		DeviceContext->BufferOutput[0x4A] = static_cast<unsigned char>((CrcChecksum & 0x000000FF) >> 0UL);
 		DeviceContext->BufferOutput[0x4B] = static_cast<unsigned char>((CrcChecksum & 0x0000FF00) >> 8UL);
 		DeviceContext->BufferOutput[0x4C] = static_cast<unsigned char>((CrcChecksum & 0x00FF0000) >> 16UL);
 		DeviceContext->BufferOutput[0x4D] = static_cast<unsigned char>((CrcChecksum & 0xFF000000) >> 24UL);
 	}
 
+	Submit(DeviceContext);
+}
+
+bool FPlayStationOutputComposer::IsKeepAliveDue(const FDeviceContext& DeviceContext)
+{
+	const float KeepAliveInterval = CVarOutputKeepAliveInterval.GetValueOnAnyThread();
+	return KeepAliveInterval > 0.0f && DeviceContext.LastSentOutputLength > 0 &&
+	       FPlatformTime::Seconds() - DeviceContext.LastOutputSendTime >= KeepAliveInterval;
+}
+
+bool FPlayStationOutputComposer::IsResendDue(const FDeviceContext& DeviceContext)
+{
+	return IsKeepAliveDue(DeviceContext) ||
+	       (DeviceContext.OutputWriter &&
+	        DeviceContext.OutputWriter->GetFailedWriteCount() != DeviceContext.HandledFailedWrites);
+}
+
+void FPlayStationOutputComposer::Submit(FDeviceContext* DeviceContext)
+{
+	const int32 Length = FOutputWriterThread::GetOutputReportLength(*DeviceContext);
+	if (DeviceContext->OutputWriter)
+	{
+		const uint32 FailedWrites = DeviceContext->OutputWriter->GetFailedWriteCount();
+		if (FailedWrites != DeviceContext->HandledFailedWrites)
+		{
+			// The device dropped a report, possibly the one the shadow copy holds; send the current state again.
+			DeviceContext->HandledFailedWrites = FailedWrites;
+			DeviceContext->LastSentOutputLength = 0;
+		}
+	}
+
+	if (!IsKeepAliveDue(*DeviceContext) && DeviceContext->LastSentOutputLength == Length &&
+	    FMemory::Memcmp(DeviceContext->LastSentOutput, DeviceContext->BufferOutput, Length) == 0)
+	{
+		DeviceContext->SuppressedOutputReports++;
+		return;
+	}
+
+	FMemory::Memcpy(DeviceContext->LastSentOutput, DeviceContext->BufferOutput, Length);
+	DeviceContext->LastSentOutputLength = Length;
+	DeviceContext->LastOutputSendTime = FPlatformTime::Seconds();
+
+	if (DeviceContext->OutputWriter)
+	{
+		DeviceContext->OutputWriter->Publish(DeviceContext->BufferOutput, Length);
+		return;
+	}
+
 	IPlatformHardwareInfoInterface::Get().Write(DeviceContext);
+	DeviceContext->SentOutputReports++;
 }
 
 void FPlayStationOutputComposer::SetTriggerEffects(unsigned char* Trigger, FHapticTriggers& Effect)
@@ -228,7 +288,9 @@ void FPlayStationOutputComposer::SendAudioHapticAdvanced(FDeviceContext* DeviceC
 	if (DeviceContext->ConnectionType == EDeviceConnection::Bluetooth)
 	{
 		constexpr size_t CrcOffset = 138;
-		const int32 CrcChecksum = Compute(DeviceContext->BufferAudio, CrcOffset);
+		// The header bytes can be overridden from the console (ds.SetAudioByte), so only the default one takes the shortcut.
+		const unsigned char* Audio = DeviceContext->BufferAudio;
+		const int32 CrcChecksum = Audio[0] == 0x32 && Audio[1] == 0x00 ? ComputeAfterPrefix(Audio, CrcOffset, AudioHapticPrefixCrc) : Compute(Audio, CrcOffset);
 		DeviceContext->BufferAudio[CrcOffset + 0] = static_cast<unsigned char>((CrcChecksum & 0x000000FF) >> 0UL);
 		DeviceContext->BufferAudio[CrcOffset + 1] = static_cast<unsigned char>((CrcChecksum & 0x0000FF00) >> 8UL);
 		DeviceContext->BufferAudio[CrcOffset + 2] = static_cast<unsigned char>((CrcChecksum & 0x00FF0000) >> 16UL);
@@ -272,6 +334,16 @@ const uint32 FPlayStationOutputComposer::HashTable[256] = {
     0x616495a3, 0x1663a535, 0x8f6af48f, 0xf86dc419, 0x660951ba, 0x110e612c, 0x88073096, 0xFF000000};
 
 uint32 FPlayStationOutputComposer::Compute(const unsigned char* Buffer, const size_t Len)
+{
+	return FCrc32::Extend(CRCSeed, Buffer, Len);
+}
+
+uint32 FPlayStationOutputComposer::ComputeAfterPrefix(const unsigned char* Buffer, const size_t Len, const uint32 PrefixCrc)
+{
+	return FCrc32::Extend(PrefixCrc, Buffer + 2, Len - 2);
+}
+
+uint32 FPlayStationOutputComposer::ComputeReference(const unsigned char* Buffer, const size_t Len)
 {
 	uint32 Result = CRCSeed;
 	for (size_t i = 0; i < Len; i++)
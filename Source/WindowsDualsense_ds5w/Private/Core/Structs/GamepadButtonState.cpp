@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Structs/GamepadButtonState.h"
+#include "InputCoreTypes.h"
+
+namespace
+{
+	struct FGamepadButtonKeyNames
+	{
+		FName Names[EGamepadButton::Count];
+
+		FGamepadButtonKeyNames()
+		{
+			using namespace EGamepadButton;
+			Names[FaceButtonBottom] = FGamepadKeyNames::FaceButtonBottom;
+			Names[FaceButtonRight] = FGamepadKeyNames::FaceButtonRight;
+			Names[FaceButtonLeft] = FGamepadKeyNames::FaceButtonLeft;
+			Names[FaceButtonTop] = FGamepadKeyNames::FaceButtonTop;
+			Names[DPadUp] = FGamepadKeyNames::DPadUp;
+			Names[DPadDown] = FGamepadKeyNames::DPadDown;
+			Names[DPadLeft] = FGamepadKeyNames::DPadLeft;
+			Names[DPadRight] = FGamepadKeyNames::DPadRight;
+			Names[LeftShoulder] = FGamepadKeyNames::LeftShoulder;
+			Names[RightShoulder] = FGamepadKeyNames::RightShoulder;
+			Names[LeftTriggerThreshold] = FGamepadKeyNames::LeftTriggerThreshold;
+			Names[RightTriggerThreshold] = FGamepadKeyNames::RightTriggerThreshold;
+			Names[LeftThumb] = FGamepadKeyNames::LeftThumb;
+			Names[RightThumb] = FGamepadKeyNames::RightThumb;
+			Names[SpecialLeft] = FGamepadKeyNames::SpecialLeft;
+			Names[SpecialRight] = FGamepadKeyNames::SpecialRight;
+			Names[PushLeftStick] = FName("PS_PushLeftStick");
+			Names[PushRightStick] = FName("PS_PushRightStick");
+			Names[Menu] = FName("PS_Menu");
+			Names[Share] = FName("PS_Share");
+			Names[PlayStation] = FName("PS_Button");
+			Names[TouchPad] = FName("PS_TouchButtom");
+			Names[Mic] = FName("PS_Mic");
+			Names[FunctionL] = FName("PS_FunctionL");
+			Names[FunctionR] = FName("PS_FunctionR");
+			Names[PaddleL] = FName("PS_PaddleL");
+			Names[PaddleR] = FName("PS_PaddleR");
+			Names[LeftStickUp] = FGamepadKeyNames::LeftStickUp;
+			Names[LeftStickDown] = FGamepadKeyNames::LeftStickDown;
+			Names[LeftStickLeft] = FGamepadKeyNames::LeftStickLeft;
+			Names[LeftStickRight] = FGamepadKeyNames::LeftStickRight;
+			Names[RightStickUp] = FGamepadKeyNames::RightStickUp;
+			Names[RightStickDown] = FGamepadKeyNames::RightStickDown;
+			Names[RightStickLeft] = FGamepadKeyNames::RightStickLeft;
+			Names[RightStickRight] = FGamepadKeyNames::RightStickRight;
+		}
+	};
+} // namespace
+
+const FName& FGamepadButtonState::GetKeyName(const uint32 Button)
+{
+	// Built on first use rather than at static initialization, since FGamepadKeyNames lives in another module.
+	static const FGamepadButtonKeyNames KeyNames;
+	check(Button < EGamepadButton::Count);
+	return KeyNames.Names[Button];
+}
+
+void FGamepadButtonState::Update(const uint64 NewMask, const uint64 AffectedBits,
+                                 const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+                                 const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+                                 TArray<FSubFrameInputEvent>* OutEvents, const double Timestamp)
+{
+	const uint64 NextMask = (Mask & ~AffectedBits) | (NewMask & AffectedBits);
+	uint64 Changed = Mask ^ NextMask;
+	Mask = NextMask;
+
+	while (Changed != 0)
+	{
+		const uint32 Button = static_cast<uint32>(FMath::CountTrailingZeros64(Changed));
+		Changed &= Changed - 1;
+
+		const FName& KeyName = GetKeyName(Button);
+		const bool bPressed = (NextMask >> Button) & 1;
+		if (bPressed)
+		{
+			InMessageHandler.Get().OnControllerButtonPressed(KeyName, UserId, InputDeviceId, false);
+		}
+		else
+		{
+			InMessageHandler.Get().OnControllerButtonReleased(KeyName, UserId, InputDeviceId, false);
+		}
+
+		if (OutEvents)
+		{
+			FSubFrameInputEvent& Event = OutEvents->AddDefaulted_GetRef();
+			Event.Button = KeyName;
+			Event.bPressed = bPressed;
+			Event.Timestamp = Timestamp;
+		}
+	}
+}
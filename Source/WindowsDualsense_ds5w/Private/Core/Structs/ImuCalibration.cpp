@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Structs/ImuCalibration.h"
+
+namespace
+{
+	// Nominal resolutions the calibrated samples are normalized to.
+	constexpr float GyroResPerDegS = 1024.0f;
+	constexpr float AccelResPerG = 8192.0f;
+
+	int16 ReadInt16(const unsigned char* Report, const int32 Offset)
+	{
+		return static_cast<int16>(Report[Offset] | (Report[Offset + 1] << 8));
+	}
+} // namespace
+
+bool FImuCalibration::ParseDualSense(const unsigned char* Report, const int32 Length, FImuCalibration& OutCalibration)
+{
+	if (!Report || Length < DualSenseReportSize || Report[0] != DualSenseReportId)
+	{
+		return false;
+	}
+
+	// Gyro bias, then the raw reading at +speed and -speed for pitch (X), yaw (Y) and roll (Z).
+	const int32 GyroBias[3] = {ReadInt16(Report, 1), ReadInt16(Report, 3), ReadInt16(Report, 5)};
+	const int32 GyroPlus[3] = {ReadInt16(Report, 7), ReadInt16(Report, 11), ReadInt16(Report, 15)};
+	const int32 GyroMinus[3] = {ReadInt16(Report, 9), ReadInt16(Report, 13), ReadInt16(Report, 17)};
+	const int32 GyroSpeed2x = ReadInt16(Report, 19) + ReadInt16(Report, 21);
+
+	// Raw accelerometer reading at +1 g and -1 g for each axis.
+	const int32 AccelPlus[3] = {ReadInt16(Report, 23), ReadInt16(Report, 27), ReadInt16(Report, 31)};
+	const int32 AccelMinus[3] = {ReadInt16(Report, 25), ReadInt16(Report, 29), ReadInt16(Report, 33)};
+
+	FImuCalibration Calibration;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const int32 GyroRange = FMath::Abs(GyroPlus[Axis] - GyroBias[Axis]) + FMath::Abs(GyroMinus[Axis] - GyroBias[Axis]);
+		const int32 AccelRange2g = AccelPlus[Axis] - AccelMinus[Axis];
+		if (GyroRange == 0 || GyroSpeed2x == 0 || AccelRange2g == 0)
+		{
+			return false;
+		}
+
+		// The firmware already removes the factory zero-rate offset from the reported samples, so
+		// only the sensitivity is applied; the residual drift is left to the runtime bias estimation.
+		Calibration.GyroBias[Axis] = 0.0f;
+		Calibration.GyroScale[Axis] = GyroSpeed2x * GyroResPerDegS / GyroRange;
+
+		Calibration.AccelBias[Axis] = AccelPlus[Axis] - AccelRange2g * 0.5f;
+		Calibration.AccelScale[Axis] = 2.0f * AccelResPerG / AccelRange2g;
+	}
+
+	Calibration.bFromDevice = true;
+	OutCalibration = Calibration;
+	return true;
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Threads/HapticsPacerThread.h"
+#include "Core/DeviceRegistry.h"
+#include "Core/Interfaces/SonyGamepadTriggerInterface.h"
+#include "Core/Threads/HapticFrameRing.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+
+FHapticsPacerThread::FHapticsPacerThread(const FInputDeviceId InDeviceId, FHapticFrameRing& InFrames, const double InPacketPeriod)
+    : DeviceId(InDeviceId)
+    , Frames(InFrames)
+    , PacketPeriod(InPacketPeriod)
+    , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+{
+}
+
+FHapticsPacerThread::~FHapticsPacerThread()
+{
+	Shutdown();
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+bool FHapticsPacerThread::Start()
+{
+	if (Thread)
+	{
+		return true;
+	}
+
+	bStopRequested.store(false, std::memory_order_relaxed);
+	Thread = FRunnableThread::Create(this, TEXT("DualSenseHapticsPacer"), 0, TPri_AboveNormal);
+	if (!Thread)
+	{
+		UE_LOG(LogTemp, Error, TEXT("DualSense: Failed to create haptics pacer thread for device %d"), DeviceId.GetId());
+		return false;
+	}
+	return true;
+}
+
+void FHapticsPacerThread::Shutdown()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+}
+
+FHapticsPacerStats FHapticsPacerThread::GetStats() const
+{
+	FHapticsPacerStats Stats;
+	Stats.SentPackets = SentPackets.load(std::memory_order_relaxed);
+	Stats.Underruns = Underruns.load(std::memory_order_relaxed);
+	Stats.Overruns = Overruns.load(std::memory_order_relaxed);
+	Stats.TrimmedFrames = TrimmedFrames.load(std::memory_order_relaxed);
+	Stats.RingDroppedFrames = Frames.GetDroppedFrameCount();
+	Stats.TargetDepth = TargetDepth.load(std::memory_order_relaxed);
+	return Stats;
+}
+
+uint32 FHapticsPacerThread::Run()
+{
+	double NextSend = FPlatformTime::Seconds();
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		WaitUntil(NextSend);
+		if (bStopRequested.load(std::memory_order_relaxed))
+		{
+			break;
+		}
+
+		// After a stall, e.g. a blocking Bluetooth write, restart the schedule rather than bursting to catch up.
+		const double Now = FPlatformTime::Seconds();
+		if (Now - NextSend > PacketPeriod * MaxLatePeriods)
+		{
+			NextSend = Now;
+		}
+		NextSend += PacketPeriod;
+
+		SendNext();
+	}
+	return 0;
+}
+
+void FHapticsPacerThread::Stop()
+{
+	bStopRequested.store(true, std::memory_order_relaxed);
+	WakeEvent->Trigger();
+}
+
+void FHapticsPacerThread::WaitUntil(const double Deadline) const
+{
+	for (;;)
+	{
+		const double Remaining = Deadline - FPlatformTime::Seconds();
+		if (Remaining <= 0.0 || bStopRequested.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		// Waits have millisecond granularity; round to the nearest one and send once less than half of
+		// one remains, rather than spinning through the tail on a thread per controller.
+		const uint32 WaitMs = static_cast<uint32>(Remaining * 1000.0 + 0.5);
+		if (WaitMs == 0)
+		{
+			return;
+		}
+		WakeEvent->Wait(WaitMs);
+	}
+}
+
+void FHapticsPacerThread::SendNext()
+{
+	const int32 Target = TargetDepth.load(std::memory_order_relaxed);
+	const int32 Depth = static_cast<int32>(Frames.Num());
+	if (!bPrimed)
+	{
+		if (Depth < Target)
+		{
+			return;
+		}
+		bPrimed = true;
+	}
+
+	if (Depth > Target + OverrunSlack)
+	{
+		Frames.Skip(Depth - Target);
+		Overruns.fetch_add(1, std::memory_order_relaxed);
+		TrimmedFrames.fetch_add(Depth - Target, std::memory_order_relaxed);
+	}
+
+	FHapticFrame Frame;
+	if (!Frames.Pop(Frame))
+	{
+		// Wait for a full buffer again, and keep a deeper one from now on.
+		bPrimed = false;
+		StablePackets = 0;
+		Underruns.fetch_add(1, std::memory_order_relaxed);
+		TargetDepth.store(FMath::Min(Target + 1, MaxTargetDepth), std::memory_order_relaxed);
+		return;
+	}
+
+	// Pinned, so a disconnect on the game thread cannot shut the library down during the write.
+	const FLibrarySlotTable::FPinned Library = FDeviceRegistry::Get()->PinLibraryInstance(DeviceId);
+	if (ISonyGamepadTriggerInterface* Gamepad = Library ? Cast<ISonyGamepadTriggerInterface>(Library.Get()) : nullptr)
+	{
+		Gamepad->AudioHapticUpdate(Frame.Samples);
+		SentPackets.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (++StablePackets >= StablePacketsToShrink)
+	{
+		StablePackets = 0;
+		TargetDepth.store(FMath::Max(Target - 1, MinTargetDepth), std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Threads/InputReaderThread.h"
+#include "Core/Interfaces/PlatformHardwareInfoInterface.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+FInputReaderThread::FInputReaderThread(FDeviceContext* InContext)
+    : Context(InContext)
+    , QueuedReports(QueuedReportCapacity)
+{
+}
+
+FInputReaderThread::~FInputReaderThread()
+{
+	Shutdown();
+}
+
+bool FInputReaderThread::Start()
+{
+	if (Thread || !Context)
+	{
+		return Thread != nullptr;
+	}
+
+	bStopRequested.store(false, std::memory_order_relaxed);
+	bDeviceLost.store(false, std::memory_order_relaxed);
+	Thread = FRunnableThread::Create(this, TEXT("DualSenseInputReader"), 0, TPri_AboveNormal);
+	if (!Thread)
+	{
+		UE_LOG(LogTemp, Error, TEXT("DualSense: Failed to create input reader thread for %s"), *Context->Path);
+		return false;
+	}
+	return true;
+}
+
+void FInputReaderThread::Shutdown()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+}
+
+bool FInputReaderThread::ConsumeLatest()
+{
+	return Reports.Consume();
+}
+
+const FInputReport& FInputReaderThread::GetLatest() const
+{
+	return Reports.GetReadBuffer();
+}
+
+void FInputReaderThread::SetQueueAllReports(const bool bEnable)
+{
+	if (bEnable && !bQueueAllReports.load(std::memory_order_relaxed))
+	{
+		QueuedReports.Empty();
+	}
+	bQueueAllReports.store(bEnable, std::memory_order_release);
+}
+
+bool FInputReaderThread::DequeueReport(FInputReport& OutReport)
+{
+	return QueuedReports.Dequeue(OutReport);
+}
+
+uint32 FInputReaderThread::GetDroppedReportCount() const
+{
+	return DroppedReports.load(std::memory_order_relaxed);
+}
+
+bool FInputReaderThread::IsDeviceLost() const
+{
+	return bDeviceLost.load(std::memory_order_relaxed);
+}
+
+int32 FInputReaderThread::GetInputReportLength(const FDeviceContext& Context)
+{
+	if (Context.ConnectionType == EDeviceConnection::Bluetooth)
+	{
+		return Context.DeviceType == EDeviceType::DualShock4 ? 547 : 78;
+	}
+	return 64;
+}
+
+uint32 FInputReaderThread::Run()
+{
+	const int32 ReportLength = GetInputReportLength(*Context);
+	int32 ConsecutiveTransientErrors = 0;
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		FInputReport& Report = Reports.GetWriteBuffer();
+		const int32 BytesRead = IPlatformHardwareInfoInterface::Get().Read(Context, Report.Data, ReportLength, ReadTimeoutMs);
+		if (BytesRead == IPlatformHardwareInfoInterface::ReadTransientError)
+		{
+			if (++ConsecutiveTransientErrors >= MaxConsecutiveTransientErrors)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DualSense: Input reader gave up on device %s after %d failed reads"), *Context->Path,
+				       ConsecutiveTransientErrors);
+				bDeviceLost.store(true, std::memory_order_relaxed);
+				break;
+			}
+			FPlatformProcess::SleepNoStats(TransientErrorBackoffSeconds);
+			continue;
+		}
+		ConsecutiveTransientErrors = 0;
+
+		if (BytesRead < 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DualSense: Input reader lost device %s"), *Context->Path);
+			bDeviceLost.store(true, std::memory_order_relaxed);
+			break;
+		}
+
+		if (BytesRead == 0)
+		{
+			continue;
+		}
+
+		Report.Length = BytesRead;
+		Report.Timestamp = FPlatformTime::Seconds();
+		if (bQueueAllReports.load(std::memory_order_acquire) && !QueuedReports.Enqueue(Report))
+		{
+			DroppedReports.fetch_add(1, std::memory_order_relaxed);
+		}
+		Reports.Publish();
+	}
+	return 0;
+}
+
+void FInputReaderThread::Stop()
+{
+	bStopRequested.store(true, std::memory_order_relaxed);
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Threads/OutputWriterThread.h"
+#include "Core/Interfaces/PlatformHardwareInfoInterface.h"
+#include "Core/Structs/DeviceContext.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+FOutputWriterThread::FOutputWriterThread(FDeviceContext* InContext)
+    : Context(InContext)
+    , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+{
+}
+
+FOutputWriterThread::~FOutputWriterThread()
+{
+	Shutdown();
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+bool FOutputWriterThread::Start()
+{
+	if (Thread || !Context)
+	{
+		return Thread != nullptr;
+	}
+
+	bStopRequested.store(false, std::memory_order_relaxed);
+	Thread = FRunnableThread::Create(this, TEXT("DualSenseOutputWriter"), 0, TPri_AboveNormal);
+	if (!Thread)
+	{
+		UE_LOG(LogTemp, Error, TEXT("DualSense: Failed to create output writer thread for %s"), *Context->Path);
+		return false;
+	}
+	return true;
+}
+
+void FOutputWriterThread::Shutdown()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+}
+
+void FOutputWriterThread::Publish(const unsigned char* Data, const int32 Length)
+{
+	FOutputReport& Report = Reports.GetWriteBuffer();
+	Report.Length = FMath::Clamp(Length, 0, static_cast<int32>(sizeof(Report.Data)));
+	FMemory::Memcpy(Report.Data, Data, Report.Length);
+	Reports.Publish();
+
+	PublishedReports.fetch_add(1, std::memory_order_relaxed);
+	WakeEvent->Trigger();
+}
+
+uint32 FOutputWriterThread::GetSupersededReportCount() const
+{
+	return PublishedReports.load(std::memory_order_relaxed) - WrittenReports.load(std::memory_order_relaxed);
+}
+
+uint32 FOutputWriterThread::GetSentReportCount() const
+{
+	return SentReports.load(std::memory_order_relaxed);
+}
+
+uint32 FOutputWriterThread::GetFailedWriteCount() const
+{
+	return FailedWrites.load(std::memory_order_relaxed);
+}
+
+int32 FOutputWriterThread::GetOutputReportLength(const FDeviceContext& Context)
+{
+	if (Context.ConnectionType == EDeviceConnection::Bluetooth)
+	{
+		return 78;
+	}
+	return Context.DeviceType == EDeviceType::DualShock4 ? 32 : 74;
+}
+
+uint32 FOutputWriterThread::Run()
+{
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		WakeEvent->Wait(WaitTimeoutMs);
+		WritePending();
+	}
+
+	// Deliver the last state, e.g. the reset sent when a library shuts down.
+	WritePending();
+	return 0;
+}
+
+void FOutputWriterThread::Stop()
+{
+	bStopRequested.store(true, std::memory_order_relaxed);
+	WakeEvent->Trigger();
+}
+
+void FOutputWriterThread::WritePending()
+{
+	if (!Reports.Consume())
+	{
+		return;
+	}
+
+	const FOutputReport& Report = Reports.GetReadBuffer();
+	if (IPlatformHardwareInfoInterface::Get().WriteReport(Context, Report.Data, Report.Length))
+	{
+		SentReports.fetch_add(1, std::memory_order_relaxed);
+	}
+	else
+	{
+		FailedWrites.fetch_add(1, std::memory_order_relaxed);
+	}
+	WrittenReports.fetch_add(1, std::memory_order_relaxed);
+}
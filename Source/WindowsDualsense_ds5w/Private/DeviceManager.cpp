@@ -7,8 +7,25 @@
 #include "Async/TaskGraphInterfaces.h"
 #include "Core/DeviceRegistry.h"
 #include "Core/Interfaces/SonyGamepadTriggerInterface.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/CoreDelegates.h"
 
+static TAutoConsoleVariable<float> CVarInputUpdateInterval(
+    TEXT("ds.InputUpdateInterval"),
+    0.0f,
+    TEXT("Minimum time in seconds between two input updates on the game thread.\n")
+    TEXT("0 decodes the newest report on every tick. Controllers are always sampled at their native report rate\n")
+    TEXT("by their input reader threads, so this only throttles dispatch, never sampling."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarOutputMaxRate(
+    TEXT("ds.OutputMaxRate"),
+    0.0f,
+    TEXT("Maximum number of output reports per second sent to each controller.\n")
+    TEXT("Setters only record the new output state; pending changes are sent as a single report\n")
+    TEXT("once per tick, or at most this often when greater than 0."),
+    ECVF_Default);
+
 DeviceManager::DeviceManager(
     const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler)
     : MessageHandler(InMessageHandler)
@@ -29,39 +46,79 @@ void DeviceManager::Tick(float DeltaTime)
 {
 	FDeviceRegistry::Get()->DetectedChangeConnections(DeltaTime);
 
+	OutputAccumulator += DeltaTime;
+	const float OutputMaxRate = CVarOutputMaxRate.GetValueOnGameThread();
+	if (OutputMaxRate <= 0.0f || OutputAccumulator >= 1.0f / OutputMaxRate)
+	{
+		OutputAccumulator = 0.0f;
+		FDeviceRegistry::Get()->FlushOutputs();
+	}
+
 	PollAccumulator += DeltaTime;
-	if (PollAccumulator < PollInterval)
+	if (PollAccumulator < CVarInputUpdateInterval.GetValueOnGameThread())
 	{
 		return;
 	}
 
+	const float UpdateDelta = PollAccumulator;
 	PollAccumulator = 0.0f;
 
+	const TSharedPtr<FDeviceRegistry> Registry = FDeviceRegistry::Get();
+	if (!bActiveDevicesBuilt || ActiveDevicesVersion != Registry->GetMappingVersion())
+	{
+		RebuildActiveDevices();
+	}
+
+	static const FName InputDeviceName(TEXT("DeviceManager.WindowsDualsense"));
+	for (const FActiveDevice& Device : ActiveDevices)
+	{
+		if (ISonyGamepadInterface* Gamepad = Registry->GetLibraryInstance(Device.DeviceId))
+		{
+			// FInputDeviceScope takes the identifier by value and keeps its own FString, so copying the
+			// cached one is the only allocation left on this path, and it belongs to the engine.
+			FInputDeviceScope InputScope(this, InputDeviceName, Device.DeviceId.GetId(), Device.HardwareIdentifier);
+			Gamepad->UpdateInput(MessageHandler, Device.UserId, Device.DeviceId, UpdateDelta);
+		}
+	}
+}
+
+void DeviceManager::RebuildActiveDevices()
+{
+	const TSharedPtr<FDeviceRegistry> Registry = FDeviceRegistry::Get();
+	ActiveDevicesVersion = Registry->GetMappingVersion();
+	bActiveDevicesBuilt = true;
+	ActiveDevices.Reset();
+
 	TArray<FInputDeviceId> OutInputDevices;
-	OutInputDevices.Reset();
 	IPlatformInputDeviceMapper::Get().GetAllConnectedInputDevices(OutInputDevices);
 	for (const FInputDeviceId& Device : OutInputDevices)
 	{
-		if (ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(Device); Gamepad)
+		ISonyGamepadInterface* Gamepad = Registry->GetLibraryInstance(Device);
+		if (!Gamepad)
+		{
+			continue;
+		}
+
+		const FPlatformUserId UserId = IPlatformInputDeviceMapper::Get().GetUserForInputDevice(Device);
+		if (const int32 ControllerId = FPlatformMisc::GetUserIndexForPlatformUser(UserId); ControllerId == -1)
+		{
+			continue;
+		}
+
+		FActiveDevice& Active = ActiveDevices.AddDefaulted_GetRef();
+		Active.DeviceId = Device;
+		Active.UserId = UserId;
+		switch (Gamepad->GetDeviceType())
 		{
-			const FPlatformUserId UserId = IPlatformInputDeviceMapper::Get().GetUserForInputDevice(Device);
-			if (const int32 ControllerId = FPlatformMisc::GetUserIndexForPlatformUser(UserId); ControllerId == -1)
-			{
-				continue;
-			}
-
-			FString ContextDrive = TEXT("DualSense");
-			if (Gamepad->GetDeviceType() == EDeviceType::DualShock4)
-			{
-				ContextDrive = TEXT("DualShock4");
-			}
-			if (Gamepad->GetDeviceType() == EDeviceType::DualSenseEdge)
-			{
-				ContextDrive = TEXT("DualSenseEdge");
-			}
-
-			FInputDeviceScope InputScope(this, TEXT("DeviceManager.WindowsDualsense"), Device.GetId(), ContextDrive);
-			Gamepad->UpdateInput(MessageHandler, UserId, Device, DeltaTime);
+			case EDeviceType::DualShock4:
+				Active.HardwareIdentifier = TEXT("DualShock4");
+				break;
+			case EDeviceType::DualSenseEdge:
+				Active.HardwareIdentifier = TEXT("DualSenseEdge");
+				break;
+			default:
+				Active.HardwareIdentifier = TEXT("DualSense");
+				break;
 		}
 	}
 }
@@ -189,17 +246,5 @@ void DeviceManager::OnUserLoginChangedEvent(bool bLoggedIn, int32 UserId, int32
 
 FInputDeviceId DeviceManager::GetGamepadInterface(int32 ControllerId)
 {
-	TArray<FInputDeviceId> Devices;
-
-	IPlatformInputDeviceMapper::Get().GetAllInputDevicesForUser(FPlatformUserId::CreateFromInternalId(ControllerId), Devices);
-
-	for (const FInputDeviceId& DeviceId : Devices)
-	{
-		if (FDeviceRegistry::Get()->GetLibraryInstance(DeviceId))
-		{
-			return DeviceId;
-		}
-	}
-
-	return FInputDeviceId::CreateFromInternalId(INDEX_NONE);
+	return FDeviceRegistry::Get()->ResolveControllerDevice(ControllerId);
 }
@@ -53,6 +53,16 @@ void UDualSenseProxy::UnregisterSubmixForDevice(int32 ControllerId)
 	FHapticsRegistry::Get()->RemoveListenerForDevice(DeviceId);
 }
 
+void UDualSenseProxy::SetHapticsGain(int32 ControllerId, float Gain)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
+	FHapticsRegistry::Get()->SetDeviceGain(DeviceId, Gain);
+}
+
 void UDualSenseProxy::LedPlayerEffects(int32 ControllerId, ELedPlayerEnum Value, ELedBrightnessEnum Brightness)
 {
 	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
@@ -1,9 +1,17 @@
 ﻿#include "Helpers/CommandHelpers.h"
+#include "AudioResampler.h"
+#include "Core/Algorithms/Crc32.h"
+#include "Core/Algorithms/HapticDecimator.h"
 #include "Core/DeviceRegistry.h"
+#include "Core/HapticsRegistry.h"
 #include "Core/Interfaces/SonyGamepadInterface.h"
+#include "Core/Platforms/Virtual/VirtualDeviceInfo.h"
 #include "Core/PlayStationOutputComposer.h"
 #include "Core/Structs/DeviceContext.h"
+#include "Core/Threads/OutputWriterThread.h"
 #include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
 
 static FAutoConsoleCommand GCmd_SetAudioByte(
     TEXT("ds.SetAudioByte"),
@@ -50,6 +58,40 @@ static FAutoConsoleCommand GCmd_GallopL(
     TEXT("ds.GallopL <DeviceId> <Start 0-8> <End 1-9> <FirstFoot 0-8> <SecondFoot 1-9> <Freq 0-255>"),
     FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleGallopTrigL));
 
+static FAutoConsoleCommand GCmd_DumpOutputStats(
+    TEXT("ds.DumpOutputStats"),
+    TEXT("ds.DumpOutputStats <DeviceId>"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleDumpOutputStats));
+static FAutoConsoleCommand GCmd_DumpHapticsStats(
+    TEXT("ds.DumpHapticsStats"),
+    TEXT("ds.DumpHapticsStats <DeviceId>"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleDumpHapticsStats));
+static FAutoConsoleCommand GCmd_BenchmarkCrc(
+    TEXT("ds.BenchmarkCrc"),
+    TEXT("ds.BenchmarkCrc [Iterations] - checks every CRC32 implementation against the table reference and times them"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleBenchmarkCrc));
+static FAutoConsoleCommand GCmd_BenchmarkHapticResampler(
+    TEXT("ds.BenchmarkHapticResampler"),
+    TEXT("ds.BenchmarkHapticResampler [SampleRate] [Iterations] - CPU per 1024-frame stereo buffer, decimator vs BestSinc"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleBenchmarkHapticResampler));
+
+static FAutoConsoleCommand GCmd_VirtualPlug(
+    TEXT("ds.Virtual.Plug"),
+    TEXT("ds.Virtual.Plug [DualSense|Edge|DS4] [USB|BT] - plugs a virtual controller (virtual backend only)"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleVirtualPlug));
+static FAutoConsoleCommand GCmd_VirtualUnplug(
+    TEXT("ds.Virtual.Unplug"),
+    TEXT("ds.Virtual.Unplug <Slot>"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleVirtualUnplug));
+static FAutoConsoleCommand GCmd_VirtualHold(
+    TEXT("ds.Virtual.Hold"),
+    TEXT("ds.Virtual.Hold <Slot> [<LX> <LY> <RX> <RY> <L2> <R2> (0-255) [FaceAndHat] [Misc] [Special] (hex)] - holds a fixed input; no values returns to generated input"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleVirtualHold));
+static FAutoConsoleCommand GCmd_VirtualDumpCaptures(
+    TEXT("ds.Virtual.DumpCaptures"),
+    TEXT("ds.Virtual.DumpCaptures <Slot> - capture counters and the last output report of a virtual controller"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&FCommandHelpers::HandleVirtualDumpCaptures));
+
 void FCommandHelpers::Register()
 { /* static commands auto-register */
 }
@@ -587,3 +629,300 @@ void FCommandHelpers::HandleGallopTrigL(const TArray<FString>& Args)
 	UE_LOG(LogTemp, Log, TEXT("Left trigger set to Gallop effect: [%02X %02X %02X %02X %02X]"), Bytes[0], Bytes[1], Bytes[2], Bytes[3], Bytes[4]);
 	FPlayStationOutputComposer::OutputDualSense(Ctx);
 }
+
+void FCommandHelpers::HandleDumpOutputStats(const TArray<FString>& Args)
+{
+	FInputDeviceId DeviceId;
+	if (!ParseDeviceId(Args, DeviceId))
+	{
+		return;
+	}
+	ISonyGamepadInterface* Gamepad = GetGamepad(DeviceId);
+	if (!Gamepad)
+	{
+		return;
+	}
+	const FDeviceContext* Ctx = Gamepad->GetMutableDeviceContext();
+	if (!Ctx)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Device not ready/connected"));
+		return;
+	}
+	const uint32 Sent = Ctx->SentOutputReports + (Ctx->OutputWriter ? Ctx->OutputWriter->GetSentReportCount() : 0);
+	const uint32 Failed = Ctx->OutputWriter ? Ctx->OutputWriter->GetFailedWriteCount() : 0;
+	const uint32 Superseded = Ctx->OutputWriter ? Ctx->OutputWriter->GetSupersededReportCount() : 0;
+	UE_LOG(LogTemp, Log,
+	       TEXT("Output reports: %u sent, %u failed, %u suppressed as unchanged, %u superseded before write"), Sent,
+	       Failed, Ctx->SuppressedOutputReports, Superseded);
+}
+
+void FCommandHelpers::HandleBenchmarkCrc(const TArray<FString>& Args)
+{
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+	struct FImplementation
+	{
+		const TCHAR* Name;
+		uint32 (*Extend)(uint32, const unsigned char*, size_t);
+	};
+	const FImplementation Implementations[] = {
+	    {TEXT("Table"), &FCrc32::ExtendTable},
+	    {TEXT("SlicingBy8"), &FCrc32::ExtendSlicingBy8},
+	    {TEXT("Hardware"), &FCrc32::ExtendHardware},
+	    {TEXT("Dispatched"), &FCrc32::Extend},
+	};
+
+	// Golden vectors: the standard CRC-32 check value, then random reports against the composer's table.
+	int32 Failures = 0;
+	const unsigned char Check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+	for (const FImplementation& Implementation : Implementations)
+	{
+		if (Implementation.Extend(0, Check, sizeof(Check)) != 0xCBF43926)
+		{
+			UE_LOG(LogTemp, Error, TEXT("CRC32 %s: wrong check value"), Implementation.Name);
+			++Failures;
+		}
+	}
+
+	FRandomStream Random(0x5D5);
+	unsigned char Buffer[256];
+	for (int32 Length = 2; Length <= static_cast<int32>(sizeof(Buffer)); ++Length)
+	{
+		for (unsigned char& Byte : Buffer)
+		{
+			Byte = static_cast<unsigned char>(Random.RandHelper(256));
+		}
+		const uint32 Expected = FPlayStationOutputComposer::ComputeReference(Buffer, Length);
+		for (const FImplementation& Implementation : Implementations)
+		{
+			if (Implementation.Extend(FPlayStationOutputComposer::CRCSeed, Buffer, Length) != Expected)
+			{
+				UE_LOG(LogTemp, Error, TEXT("CRC32 %s: mismatch for %d bytes"), Implementation.Name, Length);
+				++Failures;
+			}
+		}
+
+		Buffer[0] = 0x31;
+		Buffer[1] = 0x02;
+		if (FPlayStationOutputComposer::ComputeAfterPrefix(Buffer, Length, FPlayStationOutputComposer::DualSenseOutputPrefixCrc) !=
+		    FPlayStationOutputComposer::ComputeReference(Buffer, Length))
+		{
+			UE_LOG(LogTemp, Error, TEXT("CRC32 prefix: mismatch for %d bytes"), Length);
+			++Failures;
+		}
+	}
+	UE_LOG(LogTemp, Log, TEXT("CRC32 golden vectors: %s, dispatching to %s"), Failures == 0 ? TEXT("passed") : TEXT("FAILED"),
+	       FCrc32::GetImplementationName());
+
+	// Timing over the two report sizes signed on every Bluetooth send.
+	const size_t Lengths[] = {74, 138};
+	for (const size_t Length : Lengths)
+	{
+		for (const FImplementation& Implementation : Implementations)
+		{
+			uint32 Sink = 0;
+			const double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Buffer[0] = static_cast<unsigned char>(Sink);
+				Sink ^= Implementation.Extend(FPlayStationOutputComposer::CRCSeed, Buffer, Length);
+			}
+			const double Nanoseconds = (FPlatformTime::Seconds() - Start) * 1.0e9 / Iterations;
+			UE_LOG(LogTemp, Log, TEXT("CRC32 %-10s %3d bytes: %8.1f ns (%08x)"), Implementation.Name, static_cast<int32>(Length), Nanoseconds, Sink);
+		}
+	}
+}
+
+void FCommandHelpers::HandleBenchmarkHapticResampler(const TArray<FString>& Args)
+{
+	const int32 SampleRate = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 48000;
+	const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+	constexpr int32 HapticRate = 3000;
+	constexpr int32 NumChannels = 2;
+	constexpr int32 NumFrames = 1024;
+
+	TArray<float> Input;
+	Input.SetNumUninitialized(NumFrames * NumChannels);
+	FRandomStream Random(0x5D5);
+	for (float& Sample : Input)
+	{
+		Sample = Random.FRandRange(-1.0f, 1.0f);
+	}
+	TArray<float> Output;
+	Output.SetNumUninitialized((NumFrames * HapticRate / FMath::Max(SampleRate, 1) + 64) * NumChannels);
+	const int32 OutputCapacity = Output.Num() / NumChannels;
+
+	FHapticDecimator Decimator;
+	if (!Decimator.Init(SampleRate, HapticRate, NumChannels, NumFrames))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Haptic decimator does not support %d Hz"), SampleRate);
+		return;
+	}
+	Decimator.SetHighPass(0.2f, 0.3f);
+	int32 DecimatorFrames = 0;
+	double Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		DecimatorFrames = Decimator.Process(Input.GetData(), NumFrames, Output.GetData(), OutputCapacity);
+	}
+	const double DecimatorMicroseconds = (FPlatformTime::Seconds() - Start) * 1.0e6 / Iterations;
+
+	Audio::FResampler Resampler;
+	Resampler.Init(Audio::EResamplingMethod::BestSinc, static_cast<float>(HapticRate) / SampleRate, NumChannels);
+	int32 ResamplerFrames = 0;
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		Resampler.ProcessAudio(Input.GetData(), NumFrames, false, Output.GetData(), OutputCapacity, ResamplerFrames);
+	}
+	const double ResamplerMicroseconds = (FPlatformTime::Seconds() - Start) * 1.0e6 / Iterations;
+
+	UE_LOG(LogTemp, Log, TEXT("Haptic resampling of %d frames at %d Hz: decimator %.2f us (%d frames), BestSinc %.2f us (%d frames)"),
+	       NumFrames, SampleRate, DecimatorMicroseconds, DecimatorFrames, ResamplerMicroseconds, ResamplerFrames);
+}
+
+void FCommandHelpers::HandleDumpHapticsStats(const TArray<FString>& Args)
+{
+	FInputDeviceId DeviceId;
+	if (!ParseDeviceId(Args, DeviceId))
+	{
+		return;
+	}
+	const TSharedPtr<FAudioHapticsListener> Listener = FHapticsRegistry::Get()->GetListenerForDevice(DeviceId);
+	FHapticsPacerStats Stats;
+	if (!Listener.IsValid() || !Listener->GetPacingStats(DeviceId, Stats))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No haptics listener registered for device %d"), DeviceId.GetId());
+		return;
+	}
+	UE_LOG(LogTemp, Log, TEXT("Haptics: %u packets sent, %u underruns, %u overruns (%u frames trimmed), %llu frames overwritten, target depth %d"),
+	       Stats.SentPackets, Stats.Underruns, Stats.Overruns, Stats.TrimmedFrames, Stats.RingDroppedFrames, Stats.TargetDepth);
+}
+
+FVirtualDeviceInfo* FCommandHelpers::GetVirtualBackend()
+{
+	FVirtualDeviceInfo* Backend = FVirtualDeviceInfo::GetActive();
+	if (!Backend)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The virtual controller backend is not active; start with -DualSenseVirtual or ds.Virtual.Enable=1"));
+	}
+	return Backend;
+}
+
+void FCommandHelpers::HandleVirtualPlug(const TArray<FString>& Args)
+{
+	FVirtualDeviceInfo* Backend = GetVirtualBackend();
+	if (!Backend)
+	{
+		return;
+	}
+
+	EDeviceType DeviceType = EDeviceType::DualSense;
+	if (Args.Num() > 0)
+	{
+		if (Args[0].Equals(TEXT("Edge"), ESearchCase::IgnoreCase))
+		{
+			DeviceType = EDeviceType::DualSenseEdge;
+		}
+		else if (Args[0].Equals(TEXT("DS4"), ESearchCase::IgnoreCase))
+		{
+			DeviceType = EDeviceType::DualShock4;
+		}
+	}
+	const EDeviceConnection ConnectionType = Args.Num() > 1 && Args[1].Equals(TEXT("BT"), ESearchCase::IgnoreCase)
+	                                             ? EDeviceConnection::Bluetooth
+	                                             : EDeviceConnection::Usb;
+
+	const int32 Slot = Backend->Plug(DeviceType, ConnectionType);
+	if (Slot == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("All %d virtual controller slots are taken"), FVirtualDeviceInfo::MaxDevices);
+		return;
+	}
+	UE_LOG(LogTemp, Log, TEXT("Plugged virtual controller into slot %d (%d plugged)"), Slot, Backend->Num());
+}
+
+void FCommandHelpers::HandleVirtualUnplug(const TArray<FString>& Args)
+{
+	FVirtualDeviceInfo* Backend = GetVirtualBackend();
+	if (!Backend || Args.Num() < 1)
+	{
+		return;
+	}
+
+	const int32 Slot = FCString::Atoi(*Args[0]);
+	if (!Backend->Unplug(Slot))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No virtual controller in slot %d"), Slot);
+	}
+}
+
+void FCommandHelpers::HandleVirtualHold(const TArray<FString>& Args)
+{
+	FVirtualDeviceInfo* Backend = GetVirtualBackend();
+	if (!Backend || Args.Num() < 1)
+	{
+		return;
+	}
+
+	const int32 Slot = FCString::Atoi(*Args[0]);
+	if (Args.Num() < 7)
+	{
+		Backend->SetScript(Slot, {});
+		return;
+	}
+
+	FVirtualInputFrame Frame;
+	Frame.LeftStickX = ClampByte(FCString::Atoi(*Args[1]));
+	Frame.LeftStickY = ClampByte(FCString::Atoi(*Args[2]));
+	Frame.RightStickX = ClampByte(FCString::Atoi(*Args[3]));
+	Frame.RightStickY = ClampByte(FCString::Atoi(*Args[4]));
+	Frame.LeftTrigger = ClampByte(FCString::Atoi(*Args[5]));
+	Frame.RightTrigger = ClampByte(FCString::Atoi(*Args[6]));
+	if (Args.Num() > 7)
+	{
+		ParseHexByte(Args[7], Frame.FaceAndHat);
+	}
+	if (Args.Num() > 8)
+	{
+		ParseHexByte(Args[8], Frame.Misc);
+	}
+	if (Args.Num() > 9)
+	{
+		ParseHexByte(Args[9], Frame.Special);
+	}
+	Backend->SetScript(Slot, {Frame}, false);
+}
+
+void FCommandHelpers::HandleVirtualDumpCaptures(const TArray<FString>& Args)
+{
+	FVirtualDeviceInfo* Backend = GetVirtualBackend();
+	if (!Backend || Args.Num() < 1)
+	{
+		return;
+	}
+
+	const int32 Slot = FCString::Atoi(*Args[0]);
+	FVirtualCaptureStats Output;
+	FVirtualCaptureStats Audio;
+	if (!Backend->GetCaptureStats(Slot, EVirtualCapture::Output, Output) ||
+	    !Backend->GetCaptureStats(Slot, EVirtualCapture::AudioHaptic, Audio))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No virtual controller in slot %d"), Slot);
+		return;
+	}
+	UE_LOG(LogTemp, Log, TEXT("Virtual %d: %llu input reports, %llu output reports (%llu overwritten), %llu audio haptic reports (%llu overwritten)"),
+	       Slot, Output.InputReports, Output.TotalReports, Output.OverwrittenReports, Audio.TotalReports, Audio.OverwrittenReports);
+
+	TArray<FVirtualCapturedReport> Reports;
+	if (Backend->GetCapturedReports(Slot, EVirtualCapture::Output, Reports) && Reports.Num() > 0)
+	{
+		const FVirtualCapturedReport& Last = Reports.Last();
+		FString Hex;
+		for (int32 i = 0; i < FMath::Min(Last.Length, FVirtualCapturedReport::MaxLength); ++i)
+		{
+			Hex += FString::Printf(TEXT("%02X "), Last.Data[i]);
+		}
+		UE_LOG(LogTemp, Log, TEXT("Last output report (%d bytes): %s"), Last.Length, *Hex);
+	}
+}
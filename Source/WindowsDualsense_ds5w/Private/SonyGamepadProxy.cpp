@@ -165,6 +165,26 @@ bool USonyGamepadProxy::GetMotionSensorCalibrationStatus(int32 ControllerId, flo
 	return false;
 }
 
+bool USonyGamepadProxy::GetGyroBiasEstimate(int32 ControllerId, FVector& Bias, float& Confidence)
+{
+	Bias = FVector::ZeroVector;
+	Confidence = 0.0f;
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return false;
+	}
+
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Gamepad not found"));
+		return false;
+	}
+
+	return Gamepad->GetGyroBiasEstimate(Bias, Confidence);
+}
+
 void USonyGamepadProxy::EnableTouch(int32 ControllerId, bool bEnableTouch)
 {
 	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
@@ -182,7 +202,7 @@ void USonyGamepadProxy::EnableTouch(int32 ControllerId, bool bEnableTouch)
 	Gamepad->EnableTouch(bEnableTouch);
 }
 
-void USonyGamepadProxy::EnableGyroscopeValues(int32 ControllerId, bool bEnableGyroscope)
+void USonyGamepadProxy::EnableSubFrameInput(int32 ControllerId, bool bEnableSubFrameInput)
 {
 	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
 	if (!DeviceId.IsValid())
@@ -195,25 +215,49 @@ void USonyGamepadProxy::EnableGyroscopeValues(int32 ControllerId, bool bEnableGy
 	{
 		return;
 	}
-	Gamepad->EnableMotionSensor(bEnableGyroscope);
+
+	Gamepad->EnableSubFrameInput(bEnableSubFrameInput);
 }
 
-FInputDeviceId USonyGamepadProxy::GetGamepadInterface(int32 ControllerId)
+bool USonyGamepadProxy::GetSubFrameInputEvents(int32 ControllerId, TArray<FSubFrameInputEvent>& OutEvents)
 {
-	// We should never call into IPlatformInputDeviceMapper from non-game thread because it is not thread-safe
-	check(IsInGameThread());
+	OutEvents.Reset();
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return false;
+	}
 
-	TArray<FInputDeviceId> Devices;
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
+	{
+		return false;
+	}
 
-	IPlatformInputDeviceMapper::Get().GetAllInputDevicesForUser(FPlatformUserId::CreateFromInternalId(ControllerId), Devices);
+	OutEvents = Gamepad->GetSubFrameInputEvents();
+	return true;
+}
+
+void USonyGamepadProxy::EnableGyroscopeValues(int32 ControllerId, bool bEnableGyroscope)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
 
-	for (const FInputDeviceId& DeviceId : Devices)
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
 	{
-		if (FDeviceRegistry::Get()->GetLibraryInstance(DeviceId))
-		{
-			return DeviceId;
-		}
+		return;
 	}
+	Gamepad->EnableMotionSensor(bEnableGyroscope);
+}
+
+FInputDeviceId USonyGamepadProxy::GetGamepadInterface(int32 ControllerId)
+{
+	// We should never call into IPlatformInputDeviceMapper from non-game thread because it is not thread-safe
+	check(IsInGameThread());
 
-	return FInputDeviceId::CreateFromInternalId(INDEX_NONE);
+	return FDeviceRegistry::Get()->ResolveControllerDevice(ControllerId);
 }
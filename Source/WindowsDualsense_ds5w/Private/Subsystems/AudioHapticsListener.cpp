@@ -3,33 +3,155 @@
 // Planned Release Year: 2025
 
 #include "../../Public/Subsystems/AudioHapticsListener.h"
-#include "Core/DeviceRegistry.h"
-#include "Core/Interfaces/SonyGamepadTriggerInterface.h"
 #include "Core/Structs/DualSenseFeatureReport.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
 
-FAudioHapticsListener::FAudioHapticsListener(FInputDeviceId InDeviceId, USoundSubmix* InSubmix)
+static TAutoConsoleVariable<int32> CVarHapticsResampler(
+    TEXT("ds.HapticsResampler"),
+    0,
+    TEXT("Resampler turning submix audio into the 3 kHz haptic stream.\n")
+    TEXT("0: polyphase FIR decimator (cheap). 1: Audio::FResampler BestSinc."),
+    ECVF_Default);
+
+FAudioHapticsListener::FAudioHapticsListener(USoundSubmix* InSubmix)
     : Submix(InSubmix)
-    , DeviceId(InDeviceId)
 {
 	ResampledAudioBuffer.SetNumUninitialized(64);
 }
 
+FAudioHapticsListener::~FAudioHapticsListener()
+{
+	RemoveAllDevices();
+}
+
 void FAudioHapticsListener::OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples,
                                               int32 NumChannels, const int32 SampleRate, double AudioClock)
 {
-	if (!ResamplerImpl.IsValid())
+	if (NumChannels <= 0 || NumSamples < NumChannels)
+	{
+		return;
+	}
+
+	const int32 NumInputFrames = NumSamples / NumChannels; // (2048 samples / 2 channels = 1024 frames)
+
+	// (1024 frames * (3000/48000)) = 64 frames, but any count works: the framer carries the remainder over.
+	const int32 OutputFramesWritten = CVarHapticsResampler.GetValueOnAnyThread() == 0
+	                                      ? ResampleWithDecimator(AudioData, NumInputFrames, NumChannels, SampleRate)
+	                                      : ResampleWithBestSinc(AudioData, NumInputFrames, NumChannels, SampleRate);
+
+	AppendToPackets(ResampledAudioBuffer.GetData(), OutputFramesWritten, NumChannels);
+}
+
+void FAudioHapticsListener::AppendToPackets(const float* Frames, const int32 NumFrames, const int32 NumChannels)
+{
+	// Mono submixes drive both actuators with the same signal.
+	const int32 RightOffset = NumChannels > 1 ? 1 : 0;
+	for (int32 i = 0; i < NumFrames; ++i)
+	{
+		const float* Frame = Frames + i * NumChannels;
+		const float LeftSample = Frame[0];
+		const float RightSample = Frame[RightOffset];
+
+		PendingPacket.Samples[PendingSamples++] = static_cast<int8>(FMath::Clamp(FMath::RoundToInt(LeftSample * 127.0f), -128, 127));
+		PendingPacket.Samples[PendingSamples++] = static_cast<int8>(FMath::Clamp(FMath::RoundToInt(RightSample * 127.0f), -128, 127));
+
+		if (PendingSamples == FHapticFrame::Size)
+		{
+			FanOut(PendingPacket);
+			PendingSamples = 0;
+		}
+	}
+}
+
+void FAudioHapticsListener::FanOut(const FHapticFrame& Packet)
+{
+	FanOutEpoch.fetch_add(1, std::memory_order_seq_cst);
+	const FSubscriberSnapshot* Current = PublishedSnapshot.load(std::memory_order_seq_cst);
+	if (!Current)
+	{
+		FanOutEpoch.fetch_add(1, std::memory_order_release);
+		return;
+	}
+
+	for (FSubscriber* Subscriber : Current->Subscribers)
+	{
+		const int32 GainQ8 = Subscriber->GainQ8.load(std::memory_order_relaxed);
+		if (GainQ8 == UnityGain)
+		{
+			Subscriber->Frames.Push(Packet.Samples);
+			continue;
+		}
+
+		FHapticFrame Scaled;
+		for (int32 i = 0; i < FHapticFrame::Size; ++i)
+		{
+			Scaled.Samples[i] = static_cast<int8>(FMath::Clamp((Packet.Samples[i] * GainQ8) >> 8, -128, 127));
+		}
+		Subscriber->Frames.Push(Scaled.Samples);
+	}
+	FanOutEpoch.fetch_add(1, std::memory_order_release);
+}
+
+void FAudioHapticsListener::PublishSnapshot()
+{
+	TUniquePtr<FSubscriberSnapshot> Next;
+	if (Subscribers.Num() > 0)
+	{
+		Next = MakeUnique<FSubscriberSnapshot>();
+		Next->Subscribers.Reserve(Subscribers.Num());
+		for (const TUniquePtr<FSubscriber>& Subscriber : Subscribers)
+		{
+			Next->Subscribers.Add(Subscriber.Get());
+		}
+	}
+	PublishedSnapshot.store(Next.Get(), std::memory_order_seq_cst);
+
+	// A fan-out that started before the store may still walk the previous snapshot; wait for it to finish.
+	// One that starts after the store sees the new snapshot.
+	const uint32 Epoch = FanOutEpoch.load(std::memory_order_seq_cst);
+	if (Epoch & 1)
+	{
+		while (FanOutEpoch.load(std::memory_order_acquire) == Epoch)
+		{
+			FPlatformProcess::YieldThread();
+		}
+	}
+	Snapshot = MoveTemp(Next);
+}
+
+int32 FAudioHapticsListener::ResampleWithDecimator(float* AudioData, const int32 NumInputFrames, const int32 NumChannels, const int32 SampleRate)
+{
+	if (!Decimator.IsInitializedFor(SampleRate, NumChannels))
 	{
-		const float Ratio = 3000.0f / SampleRate;
+		if (!Decimator.Init(SampleRate, HapticSampleRate, NumChannels, NumInputFrames))
+		{
+			return ResampleWithBestSinc(AudioData, NumInputFrames, NumChannels, SampleRate);
+		}
+		Decimator.SetHighPass(HighPassAlpha, HighPassGain);
+	}
+
+	const int32 MaxOutputFrames = Decimator.GetMaxOutputFrames(NumInputFrames);
+	ResampledAudioBuffer.SetNumUninitialized(MaxOutputFrames * NumChannels);
+	return Decimator.Process(AudioData, NumInputFrames, ResampledAudioBuffer.GetData(), MaxOutputFrames);
+}
+
+int32 FAudioHapticsListener::ResampleWithBestSinc(float* AudioData, const int32 NumInputFrames, const int32 NumChannels, const int32 SampleRate)
+{
+	if (!ResamplerImpl.IsValid() || ResamplerSampleRate != SampleRate || ResamplerNumChannels != NumChannels)
+	{
+		ResamplerSampleRate = SampleRate;
+		ResamplerNumChannels = NumChannels;
+		const float Ratio = static_cast<float>(HapticSampleRate) / SampleRate;
 		ResamplerImpl = MakeUnique<Audio::FResampler>();
 		ResamplerImpl->Init(
 		    Audio::EResamplingMethod::BestSinc,
 		    Ratio,
 		    NumChannels);
 	}
-	const int32 NumInputFrames = NumSamples / NumChannels; // (2048 samples / 2 channels = 1024 frames)
 
-	// (1024 frames * (3000/48000)) = 64 frames.
-	const int32 ExpectedOutputFrames = FMath::CeilToInt(static_cast<float>(NumInputFrames) * (3000.0f / SampleRate));
+	const int32 ExpectedOutputFrames = FMath::CeilToInt(static_cast<float>(NumInputFrames) * HapticSampleRate / SampleRate);
 	ResampledAudioBuffer.SetNumUninitialized((ExpectedOutputFrames + 32) * NumChannels);
 
 	int32 OutputFramesWritten = 0;
@@ -41,90 +163,128 @@ void FAudioHapticsListener::OnNewSubmixBuffer(const USoundSubmix* OwningSubmix,
 	    ResampledAudioBuffer.Num() / NumChannels,
 	    OutputFramesWritten);
 
-	if (OutputFramesWritten != 64)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("OutputFramesWritten not 64 bytes! (%d)"), OutputFramesWritten);
-		return;
-	}
-
-	const float alpha = 0.2f;
-	const float one_minus_alpha = 0.5f - alpha;
-
 	float* Data = ResampledAudioBuffer.GetData();
-	const int32 NumFrames = OutputFramesWritten; // Serão 64 frames
-
-	for (int32 i = 0; i < NumFrames; ++i)
+	const int32 RightOffset = NumChannels > 1 ? 1 : 0;
+	for (int32 i = 0; i < OutputFramesWritten; ++i)
 	{
 		const int32 DataIndex = i * NumChannels; // (i * 2)
 
 		const float InLeft = Data[DataIndex];
-		const float InRight = Data[DataIndex + 1];
+		const float InRight = Data[DataIndex + RightOffset];
 
 		// y_lp[n] = (1 - alpha) * x[n] + alpha * y_lp[n-1]
-		LowPassState_Left = one_minus_alpha * InLeft + alpha * LowPassState_Left;
-		LowPassState_Right = one_minus_alpha * InRight + alpha * LowPassState_Right;
+		LowPassState_Left = HighPassGain * InLeft + HighPassAlpha * LowPassState_Left;
+		LowPassState_Right = HighPassGain * InRight + HighPassAlpha * LowPassState_Right;
 
 		// y_hp[n] = x[n] - y_lp[n]
-		const float OutLeft = InLeft - LowPassState_Left;
-		const float OutRight = InRight - LowPassState_Right;
-
-		Data[DataIndex] = OutLeft;
-		Data[DataIndex + 1] = OutRight;
+		Data[DataIndex] = InLeft - LowPassState_Left;
+		Data[DataIndex + RightOffset] = InRight - LowPassState_Right;
 	}
+	return OutputFramesWritten;
+}
 
-	const float* ResampledData = ResampledAudioBuffer.GetData();
-	TArray<int8> Packet1, Packet2;
-	Packet1.SetNumUninitialized(64);
-	Packet2.SetNumUninitialized(64);
+int32 FAudioHapticsListener::ToGainQ8(const float Gain)
+{
+	return FMath::RoundToInt(FMath::Clamp(Gain, 0.0f, MaxGain) * UnityGain);
+}
 
-	for (int32 i = 0; i < 32; ++i)
+void FAudioHapticsListener::AddDevice(const FInputDeviceId InDeviceId, const float Gain)
+{
 	{
-		const int32 DataIndex = i * 2;
+		FScopeLock Lock(&SubscribersLock);
+		for (const TUniquePtr<FSubscriber>& Subscriber : Subscribers)
+		{
+			if (Subscriber->DeviceId == InDeviceId)
+			{
+				Subscriber->GainQ8.store(ToGainQ8(Gain), std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
 
-		const float LeftSample = ResampledData[DataIndex];      // L
-		const float RightSample = ResampledData[DataIndex + 1]; // R
+	// One packet carries FHapticFrame::Size / 2 stereo frames, 10.67 ms at 3 kHz.
+	constexpr double PacketPeriod = (FHapticFrame::Size / 2) / static_cast<double>(HapticSampleRate);
+	TUniquePtr<FSubscriber> Subscriber = MakeUnique<FSubscriber>();
+	Subscriber->DeviceId = InDeviceId;
+	Subscriber->GainQ8.store(ToGainQ8(Gain), std::memory_order_relaxed);
+	Subscriber->Pacer = MakeUnique<FHapticsPacerThread>(InDeviceId, Subscriber->Frames, PacketPeriod);
+	if (!Subscriber->Pacer->Start())
+	{
+		return;
+	}
 
-		const int8 LeftSampleInt8 = static_cast<int8>(FMath::Clamp(FMath::RoundToInt(LeftSample * 127.0f), -128, 127));
-		const int8 RightSampleInt8 = static_cast<int8>(FMath::Clamp(FMath::RoundToInt(RightSample * 127.0f), -128, 127));
+	FScopeLock Lock(&SubscribersLock);
+	Subscribers.Add(MoveTemp(Subscriber));
+	PublishSnapshot();
+}
 
-		Packet1[DataIndex] = LeftSampleInt8;      // L
-		Packet1[DataIndex + 1] = RightSampleInt8; // R
+bool FAudioHapticsListener::RemoveDevice(const FInputDeviceId InDeviceId)
+{
+	TUniquePtr<FSubscriber> Removed;
+	{
+		FScopeLock Lock(&SubscribersLock);
+		const int32 Index = Subscribers.IndexOfByPredicate([&InDeviceId](const TUniquePtr<FSubscriber>& Subscriber)
+		{
+			return Subscriber->DeviceId == InDeviceId;
+		});
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+		Removed = MoveTemp(Subscribers[Index]);
+		Subscribers.RemoveAtSwap(Index);
+		PublishSnapshot();
 	}
 
-	// (Frames 32-63)
-	for (int32 i = 0; i < 32; ++i)
+	Removed->Pacer->Shutdown();
+	return true;
+}
+
+void FAudioHapticsListener::RemoveAllDevices()
+{
+	TArray<TUniquePtr<FSubscriber>> Removed;
 	{
-		// Freame 32 (i + 32) * 2
-		const int32 DataIndex = (i + 32) * 2; // ResampledData (64, 66, 68...)
+		FScopeLock Lock(&SubscribersLock);
+		Removed = MoveTemp(Subscribers);
+		Subscribers.Reset();
+		PublishSnapshot();
+	}
 
-		const float LeftSample = ResampledData[DataIndex];
-		const float RightSample = ResampledData[DataIndex + 1];
+	for (const TUniquePtr<FSubscriber>& Subscriber : Removed)
+	{
+		Subscriber->Pacer->Shutdown();
+	}
+}
 
-		const int8 LeftSampleInt8 = static_cast<int8>(FMath::Clamp(FMath::RoundToInt(LeftSample * 127.0f), -128, 127));
-		const int8 RightSampleInt8 = static_cast<int8>(FMath::Clamp(FMath::RoundToInt(RightSample * 127.0f), -128, 127));
+bool FAudioHapticsListener::HasDevices() const
+{
+	FScopeLock Lock(&SubscribersLock);
+	return Subscribers.Num() > 0;
+}
 
-		// Index *Packet 2* (Packet2)
-		const int32 PacketIndex = i * 2;            // (0, 2, 4...)
-		Packet2[PacketIndex] = LeftSampleInt8;      // L
-		Packet2[PacketIndex + 1] = RightSampleInt8; // R
+void FAudioHapticsListener::SetDeviceGain(const FInputDeviceId InDeviceId, const float Gain)
+{
+	FScopeLock Lock(&SubscribersLock);
+	for (const TUniquePtr<FSubscriber>& Subscriber : Subscribers)
+	{
+		if (Subscriber->DeviceId == InDeviceId)
+		{
+			Subscriber->GainQ8.store(ToGainQ8(Gain), std::memory_order_relaxed);
+			return;
+		}
 	}
-
-	AudioPacketQueue.Enqueue(Packet1);
-	AudioPacketQueue.Enqueue(Packet2);
 }
 
-void FAudioHapticsListener::ConsumeHapticsQueue()
+bool FAudioHapticsListener::GetPacingStats(const FInputDeviceId InDeviceId, FHapticsPacerStats& OutStats) const
 {
-	ISonyGamepadTriggerInterface* DualSenseInterface = Cast<ISonyGamepadTriggerInterface>(
-	    FDeviceRegistry::Get()->GetLibraryInstance(DeviceId));
-	if (DualSenseInterface)
+	FScopeLock Lock(&SubscribersLock);
+	for (const TUniquePtr<FSubscriber>& Subscriber : Subscribers)
 	{
-		TArray<int8> PacketToProcess;
-		while (AudioPacketQueue.Dequeue(PacketToProcess))
+		if (Subscriber->DeviceId == InDeviceId)
 		{
-			DualSenseInterface->AudioHapticUpdate(PacketToProcess);
+			OutStats = Subscriber->Pacer->GetStats();
+			return true;
 		}
-		return;
 	}
-	AudioPacketQueue.Empty();
+	return false;
 }
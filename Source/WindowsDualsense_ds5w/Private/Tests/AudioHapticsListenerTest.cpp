@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Async/Async.h"
+#include "Core/DeviceRegistry.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Subsystems/AudioHapticsListener.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioHapticsListenerSubscriptionTest, "WindowsDualsense.Haptics.AudioHapticsListener.Subscriptions",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAudioHapticsListenerSubscriptionTest::RunTest(const FString& Parameters)
+{
+	// Subscriptions change on this thread while a second thread plays the audio renderer and fans
+	// packets out without pause. FanOut() reads the published snapshot without a lock, so a removed
+	// subscriber must stay alive until the renderer is done with it; run under a sanitizer, this
+	// catches a retirement that is too early.
+	constexpr int32 NumChannels = 2;
+	constexpr int32 NumFrames = 1024;
+	constexpr int32 SampleRate = 48000;
+	constexpr int32 SubscriptionChanges = 64;
+	constexpr double FanOutTimeout = 5.0;
+
+	// The pacers look their device up in the registry, which can only be created on the game thread.
+	FDeviceRegistry::Get();
+
+	FAudioHapticsListener Listener(nullptr);
+	const FInputDeviceId Persistent = FInputDeviceId::CreateFromInternalId(0x7FFF0000);
+	Listener.AddDevice(Persistent);
+
+	std::atomic<bool> bStop{false};
+	std::atomic<uint32> Buffers{0};
+	TFuture<void> Renderer = Async(EAsyncExecution::Thread, [&Listener, &bStop, &Buffers]()
+	{
+		TArray<float> Audio;
+		Audio.SetNumUninitialized(NumFrames * NumChannels);
+		double Phase = 0.0;
+		while (!bStop.load(std::memory_order_relaxed))
+		{
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Phase += 2.0 * PI * 200.0 / SampleRate;
+				Audio[Frame * NumChannels + 0] = static_cast<float>(0.5 * FMath::Sin(Phase));
+				Audio[Frame * NumChannels + 1] = static_cast<float>(0.5 * FMath::Cos(Phase));
+			}
+			Listener.OnNewSubmixBuffer(nullptr, Audio.GetData(), Audio.Num(), NumChannels, SampleRate, 0.0);
+			Buffers.fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+
+	for (int32 Change = 0; Change < SubscriptionChanges; ++Change)
+	{
+		const FInputDeviceId Transient = FInputDeviceId::CreateFromInternalId(0x7FFF0001 + Change % 4);
+		Listener.AddDevice(Transient, 0.5f);
+		Listener.SetDeviceGain(Transient, 2.0f);
+		TestTrue(TEXT("A subscribed device is removed"), Listener.RemoveDevice(Transient));
+	}
+
+	// The renderer runs much faster than real time, so the persistent ring overflows once packets reach it.
+	FHapticsPacerStats Stats;
+	const double Deadline = FPlatformTime::Seconds() + FanOutTimeout;
+	while (FPlatformTime::Seconds() < Deadline)
+	{
+		if (Listener.GetPacingStats(Persistent, Stats) && (Stats.Overruns > 0 || Stats.RingDroppedFrames > 0))
+		{
+			break;
+		}
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	bStop.store(true, std::memory_order_relaxed);
+	Renderer.Wait();
+
+	TestTrue(TEXT("The renderer processed buffers"), Buffers.load(std::memory_order_relaxed) > 0);
+	TestTrue(TEXT("Packets reached the persistent subscriber"), Stats.Overruns > 0 || Stats.RingDroppedFrames > 0);
+	TestFalse(TEXT("A removed device is no longer subscribed"), Listener.RemoveDevice(FInputDeviceId::CreateFromInternalId(0x7FFF0001)));
+	TestTrue(TEXT("The persistent device is still subscribed"), Listener.HasDevices());
+
+	Listener.RemoveAllDevices();
+	TestFalse(TEXT("No device is subscribed after RemoveAllDevices"), Listener.HasDevices());
+	return true;
+}
+
+#endif
@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/DeviceRegistry.h"
+#include "GenericPlatform/GenericPlatformInputDeviceMapper.h"
+#include "Misc/AutomationTest.h"
+#include "VirtualDeviceTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FControllerResolutionTest, "WindowsDualsense.Registry.ResolveControllerDevice",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FControllerResolutionTest::RunTest(const FString& Parameters)
+{
+	using namespace VirtualDeviceTest;
+
+	// The cache is only as good as its invalidation: a controller moved to another user, or removed,
+	// must never be returned for its old controller index.
+	FVirtualDeviceInfo* Backend = GetBackend(*this);
+	if (!Backend)
+	{
+		return true;
+	}
+	const TSharedPtr<FDeviceRegistry> Registry = FDeviceRegistry::Get();
+	IPlatformInputDeviceMapper& Mapper = IPlatformInputDeviceMapper::Get();
+
+	TArray<FPluggedDevice> Devices;
+	if (!TestTrue(TEXT("The virtual controller is connected"),
+	              PlugDevices(*Backend, *Registry, 1, EDeviceType::DualSense, EDeviceConnection::Usb, Devices)))
+	{
+		UnplugDevices(*Backend, *Registry, Devices);
+		return false;
+	}
+
+	const FInputDeviceId DeviceId = Devices[0].DeviceId;
+	const FPlatformUserId OwnerId = Mapper.GetUserForInputDevice(DeviceId);
+	const int32 OwnerIndex = OwnerId.GetInternalId();
+	TestFalse(TEXT("A negative controller index resolves to no device"), Registry->ResolveControllerDevice(-1).IsValid());
+
+	const FInputDeviceId Resolved = Registry->ResolveControllerDevice(OwnerIndex);
+	TestTrue(TEXT("The controller index resolves to a controller of its user"),
+	         Resolved.IsValid() && Mapper.GetUserForInputDevice(Resolved) == OwnerId);
+	const uint32 Version = Registry->GetMappingVersion();
+	TestTrue(TEXT("A cached resolution is returned again"), Registry->ResolveControllerDevice(OwnerIndex) == Resolved);
+	TestTrue(TEXT("Resolving leaves the mapping version alone"), Registry->GetMappingVersion() == Version);
+
+	const FPlatformUserId OtherId = Mapper.AllocateNewUserId();
+	Mapper.Internal_ChangeInputDeviceUserMapping(DeviceId, OtherId, OwnerId);
+	TestTrue(TEXT("A pairing change invalidates the cache"), Registry->GetMappingVersion() != Version);
+	TestTrue(TEXT("The new user resolves to the controller"), Registry->ResolveControllerDevice(OtherId.GetInternalId()) == DeviceId);
+	TestTrue(TEXT("The old user no longer resolves to the controller"), Registry->ResolveControllerDevice(OwnerIndex) != DeviceId);
+	Mapper.Internal_ChangeInputDeviceUserMapping(DeviceId, OwnerId, OtherId);
+	TestTrue(TEXT("The controller resolves for its user again"), Registry->ResolveControllerDevice(OwnerIndex).IsValid());
+
+	const uint32 ConnectedVersion = Registry->GetMappingVersion();
+	TestTrue(TEXT("The virtual controller is removed"), UnplugDevices(*Backend, *Registry, Devices));
+	TestTrue(TEXT("Removing the library invalidates the cache"), Registry->GetMappingVersion() != ConnectedVersion);
+	TestTrue(TEXT("A removed controller is no longer resolved"), Registry->ResolveControllerDevice(OwnerIndex) != DeviceId);
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Algorithms/Crc32.h"
+#include "Core/PlayStationOutputComposer.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// The precomputed report prefixes, checked against zlib's crc32() of the same bytes.
+static_assert(FCrc32::ExtendByte(0, 0xA2) == 0xEADA2D49, "CRC32 of the 0xA2 HID header");
+static_assert(FPlayStationOutputComposer::DualSenseOutputPrefixCrc == 0x0DEE3682, "CRC32 of A2 31 02");
+static_assert(FPlayStationOutputComposer::DualShockOutputPrefixCrc == 0xED00B1BC, "CRC32 of A2 11 C0");
+static_assert(FPlayStationOutputComposer::AudioHapticPrefixCrc == 0xC8CD046D, "CRC32 of A2 32 00");
+
+namespace Crc32Test
+{
+	struct FImplementation
+	{
+		const TCHAR* Name;
+		uint32 (*Extend)(uint32, const unsigned char*, size_t);
+	};
+
+	static const FImplementation Implementations[] = {
+	    {TEXT("Table"), &FCrc32::ExtendTable},
+	    {TEXT("SlicingBy8"), &FCrc32::ExtendSlicingBy8},
+	    {TEXT("Hardware"), &FCrc32::ExtendHardware},
+	    {TEXT("Dispatched"), &FCrc32::Extend},
+	};
+
+	struct FGoldenVector
+	{
+		const char* Message;
+		uint32 Crc;
+	};
+
+	static const FGoldenVector GoldenVectors[] = {
+	    {"", 0x00000000},
+	    {"a", 0xE8B7BE43},
+	    {"abc", 0x352441C2},
+	    {"123456789", 0xCBF43926},
+	    {"The quick brown fox jumps over the lazy dog", 0x414FA339},
+	};
+} // namespace Crc32Test
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCrc32GoldenVectorsTest, "WindowsDualsense.Algorithms.Crc32.GoldenVectors",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCrc32GoldenVectorsTest::RunTest(const FString& Parameters)
+{
+	using namespace Crc32Test;
+
+	auto ExpectCrc = [this](const FString& What, const uint32 Actual, const uint32 Expected)
+	{
+		if (Actual != Expected)
+		{
+			AddError(FString::Printf(TEXT("%s: %08x instead of %08x"), *What, Actual, Expected));
+		}
+	};
+
+	AddInfo(FString::Printf(TEXT("Dispatching to %s"), FCrc32::GetImplementationName()));
+	for (const FImplementation& Implementation : Implementations)
+	{
+		for (const FGoldenVector& Vector : GoldenVectors)
+		{
+			const size_t Len = FCStringAnsi::Strlen(Vector.Message);
+			ExpectCrc(FString::Printf(TEXT("%s CRC32 of \"%hs\""), Implementation.Name, Vector.Message),
+			          Implementation.Extend(0, reinterpret_cast<const unsigned char*>(Vector.Message), Len), Vector.Crc);
+		}
+
+		// 0x00..0xFF exercises every table entry and the 64-byte folding loop of the hardware path.
+		unsigned char AllBytes[256];
+		for (int32 i = 0; i < 256; ++i)
+		{
+			AllBytes[i] = static_cast<unsigned char>(i);
+		}
+		ExpectCrc(FString::Printf(TEXT("%s CRC32 of 0x00..0xFF"), Implementation.Name),
+		          Implementation.Extend(0, AllBytes, sizeof(AllBytes)), 0x29058C73u);
+
+		// The 74 signed bytes of a zeroed DualSense Bluetooth output report, as sent before any effect is set.
+		unsigned char Report[74] = {0x31, 0x02};
+		ExpectCrc(FString::Printf(TEXT("%s CRC32 of an empty DualSense report"), Implementation.Name),
+		          Implementation.Extend(FPlayStationOutputComposer::CRCSeed, Report, sizeof(Report)), 0xF7E7A126u);
+	}
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCrc32MatchesReferenceTest, "WindowsDualsense.Algorithms.Crc32.MatchesReference",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCrc32MatchesReferenceTest::RunTest(const FString& Parameters)
+{
+	using namespace Crc32Test;
+
+	// Every length up to 256 at every alignment within a word, so the head, the 8- and 64-byte
+	// blocks and the tail of each implementation all run against the composer's HashTable.
+	FRandomStream Random(0x5D5);
+	unsigned char Storage[256 + 8];
+	for (unsigned char& Byte : Storage)
+	{
+		Byte = static_cast<unsigned char>(Random.RandHelper(256));
+	}
+
+	int32 Mismatches = 0;
+	for (int32 Offset = 0; Offset < 8; ++Offset)
+	{
+		const unsigned char* Buffer = Storage + Offset;
+		for (int32 Length = 0; Length <= 256; ++Length)
+		{
+			const uint32 Expected = FPlayStationOutputComposer::ComputeReference(Buffer, Length);
+			for (const FImplementation& Implementation : Implementations)
+			{
+				const uint32 Actual = Implementation.Extend(FPlayStationOutputComposer::CRCSeed, Buffer, Length);
+				if (Actual != Expected && Mismatches++ < 16)
+				{
+					AddError(FString::Printf(TEXT("%s: %08x instead of %08x for %d bytes at offset %d"), Implementation.Name,
+					                         Actual, Expected, Length, Offset));
+				}
+			}
+			if (FPlayStationOutputComposer::Compute(Buffer, Length) != Expected && Mismatches++ < 16)
+			{
+				AddError(FString::Printf(TEXT("Compute: mismatch for %d bytes at offset %d"), Length, Offset));
+			}
+		}
+	}
+
+	// Splitting a message anywhere and extending the first CRC must give the CRC of the whole.
+	for (int32 Split = 0; Split <= 138; ++Split)
+	{
+		const uint32 Expected = FCrc32::ExtendTable(0, Storage, 138);
+		for (const FImplementation& Implementation : Implementations)
+		{
+			const uint32 Head = Implementation.Extend(0, Storage, Split);
+			if (Implementation.Extend(Head, Storage + Split, 138 - Split) != Expected && Mismatches++ < 16)
+			{
+				AddError(FString::Printf(TEXT("%s: split at %d does not compose"), Implementation.Name, Split));
+			}
+		}
+	}
+	return Mismatches == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCrc32PrefixTest, "WindowsDualsense.Algorithms.Crc32.Prefix",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCrc32PrefixTest::RunTest(const FString& Parameters)
+{
+	struct FPrefix
+	{
+		const TCHAR* Name;
+		unsigned char Id;
+		unsigned char Tag;
+		uint32 Crc;
+		int32 Length;
+	};
+	const FPrefix Prefixes[] = {
+	    {TEXT("DualSense output"), 0x31, 0x02, FPlayStationOutputComposer::DualSenseOutputPrefixCrc, 74},
+	    {TEXT("DualShock output"), 0x11, 0xC0, FPlayStationOutputComposer::DualShockOutputPrefixCrc, 74},
+	    {TEXT("Audio haptic"), 0x32, 0x00, FPlayStationOutputComposer::AudioHapticPrefixCrc, 138},
+	};
+
+	FRandomStream Random(0xC0DE);
+	unsigned char Buffer[142];
+	for (const FPrefix& Prefix : Prefixes)
+	{
+		for (int32 Run = 0; Run < 32; ++Run)
+		{
+			for (unsigned char& Byte : Buffer)
+			{
+				Byte = static_cast<unsigned char>(Random.RandHelper(256));
+			}
+			Buffer[0] = Prefix.Id;
+			Buffer[1] = Prefix.Tag;
+			const uint32 Actual = FPlayStationOutputComposer::ComputeAfterPrefix(Buffer, Prefix.Length, Prefix.Crc);
+			const uint32 Expected = FPlayStationOutputComposer::ComputeReference(Buffer, Prefix.Length);
+			if (Actual != Expected)
+			{
+				AddError(FString::Printf(TEXT("%s report after the constexpr prefix: %08x instead of %08x"), Prefix.Name,
+				                         Actual, Expected));
+				break;
+			}
+		}
+	}
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,191 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "DeviceManager.h"
+#include "GenericPlatform/GenericApplicationMessageHandler.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/AutomationTest.h"
+#include "VirtualDeviceTestHelpers.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DeviceManagerTest
+{
+	/**
+	 * Allocator placed in front of GMalloc that counts the allocations made by the thread that installed it.
+	 *
+	 * Other threads keep allocating through it while it is installed, and may still be inside it right
+	 * after it was removed, so it forwards everything and is never destroyed before the engine exits.
+	 */
+	class FAllocationCounter final : public FMalloc
+	{
+	public:
+		void Install()
+		{
+			check(GMalloc != this);
+			Inner = GMalloc;
+			OwnerThread = FPlatformTLS::GetCurrentThreadId();
+			Allocations.store(0, std::memory_order_relaxed);
+			GMalloc = this;
+		}
+
+		/**
+		 * @return The allocations counted since Install().
+		 */
+		uint64 Remove()
+		{
+			GMalloc = Inner;
+			return Allocations.load(std::memory_order_relaxed);
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			Inner->Trim(bTrimThreadCaches);
+		}
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("DualSenseAllocationCounter");
+		}
+
+	private:
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == OwnerThread)
+			{
+				Allocations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		FMalloc* Inner = nullptr;
+		uint32 OwnerThread = 0;
+		std::atomic<uint64> Allocations{0};
+	};
+
+	FAllocationCounter& GetAllocationCounter()
+	{
+		static FAllocationCounter* Counter = new FAllocationCounter();
+		return *Counter;
+	}
+} // namespace DeviceManagerTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDeviceManagerTickAllocationTest, "WindowsDualsense.DeviceManager.TickAllocations",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDeviceManagerTickAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace DeviceManagerTest;
+	using namespace VirtualDeviceTest;
+
+	// Once the devices are connected and the active list is built, a tick polls, flushes and dispatches
+	// every controller without allocating. The one exception is the FString FInputDeviceScope keeps
+	// of the hardware identifier, so the expected count is whatever a bare scope costs on this engine.
+	constexpr int32 WarmUpTicks = 16;
+	constexpr int32 MeasuredTicks = 120;
+
+	FVirtualDeviceInfo* Backend = GetBackend(*this);
+	if (!Backend)
+	{
+		return true;
+	}
+	const TSharedPtr<FDeviceRegistry> Registry = FDeviceRegistry::Get();
+
+	// One controller per model and connection the tick handles differently.
+	TArray<FPluggedDevice> Devices;
+	bool bConnected = PlugDevices(*Backend, *Registry, 1, EDeviceType::DualSense, EDeviceConnection::Usb, Devices);
+	bConnected &= PlugDevices(*Backend, *Registry, 1, EDeviceType::DualSense, EDeviceConnection::Bluetooth, Devices);
+	bConnected &= PlugDevices(*Backend, *Registry, 1, EDeviceType::DualSenseEdge, EDeviceConnection::Usb, Devices);
+	bConnected &= PlugDevices(*Backend, *Registry, 1, EDeviceType::DualShock4, EDeviceConnection::Bluetooth, Devices);
+	if (!TestTrue(TEXT("The virtual controllers are connected"), bConnected))
+	{
+		UnplugDevices(*Backend, *Registry, Devices);
+		return false;
+	}
+
+	static const FName InputDeviceName(TEXT("DeviceManager.WindowsDualsense"));
+	const FString Identifier(TEXT("DualSense"));
+	FAllocationCounter& Counter = GetAllocationCounter();
+	Counter.Install();
+	{
+		FInputDeviceScope Scope(nullptr, InputDeviceName, 0, Identifier);
+	}
+	const uint64 ScopeAllocations = Counter.Remove();
+
+	{
+		// The base handler ignores every event, so only the plugin's own work is measured.
+		const TSharedRef<FGenericApplicationMessageHandler> MessageHandler = MakeShared<FGenericApplicationMessageHandler>();
+		DeviceManager Manager(MessageHandler);
+
+		// Builds the active list and the per-axis state of every controller.
+		for (int32 TickIndex = 0; TickIndex < WarmUpTicks; ++TickIndex)
+		{
+			Manager.Tick(TickDelta);
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FPlatformProcess::SleepNoStats(0.002f);
+		}
+
+		const int32 DispatchedDevices = Registry->GetAllocatedDevices();
+		Counter.Install();
+		for (int32 TickIndex = 0; TickIndex < MeasuredTicks; ++TickIndex)
+		{
+			Manager.Tick(TickDelta);
+			FPlatformProcess::SleepNoStats(0.002f);
+		}
+		const uint64 Allocations = Counter.Remove();
+
+		const uint64 Expected = ScopeAllocations * DispatchedDevices * MeasuredTicks;
+		TestTrue(*FString::Printf(TEXT("%d ticks over %d controllers allocated %llu times; the engine's input device scopes account for %llu"),
+		                          MeasuredTicks, DispatchedDevices, Allocations, Expected),
+		         Allocations == Expected);
+	}
+
+	TestTrue(TEXT("The virtual controllers are removed"), UnplugDevices(*Backend, *Registry, Devices));
+	return !HasAnyErrors();
+}
+
+#endif
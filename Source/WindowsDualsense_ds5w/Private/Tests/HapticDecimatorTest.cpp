@@ -0,0 +1,160 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "AudioResampler.h"
+#include "Core/Algorithms/HapticDecimator.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HapticDecimatorTest
+{
+	constexpr int32 HapticRate = 3000;
+	constexpr int32 NumChannels = 2;
+	constexpr int32 BlockFrames = 1024;
+	/**
+	 * Tones on the left channel, inside the 1 kHz passband of the decimator.
+	 */
+	constexpr double PassbandTones[] = {60.0, 250.0, 700.0};
+	constexpr double PassbandAmplitude = 0.25;
+	/**
+	 * Tone on the right channel, above the 1.5 kHz output Nyquist; it would alias to 1 kHz.
+	 */
+	constexpr double StopbandTone = 2000.0;
+	constexpr double StopbandAmplitude = 0.5;
+
+	/**
+	 * Builds Seconds of interleaved stereo test signal at a sample rate.
+	 */
+	TArray<float> MakeInput(const int32 SampleRate, const int32 Seconds)
+	{
+		const int32 NumFrames = Align(SampleRate * Seconds, BlockFrames);
+		TArray<float> Input;
+		Input.SetNumUninitialized(NumFrames * NumChannels);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double Time = static_cast<double>(Frame) / SampleRate;
+			double Left = 0.0;
+			for (const double Tone : PassbandTones)
+			{
+				Left += PassbandAmplitude * FMath::Sin(2.0 * PI * Tone * Time);
+			}
+			Input[Frame * NumChannels + 0] = static_cast<float>(Left);
+			Input[Frame * NumChannels + 1] = static_cast<float>(StopbandAmplitude * FMath::Sin(2.0 * PI * StopbandTone * Time));
+		}
+		return Input;
+	}
+
+	/**
+	 * Amplitude of the Frequency component of one channel over Count output frames, by a single-bin DFT.
+	 * The window is one second long, so every integer frequency completes whole cycles.
+	 */
+	double MeasureAmplitude(const TArray<float>& Output, const int32 Channel, const int32 First, const int32 Count, const double Frequency)
+	{
+		double Real = 0.0;
+		double Imaginary = 0.0;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const double Angle = 2.0 * PI * Frequency * i / HapticRate;
+			const double Sample = Output[(First + i) * NumChannels + Channel];
+			Real += Sample * FMath::Cos(Angle);
+			Imaginary -= Sample * FMath::Sin(Angle);
+		}
+		return 2.0 * FMath::Sqrt(Real * Real + Imaginary * Imaginary) / Count;
+	}
+
+	/**
+	 * RMS of one channel over Count output frames.
+	 */
+	double MeasureRms(const TArray<float>& Output, const int32 Channel, const int32 First, const int32 Count)
+	{
+		double Sum = 0.0;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const double Sample = Output[(First + i) * NumChannels + Channel];
+			Sum += Sample * Sample;
+		}
+		return FMath::Sqrt(Sum / Count);
+	}
+} // namespace HapticDecimatorTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHapticDecimatorMatchesBestSincTest, "WindowsDualsense.Algorithms.HapticDecimator.MatchesBestSinc",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHapticDecimatorMatchesBestSincTest::RunTest(const FString& Parameters)
+{
+	using namespace HapticDecimatorTest;
+
+	// The two filters differ in delay and transition band, so they are compared by what reaches the
+	// actuators: the passband tones must come out at the same level, and neither may let the
+	// stopband tone alias into the output. The first second is skipped to let both settle.
+	constexpr double AmplitudeTolerance = 0.02 * PassbandAmplitude;
+	constexpr double AliasTolerance = 0.01 * StopbandAmplitude;
+	constexpr int32 SettleFrames = HapticRate;
+	constexpr int32 WindowFrames = HapticRate;
+
+	const int32 SampleRates[] = {48000, 44100};
+	for (const int32 SampleRate : SampleRates)
+	{
+		const TArray<float> Input = MakeInput(SampleRate, 3);
+		const int32 NumBlocks = Input.Num() / (BlockFrames * NumChannels);
+		const int32 BlockCapacity = BlockFrames * HapticRate / SampleRate + 64;
+
+		FHapticDecimator Decimator;
+		if (!TestTrue(*FString::Printf(TEXT("Decimator supports %d Hz"), SampleRate),
+		              Decimator.Init(SampleRate, HapticRate, NumChannels, BlockFrames)))
+		{
+			continue;
+		}
+		Audio::FResampler Resampler;
+		Resampler.Init(Audio::EResamplingMethod::BestSinc, static_cast<float>(HapticRate) / SampleRate, NumChannels);
+
+		TArray<float> DecimatorOutput;
+		TArray<float> ResamplerOutput;
+		TArray<float> Block;
+		Block.SetNumUninitialized(BlockCapacity * NumChannels);
+		for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+		{
+			const float* BlockInput = Input.GetData() + BlockIndex * BlockFrames * NumChannels;
+			const int32 DecimatorFrames = Decimator.Process(BlockInput, BlockFrames, Block.GetData(), BlockCapacity);
+			DecimatorOutput.Append(Block.GetData(), DecimatorFrames * NumChannels);
+
+			// FResampler takes a mutable input buffer; copy the block rather than casting the constness away.
+			TArray<float> ResamplerInput(BlockInput, BlockFrames * NumChannels);
+			int32 ResamplerFrames = 0;
+			Resampler.ProcessAudio(ResamplerInput.GetData(), BlockFrames, false, Block.GetData(), BlockCapacity, ResamplerFrames);
+			ResamplerOutput.Append(Block.GetData(), ResamplerFrames * NumChannels);
+		}
+
+		const int32 RequiredFrames = SettleFrames + WindowFrames;
+		if (!TestTrue(*FString::Printf(TEXT("%d Hz: decimator produced %d frames"), SampleRate, DecimatorOutput.Num() / NumChannels),
+		              DecimatorOutput.Num() >= RequiredFrames * NumChannels) ||
+		    !TestTrue(*FString::Printf(TEXT("%d Hz: BestSinc produced %d frames"), SampleRate, ResamplerOutput.Num() / NumChannels),
+		              ResamplerOutput.Num() >= RequiredFrames * NumChannels))
+		{
+			continue;
+		}
+
+		for (const double Tone : PassbandTones)
+		{
+			const double Expected = MeasureAmplitude(ResamplerOutput, 0, SettleFrames, WindowFrames, Tone);
+			const double Actual = MeasureAmplitude(DecimatorOutput, 0, SettleFrames, WindowFrames, Tone);
+			TestNearlyEqual(*FString::Printf(TEXT("%d Hz: %.0f Hz tone level against BestSinc"), SampleRate, Tone), Actual,
+			                Expected, AmplitudeTolerance);
+			TestNearlyEqual(*FString::Printf(TEXT("%d Hz: %.0f Hz tone level"), SampleRate, Tone), Actual,
+			                PassbandAmplitude, AmplitudeTolerance);
+		}
+
+		const double Alias = FMath::Abs(StopbandTone - HapticRate);
+		TestTrue(*FString::Printf(TEXT("%d Hz: stopband tone rejected by the decimator"), SampleRate),
+		         MeasureRms(DecimatorOutput, 1, SettleFrames, WindowFrames) < AliasTolerance &&
+		             MeasureAmplitude(DecimatorOutput, 1, SettleFrames, WindowFrames, Alias) < AliasTolerance);
+		TestTrue(*FString::Printf(TEXT("%d Hz: stopband tone rejected by BestSinc"), SampleRate),
+		         MeasureRms(ResamplerOutput, 1, SettleFrames, WindowFrames) < AliasTolerance &&
+		             MeasureAmplitude(ResamplerOutput, 1, SettleFrames, WindowFrames, Alias) < AliasTolerance);
+	}
+	return !HasAnyErrors();
+}
+
+#endif
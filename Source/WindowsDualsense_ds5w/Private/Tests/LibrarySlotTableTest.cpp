@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Threads/LibrarySlotTable.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLibrarySlotTableRetireTest, "WindowsDualsense.Registry.LibrarySlotTable.Retire",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLibrarySlotTableRetireTest::RunTest(const FString& Parameters)
+{
+	// The table never dereferences the libraries, so distinct addresses are enough to tell them apart.
+	int32 Storage[3];
+	ISonyGamepadInterface* const First = reinterpret_cast<ISonyGamepadInterface*>(&Storage[0]);
+	ISonyGamepadInterface* const Second = reinterpret_cast<ISonyGamepadInterface*>(&Storage[1]);
+	ISonyGamepadInterface* const Third = reinterpret_cast<ISonyGamepadInterface*>(&Storage[2]);
+
+	FLibrarySlotTable Table;
+	const FInputDeviceId Low = FInputDeviceId::CreateFromInternalId(3);
+	const FInputDeviceId High = FInputDeviceId::CreateFromInternalId(5000);
+	TestTrue(TEXT("A low id is stored"), Table.Add(Low, First));
+	TestTrue(TEXT("An id far beyond the first chunk is stored"), Table.Add(High, Second));
+	TestFalse(TEXT("A taken slot is refused"), Table.Add(High, Third));
+	TestFalse(TEXT("An id beyond Capacity is refused"), Table.Add(FInputDeviceId::CreateFromInternalId(FLibrarySlotTable::Capacity), Third));
+	TestEqual(TEXT("Stored libraries"), Table.Num(), 2);
+	TestTrue(TEXT("The high id is found"), Table.Find(High) == Second);
+
+	TArray<FInputDeviceId> Visited;
+	Table.ForEach([&Visited](const FInputDeviceId& DeviceId, ISonyGamepadInterface*) { Visited.Add(DeviceId); });
+	TestTrue(TEXT("ForEach visits both ids in order"), Visited.Num() == 2 && Visited[0] == Low && Visited[1] == High);
+
+	TArray<ISonyGamepadInterface*> Retired;
+	auto Collect = [&Retired](ISonyGamepadInterface* Library) { Retired.Add(Library); };
+
+	// A pin held across the removal, like a pacer in the middle of a Bluetooth write, delays the retirement.
+	{
+		FLibrarySlotTable::FPinned Pinned = Table.Pin(High);
+		TestTrue(TEXT("The library is pinned"), Pinned.Get() == Second);
+		TestTrue(TEXT("Remove returns the library without waiting"), Table.Remove(High) == Second);
+		TestTrue(TEXT("A removed library is no longer found"), Table.Find(High) == nullptr);
+		TestFalse(TEXT("A removed library can no longer be pinned"), static_cast<bool>(Table.Pin(High)));
+
+		Table.CollectRetired(Collect);
+		TestEqual(TEXT("A pinned library is not retired"), Retired.Num(), 0);
+
+		TestTrue(TEXT("The slot can be reused before the old library retired"), Table.Add(High, Third));
+	}
+
+	Table.CollectRetired(Collect);
+	TestTrue(TEXT("The library is retired once unpinned"), Retired.Num() == 1 && Retired[0] == Second);
+	TestTrue(TEXT("The new library in the slot is untouched"), Table.Find(High) == Third);
+
+	Table.Remove(Low);
+	Table.Remove(High);
+	Retired.Reset();
+	Table.FlushRetired(Collect);
+	TestEqual(TEXT("Every removed library is retired"), Retired.Num(), 2);
+	TestEqual(TEXT("The table is empty"), Table.Num(), 0);
+	return true;
+}
+
+#endif
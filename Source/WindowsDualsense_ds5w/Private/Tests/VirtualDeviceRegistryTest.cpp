@@ -0,0 +1,249 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/DeviceRegistry.h"
+#include "Core/Interfaces/SonyGamepadTriggerInterface.h"
+#include "Core/PlayStationOutputComposer.h"
+#include "Core/Threads/HapticFrameRing.h"
+#include "Misc/AutomationTest.h"
+#include "VirtualDeviceTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace VirtualDeviceRegistryTest
+{
+	/**
+	 * Controllers plugged per connection type.
+	 */
+	constexpr int32 DevicesPerConnection = 4;
+	/**
+	 * Length of a Bluetooth DualSense output report before its CRC.
+	 */
+	constexpr int32 BluetoothOutputCrcOffset = 74;
+	/**
+	 * Offset of the CRC in a Bluetooth audio haptic report, and of the haptic payload after its header.
+	 */
+	constexpr int32 AudioHapticCrcOffset = 138;
+	constexpr int32 AudioHapticPayload = 13;
+
+	uint32 ReadCrc(const unsigned char* Data)
+	{
+		return static_cast<uint32>(Data[0]) | static_cast<uint32>(Data[1]) << 8 | static_cast<uint32>(Data[2]) << 16 |
+		       static_cast<uint32>(Data[3]) << 24;
+	}
+
+	/**
+	 * A lightbar colour no two controllers of the test share.
+	 */
+	FColor MakeLightbar(const int32 Index)
+	{
+		return FColor(static_cast<uint8>(0x10 + Index), static_cast<uint8>(0x80 - Index), static_cast<uint8>(0xC0 + Index));
+	}
+
+	/**
+	 * Offset of the lightbar red byte in a DualSense output report: one byte of header over USB, two over Bluetooth.
+	 */
+	int32 GetLightbarOffset(const EDeviceConnection ConnectionType)
+	{
+		return (ConnectionType == EDeviceConnection::Bluetooth ? 2 : 1) + 44;
+	}
+
+	/**
+	 * Whether the newest output report a device captured carries the lightbar colour.
+	 */
+	bool HasLightbar(const FVirtualDeviceInfo& Backend, const int32 Slot, const EDeviceConnection ConnectionType, const FColor Color)
+	{
+		TArray<FVirtualCapturedReport> Reports;
+		if (!Backend.GetCapturedReports(Slot, EVirtualCapture::Output, Reports) || Reports.Num() == 0)
+		{
+			return false;
+		}
+		const unsigned char* Lightbar = Reports.Last().Data + GetLightbarOffset(ConnectionType);
+		return Lightbar[0] == Color.R && Lightbar[1] == Color.G && Lightbar[2] == Color.B;
+	}
+} // namespace VirtualDeviceRegistryTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVirtualDeviceRegistryReportsTest, "WindowsDualsense.Registry.VirtualDevices.Reports",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FVirtualDeviceRegistryReportsTest::RunTest(const FString& Parameters)
+{
+	using namespace VirtualDeviceRegistryTest;
+	using namespace VirtualDeviceTest;
+
+	// Drives several controllers through the registry the way the game thread does, and checks the
+	// bytes that reach each virtual device: every controller gets its own output report with a valid
+	// Bluetooth CRC, unchanged output is not sent again, and audio haptic packets carry their samples.
+	FVirtualDeviceInfo* Backend = GetBackend(*this);
+	if (!Backend)
+	{
+		return true;
+	}
+	const TSharedPtr<FDeviceRegistry> Registry = FDeviceRegistry::Get();
+
+	TArray<FPluggedDevice> Devices;
+	bool bConnected = PlugDevices(*Backend, *Registry, DevicesPerConnection, EDeviceType::DualSense, EDeviceConnection::Usb, Devices);
+	bConnected &= PlugDevices(*Backend, *Registry, DevicesPerConnection, EDeviceType::DualSense, EDeviceConnection::Bluetooth, Devices);
+	if (!TestTrue(*FString::Printf(TEXT("%d virtual controllers are connected"), DevicesPerConnection * 2), bConnected))
+	{
+		UnplugDevices(*Backend, *Registry, Devices);
+		return false;
+	}
+
+	// The reports of the connection handshake are written by the output writers shortly after; let them land first.
+	FPlatformProcess::Sleep(0.2f);
+	TArray<ISonyGamepadInterface*> Libraries;
+	for (const FPluggedDevice& Device : Devices)
+	{
+		Libraries.Add(Registry->GetLibraryInstance(Device.DeviceId));
+		Backend->ClearCaptures(Device.Slot);
+	}
+	auto GetConnection = [](const int32 Index) {
+		return Index < DevicesPerConnection ? EDeviceConnection::Usb : EDeviceConnection::Bluetooth;
+	};
+
+	// Output: one lightbar change per controller, sent by a single flush.
+	for (int32 Index = 0; Index < Devices.Num(); ++Index)
+	{
+		Libraries[Index]->SetLightbar(MakeLightbar(Index));
+	}
+	Registry->FlushOutputs();
+	const bool bDelivered = TickUntil(*Registry, [&]() {
+		for (int32 Index = 0; Index < Devices.Num(); ++Index)
+		{
+			if (!HasLightbar(*Backend, Devices[Index].Slot, GetConnection(Index), MakeLightbar(Index)))
+			{
+				return false;
+			}
+		}
+		return true;
+	});
+	TestTrue(TEXT("Every controller received its lightbar colour"), bDelivered);
+
+	TArray<FVirtualCaptureStats> OutputStats;
+	for (int32 Index = 0; Index < Devices.Num(); ++Index)
+	{
+		const int32 Slot = Devices[Index].Slot;
+		TArray<FVirtualCapturedReport> Reports;
+		Backend->GetCapturedReports(Slot, EVirtualCapture::Output, Reports);
+		FVirtualCaptureStats& Stats = OutputStats.AddDefaulted_GetRef();
+		Backend->GetCaptureStats(Slot, EVirtualCapture::Output, Stats);
+		TestTrue(*FString::Printf(TEXT("Slot %d: one output report for one change, %llu captured"), Slot, Stats.TotalReports),
+		         Stats.TotalReports == 1);
+		if (Reports.Num() == 0)
+		{
+			continue;
+		}
+
+		const FVirtualCapturedReport& Report = Reports.Last();
+		if (GetConnection(Index) == EDeviceConnection::Bluetooth)
+		{
+			TestTrue(*FString::Printf(TEXT("Slot %d: Bluetooth output report header"), Slot),
+			         Report.Length >= BluetoothOutputCrcOffset + 4 && Report.Data[0] == 0x31 && Report.Data[1] == 0x02);
+			TestTrue(*FString::Printf(TEXT("Slot %d: Bluetooth output report CRC"), Slot),
+			         ReadCrc(Report.Data + BluetoothOutputCrcOffset) ==
+			             FPlayStationOutputComposer::Compute(Report.Data, BluetoothOutputCrcOffset));
+		}
+		else
+		{
+			TestTrue(*FString::Printf(TEXT("Slot %d: USB output report id"), Slot), Report.Data[0] == 0x02);
+		}
+	}
+
+	// Setting the same colours again leaves nothing to send.
+	for (int32 Index = 0; Index < Devices.Num(); ++Index)
+	{
+		Libraries[Index]->SetLightbar(MakeLightbar(Index));
+	}
+	Registry->FlushOutputs();
+	FPlatformProcess::Sleep(0.05f);
+	for (int32 Index = 0; Index < Devices.Num(); ++Index)
+	{
+		FVirtualCaptureStats Stats;
+		Backend->GetCaptureStats(Devices[Index].Slot, EVirtualCapture::Output, Stats);
+		TestTrue(*FString::Printf(TEXT("Slot %d: unchanged output is not sent again"), Devices[Index].Slot),
+		         Stats.TotalReports == OutputStats[Index].TotalReports);
+	}
+
+	// Audio haptics: one packet per controller, each with its own samples; only Bluetooth carries them.
+	for (int32 Index = 0; Index < Devices.Num(); ++Index)
+	{
+		int8 Samples[FHapticFrame::Size];
+		for (int32 Sample = 0; Sample < FHapticFrame::Size; ++Sample)
+		{
+			Samples[Sample] = static_cast<int8>(Index * 16 + Sample - 64);
+		}
+		if (ISonyGamepadTriggerInterface* Trigger = Cast<ISonyGamepadTriggerInterface>(Libraries[Index]))
+		{
+			Trigger->AudioHapticUpdate(Samples);
+		}
+
+		const int32 Slot = Devices[Index].Slot;
+		TArray<FVirtualCapturedReport> Reports;
+		Backend->GetCapturedReports(Slot, EVirtualCapture::AudioHaptic, Reports);
+		if (GetConnection(Index) == EDeviceConnection::Usb)
+		{
+			TestEqual(*FString::Printf(TEXT("Slot %d: no audio haptic report over USB"), Slot), Reports.Num(), 0);
+			continue;
+		}
+		if (!TestEqual(*FString::Printf(TEXT("Slot %d: one audio haptic report"), Slot), Reports.Num(), 1))
+		{
+			continue;
+		}
+
+		const FVirtualCapturedReport& Report = Reports[0];
+		TestTrue(*FString::Printf(TEXT("Slot %d: audio haptic report header"), Slot),
+		         Report.Length >= AudioHapticCrcOffset + 4 && Report.Data[0] == 0x32 && Report.Data[11] == 0x92 &&
+		             Report.Data[12] == 0x40);
+		TestTrue(*FString::Printf(TEXT("Slot %d: audio haptic samples"), Slot),
+		         FMemory::Memcmp(Report.Data + AudioHapticPayload, Samples, FHapticFrame::Size) == 0);
+		TestTrue(*FString::Printf(TEXT("Slot %d: audio haptic report CRC"), Slot),
+		         ReadCrc(Report.Data + AudioHapticCrcOffset) == FPlayStationOutputComposer::Compute(Report.Data, AudioHapticCrcOffset));
+	}
+
+	TestTrue(TEXT("The virtual controllers are removed"), UnplugDevices(*Backend, *Registry, Devices));
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVirtualDeviceRegistryCalibrationTest, "WindowsDualsense.Registry.VirtualDevices.CalibrationCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FVirtualDeviceRegistryCalibrationTest::RunTest(const FString& Parameters)
+{
+	using namespace VirtualDeviceTest;
+
+	// The calibration is cached by controller address and survives the disconnect, so plugging the
+	// same controller again only asks for its pairing info, never for the calibration report.
+	FVirtualDeviceInfo* Backend = GetBackend(*this);
+	if (!Backend)
+	{
+		return true;
+	}
+	const TSharedPtr<FDeviceRegistry> Registry = FDeviceRegistry::Get();
+
+	TArray<FPluggedDevice> Devices;
+	if (!TestTrue(TEXT("The virtual controller is connected"),
+	              PlugDevices(*Backend, *Registry, 1, EDeviceType::DualSense, EDeviceConnection::Usb, Devices)))
+	{
+		UnplugDevices(*Backend, *Registry, Devices);
+		return false;
+	}
+	const int32 Slot = Devices[0].Slot;
+	TestTrue(TEXT("The virtual controller is removed"), UnplugDevices(*Backend, *Registry, Devices));
+
+	TArray<FPluggedDevice> Reconnected;
+	const bool bReconnected = PlugDevices(*Backend, *Registry, 1, EDeviceType::DualSense, EDeviceConnection::Usb, Reconnected);
+	if (TestTrue(TEXT("The virtual controller is connected again on the same slot"), bReconnected && Reconnected[0].Slot == Slot))
+	{
+		FVirtualCaptureStats Stats;
+		Backend->GetCaptureStats(Slot, EVirtualCapture::Output, Stats);
+		TestTrue(*FString::Printf(TEXT("The reconnect read the calibration report %llu times"), Stats.CalibrationRequests),
+		         Stats.CalibrationRequests == 0);
+	}
+
+	TestTrue(TEXT("The virtual controller is removed again"), UnplugDevices(*Backend, *Registry, Reconnected));
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,154 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Core/DeviceRegistry.h"
+#include "Core/Platforms/Virtual/VirtualDeviceInfo.h"
+#include "Core/Structs/DeviceContext.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Helpers for automation tests that connect virtual controllers through the device registry.
+ *
+ * The tests run on the game thread and hold it, so they tick the registry themselves and run the
+ * game thread continuations of its detection and connection tasks in between.
+ */
+namespace VirtualDeviceTest
+{
+	/**
+	 * Tick length passed to the registry while waiting for it.
+	 */
+	constexpr float TickDelta = 1.0f / 60.0f;
+	/**
+	 * Seconds to wait for the registry to connect or remove a device; a Bluetooth connection alone takes 100 ms.
+	 */
+	constexpr double Timeout = 5.0;
+
+	/**
+	 * A virtual device plugged by a test, and the input device the registry connected it as.
+	 */
+	struct FPluggedDevice
+	{
+		int32 Slot = INDEX_NONE;
+		FString Path;
+		FInputDeviceId DeviceId = FInputDeviceId::CreateFromInternalId(INDEX_NONE);
+	};
+
+	/**
+	 * Returns the virtual backend, creating the registry first, or null if the editor runs on the
+	 * hardware backend; the test is then skipped with a warning.
+	 */
+	inline FVirtualDeviceInfo* GetBackend(FAutomationTestBase& Test)
+	{
+		FDeviceRegistry::Get();
+		FVirtualDeviceInfo* Backend = FVirtualDeviceInfo::GetActive();
+		if (!Backend)
+		{
+			Test.AddWarning(TEXT("Skipped: the virtual controller backend is not active; run the tests with -DualSenseVirtual=0."));
+		}
+		return Backend;
+	}
+
+	/**
+	 * Ticks the registry and runs its game thread tasks until Condition holds or Timeout passed.
+	 */
+	inline bool TickUntil(FDeviceRegistry& Registry, TFunctionRef<bool()> Condition)
+	{
+		const double Deadline = FPlatformTime::Seconds() + Timeout;
+		while (true)
+		{
+			Registry.DetectedChangeConnections(TickDelta);
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			if (Condition())
+			{
+				return true;
+			}
+			if (FPlatformTime::Seconds() >= Deadline)
+			{
+				return false;
+			}
+			FPlatformProcess::Sleep(0.005f);
+		}
+	}
+
+	/**
+	 * Returns the connected input device the registry created for a path, or an invalid id.
+	 */
+	inline FInputDeviceId FindDevice(FDeviceRegistry& Registry, const FString& Path)
+	{
+		for (const TPair<FInputDeviceId, ISonyGamepadInterface*>& Entry : Registry.GetAllocatedDevicesMap())
+		{
+			const FDeviceContext* Context = Entry.Value->GetMutableDeviceContext();
+			if (Context && Context->Path == Path && Entry.Value->IsConnected())
+			{
+				return Entry.Key;
+			}
+		}
+		return FInputDeviceId::CreateFromInternalId(INDEX_NONE);
+	}
+
+	/**
+	 * Plugs Count virtual devices and waits until the registry connected all of them.
+	 *
+	 * @return False if a slot was missing or a device was not connected in time; the devices plugged so far are in OutDevices.
+	 */
+	inline bool PlugDevices(FVirtualDeviceInfo& Backend, FDeviceRegistry& Registry, const int32 Count, const EDeviceType DeviceType,
+	                        const EDeviceConnection ConnectionType, TArray<FPluggedDevice>& OutDevices)
+	{
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			FPluggedDevice& Device = OutDevices.AddDefaulted_GetRef();
+			Device.Slot = Backend.Plug(DeviceType, ConnectionType);
+			if (Device.Slot == INDEX_NONE)
+			{
+				OutDevices.Pop();
+				return false;
+			}
+			Device.Path = Backend.GetPath(Device.Slot);
+		}
+
+		return TickUntil(Registry, [&Registry, &OutDevices]() {
+			bool bAllConnected = true;
+			for (FPluggedDevice& Device : OutDevices)
+			{
+				Device.DeviceId = FindDevice(Registry, Device.Path);
+				bAllConnected &= Device.DeviceId.IsValid();
+			}
+			return bAllConnected;
+		});
+	}
+
+	/**
+	 * Unplugs the devices and waits until the registry removed them and shut their libraries down.
+	 */
+	inline bool UnplugDevices(FVirtualDeviceInfo& Backend, FDeviceRegistry& Registry, const TArray<FPluggedDevice>& Devices)
+	{
+		for (const FPluggedDevice& Device : Devices)
+		{
+			Backend.Unplug(Device.Slot);
+		}
+
+		const bool bRemoved = TickUntil(Registry, [&Registry, &Devices]() {
+			for (const FPluggedDevice& Device : Devices)
+			{
+				if (Registry.GetAllocatedDevicesMap().Contains(Device.DeviceId))
+				{
+					return false;
+				}
+			}
+			return true;
+		});
+		// Removed libraries are shut down by the tick after their removal.
+		Registry.DetectedChangeConnections(TickDelta);
+		return bRemoved;
+	}
+} // namespace VirtualDeviceTest
+
+#endif
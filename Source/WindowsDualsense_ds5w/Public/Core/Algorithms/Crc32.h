@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) as used to sign Bluetooth reports.
+ *
+ * Every function follows the zlib convention: the running value is a finished CRC, 0 for an empty
+ * message. A CRC computed over a constant prefix can therefore be stored and extended with the
+ * rest of the message later, which is how the output composer skips the fixed report header.
+ */
+class WINDOWSDUALSENSE_DS5W_API FCrc32
+{
+public:
+	/**
+	 * @brief The reflected CRC-32 generator polynomial.
+	 */
+	static constexpr uint32 Polynomial = 0xEDB88320;
+
+	/**
+	 * @brief Extends a CRC by a single byte, bit by bit.
+	 *
+	 * Slow, but usable in constant expressions, e.g. to precompute the CRC of a fixed report prefix.
+	 *
+	 * @param Crc The CRC of the data preceding Byte.
+	 * @param Byte The byte to append.
+	 * @return The CRC including Byte.
+	 */
+	static constexpr uint32 ExtendByte(const uint32 Crc, const unsigned char Byte)
+	{
+		uint32 State = ~Crc ^ Byte;
+		for (int32 Bit = 0; Bit < 8; ++Bit)
+		{
+			State = (State >> 1) ^ (Polynomial & (0u - (State & 1u)));
+		}
+		return ~State;
+	}
+	/**
+	 * @brief Extends a CRC using the fastest implementation supported by the running CPU.
+	 *
+	 * The implementation is selected once, on the first call.
+	 *
+	 * @param Crc The CRC of the data preceding Data, 0 to start a new message.
+	 * @param Data The bytes to append.
+	 * @param Len Number of bytes in Data.
+	 * @return The CRC including Data.
+	 */
+	static uint32 Extend(uint32 Crc, const unsigned char* Data, size_t Len);
+	/**
+	 * @brief Byte-at-a-time table implementation of Extend(). Kept as the portable reference.
+	 */
+	static uint32 ExtendTable(uint32 Crc, const unsigned char* Data, size_t Len);
+	/**
+	 * @brief Slicing-by-8 implementation of Extend(), consuming eight bytes per step with eight tables.
+	 */
+	static uint32 ExtendSlicingBy8(uint32 Crc, const unsigned char* Data, size_t Len);
+	/**
+	 * @brief Hardware implementation of Extend(): PCLMULQDQ folding on x86, the CRC32 instructions on ARMv8.
+	 *
+	 * Falls back to ExtendSlicingBy8() when HasHardwareSupport() is false.
+	 */
+	static uint32 ExtendHardware(uint32 Crc, const unsigned char* Data, size_t Len);
+	/**
+	 * @brief Indicates whether ExtendHardware() runs on dedicated instructions on this CPU.
+	 */
+	static bool HasHardwareSupport();
+	/**
+	 * @brief Returns a short name of the implementation Extend() dispatches to, for logging.
+	 */
+	static const TCHAR* GetImplementationName();
+};
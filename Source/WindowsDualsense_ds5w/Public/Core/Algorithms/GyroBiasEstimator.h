@@ -0,0 +1,104 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Continuously estimates the gyroscope zero-rate offset while the controller rests.
+ *
+ * Samples are grouped into short windows. For each window the estimator keeps Welford running
+ * statistics of every gyro axis and of the accelerometer magnitude. When a window shows both
+ * sensors quiet and the mean rotation is small, the controller is considered stationary and the
+ * window's gyro mean is blended into the bias. Thermal drift over a long session is therefore
+ * tracked without a dedicated calibration step.
+ *
+ * All values are in the raw sensor units the samples are provided in.
+ */
+class FGyroBiasEstimator
+{
+public:
+	/**
+	 * @param InGyroNoiseThreshold Maximum gyro standard deviation, per axis, for a window to count as stationary.
+	 * @param InAccelNoiseThreshold Maximum standard deviation of the accelerometer magnitude for a stationary window.
+	 * @param InMaxStationaryRate Maximum mean gyro magnitude for a stationary window; rejects slow steady rotations.
+	 * @param InWindowSeconds Length of one analysis window.
+	 */
+	FGyroBiasEstimator(float InGyroNoiseThreshold, float InAccelNoiseThreshold, float InMaxStationaryRate,
+	                   float InWindowSeconds = 0.5f);
+
+	/**
+	 * @brief Adds one motion sample.
+	 *
+	 * @param Gyro Raw gyroscope sample, before any bias is removed.
+	 * @param Accel Raw accelerometer sample.
+	 * @param DeltaSeconds Time elapsed since the previous sample. Zero restarts the current window.
+	 */
+	void AddSample(const FVector& Gyro, const FVector& Accel, float DeltaSeconds);
+	/**
+	 * @brief Replaces the estimate, e.g. with the result of an explicit calibration.
+	 *
+	 * @param InBias The bias to use.
+	 * @param InConfidence Confidence in the bias, 0 to 1.
+	 */
+	void SetBias(const FVector& InBias, float InConfidence);
+	/**
+	 * @brief Discards the estimate and all partial statistics.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Indicates whether at least one stationary window has produced an estimate.
+	 */
+	bool HasEstimate() const { return bHasEstimate; }
+	/**
+	 * @brief Returns the current per-axis bias.
+	 */
+	const FVector& GetBias() const { return Bias; }
+	/**
+	 * @brief Returns the confidence in the current bias, from 0 (none) to 1.
+	 *
+	 * Grows with every stationary window and slowly decays while the controller is in motion,
+	 * since the offset may drift in the meantime.
+	 */
+	float GetConfidence() const { return Confidence; }
+
+private:
+	/**
+	 * @brief Welford running mean and variance of a single value.
+	 */
+	struct FRunningStats
+	{
+		int32 Count = 0;
+		double Mean = 0.0;
+		double M2 = 0.0;
+
+		void Add(const double Value)
+		{
+			++Count;
+			const double Delta = Value - Mean;
+			Mean += Delta / Count;
+			M2 += Delta * (Value - Mean);
+		}
+
+		double GetVariance() const { return Count > 1 ? M2 / (Count - 1) : 0.0; }
+	};
+
+	void ResetWindow();
+	void CloseWindow();
+
+	float GyroNoiseThreshold;
+	float AccelNoiseThreshold;
+	float MaxStationaryRate;
+	float WindowSeconds;
+
+	FRunningStats GyroStats[3];
+	FRunningStats AccelMagnitudeStats;
+	float WindowElapsed = 0.0f;
+
+	FVector Bias = FVector::ZeroVector;
+	float Confidence = 0.0f;
+	bool bHasEstimate = false;
+};
@@ -0,0 +1,111 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Rational polyphase FIR decimator that turns mixer audio into the 3 kHz stream fed to the haptic actuators.
+ *
+ * The conversion ratio is reduced to Interpolation / Decimation, e.g. 1/16 from 48 kHz or 10/147
+ * from 44.1 kHz, and a Kaiser-windowed sinc low-pass is split into one sub-filter per phase, so
+ * every output sample costs a single dot product per channel. The dot products run on SSE or NEON.
+ * An optional one-pole high-pass is applied to the output in the same pass.
+ *
+ * All buffers are allocated by Init(); Process() never allocates.
+ */
+class FHapticDecimator
+{
+public:
+	/**
+	 * @brief Designs the filter and allocates the history for a stream format.
+	 *
+	 * @param InInputRate Sample rate of the input, in Hz.
+	 * @param InOutputRate Sample rate of the output, in Hz. Must not be above the input rate.
+	 * @param InNumChannels Number of interleaved channels, the same for input and output.
+	 * @param InMaxInputFrames Largest block Process() handles in one pass; larger inputs are split.
+	 * @return False if the format is not supported, e.g. an upsampling ratio or a ratio too irregular to split into phases.
+	 */
+	bool Init(int32 InInputRate, int32 InOutputRate, int32 InNumChannels, int32 InMaxInputFrames);
+	/**
+	 * @brief Enables the fused high-pass: Low = Gain * x + Alpha * Low, y = x - Low, per channel.
+	 */
+	void SetHighPass(float InAlpha, float InGain);
+	/**
+	 * @brief Clears the sample history and filter states, keeping the design.
+	 */
+	void Reset();
+	/**
+	 * @brief Indicates whether the decimator was initialized for the given input format.
+	 */
+	bool IsInitializedFor(const int32 InInputRate, const int32 InNumChannels) const
+	{
+		return InputRate == InInputRate && NumChannels == InNumChannels;
+	}
+	/**
+	 * @brief Returns an upper bound of the output frames Process() produces for an input block.
+	 */
+	int32 GetMaxOutputFrames(const int32 NumInputFrames) const
+	{
+		return static_cast<int32>((static_cast<int64>(NumInputFrames) * Interpolation) / Decimation) + 1;
+	}
+	/**
+	 * @brief Consumes a block of interleaved input frames and writes the output frames that became available.
+	 *
+	 * @param Input Interleaved input samples.
+	 * @param NumInputFrames Number of frames in Input.
+	 * @param Output Receives interleaved output samples.
+	 * @param MaxOutputFrames Capacity of Output in frames; see GetMaxOutputFrames(). Frames beyond it are dropped.
+	 * @return The number of frames written to Output.
+	 */
+	int32 Process(const float* Input, int32 NumInputFrames, float* Output, int32 MaxOutputFrames);
+
+private:
+	/**
+	 * @brief Stopband attenuation of the anti-aliasing filter. The output is quantized to 8 bits, so 60 dB is plenty.
+	 */
+	static constexpr float StopbandAttenuationDb = 60.0f;
+	/**
+	 * @brief Largest phase count accepted; keeps the coefficient table small for odd rates.
+	 */
+	static constexpr int32 MaxInterpolation = 64;
+
+	int32 InputRate = 0;
+	int32 NumChannels = 0;
+	int32 Interpolation = 1;
+	int32 Decimation = 1;
+	/**
+	 * @brief Taps per phase, a multiple of 8 so the kernels need no remainder loop.
+	 */
+	int32 TapsPerPhase = 0;
+	int32 MaxInputFrames = 0;
+	/**
+	 * @brief Samples per channel the history can hold: TapsPerPhase - 1 past samples plus one input block.
+	 */
+	int32 HistoryCapacity = 0;
+	/**
+	 * @brief Number of valid samples per channel in History.
+	 */
+	int32 HistoryCount = 0;
+	/**
+	 * @brief Position of the next output in the history, in units of 1 / Interpolation input samples.
+	 */
+	int64 Position = 0;
+	/**
+	 * @brief Phase sub-filters, TapsPerPhase each, stored in reverse so they line up with the history.
+	 */
+	TArray<float> Coefficients;
+	/**
+	 * @brief Deinterleaved input history, one HistoryCapacity block per channel.
+	 */
+	TArray<float> History;
+	/**
+	 * @brief Low-pass state of the fused high-pass, per channel.
+	 */
+	TArray<float> HighPassState;
+	bool bHighPass = false;
+	float HighPassAlpha = 0.0f;
+	float HighPassGain = 0.0f;
+};
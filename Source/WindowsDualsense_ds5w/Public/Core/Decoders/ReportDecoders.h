@@ -0,0 +1,184 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "Core/Enums/EDeviceCommons.h"
+#include "Core/Enums/EDeviceConnection.h"
+#include "Core/Structs/GamepadButtonState.h"
+#include "Core/Structs/GamepadInputState.h"
+#include "CoreMinimal.h"
+
+/**
+ * @brief Byte offsets of the DualSense input report, counted from the report id.
+ *
+ * USB reports start the payload right after the report id; Bluetooth reports carry an extra
+ * sequence byte first. The Edge shares the layout and adds the function and paddle buttons.
+ *
+ * @tparam InPadding Number of bytes preceding the payload.
+ * @tparam bInEdge True for the DualSense Edge.
+ */
+template<int32 InPadding, bool bInEdge>
+struct TDualSenseReportLayout
+{
+	static constexpr int32 LeftStickX = InPadding + 0x00;
+	static constexpr int32 LeftStickY = InPadding + 0x01;
+	static constexpr int32 RightStickX = InPadding + 0x02;
+	static constexpr int32 RightStickY = InPadding + 0x03;
+	static constexpr int32 LeftTrigger = InPadding + 0x04;
+	static constexpr int32 RightTrigger = InPadding + 0x05;
+	static constexpr int32 FaceAndHat = InPadding + 0x07;
+	static constexpr int32 Misc = InPadding + 0x08;
+	static constexpr int32 Special = InPadding + 0x09;
+	static constexpr int32 Gyro = InPadding + 0x0F;
+	static constexpr int32 Accel = InPadding + 0x15;
+	static constexpr int32 SensorTimestamp = InPadding + 0x1B;
+	static constexpr int32 Touch = InPadding + 0x20;
+	static constexpr int32 Status = InPadding + 0x34;
+
+	static constexpr bool bHasSpecialButtons = true;
+	static constexpr uint8 SpecialButtonsMask = bInEdge
+	                                                ? 0xFF
+	                                                : (BTN_PLAYSTATION_LOGO | BTN_PAD_BUTTON | BTN_MIC_BUTTON);
+	static constexpr bool bHasMotion = true;
+	static constexpr bool bHasTouch = true;
+	static constexpr bool bHasStatus = true;
+};
+
+/**
+ * @brief Byte offsets of the DualShock 4 input report, counted from the report id.
+ *
+ * Over Bluetooth the payload is preceded by two extra header bytes.
+ *
+ * @tparam InPadding Number of bytes preceding the payload.
+ */
+template<int32 InPadding>
+struct TDualShockReportLayout
+{
+	static constexpr int32 LeftStickX = InPadding + 0x00;
+	static constexpr int32 LeftStickY = InPadding + 0x01;
+	static constexpr int32 RightStickX = InPadding + 0x02;
+	static constexpr int32 RightStickY = InPadding + 0x03;
+	static constexpr int32 FaceAndHat = InPadding + 0x04;
+	static constexpr int32 Misc = InPadding + 0x05;
+	static constexpr int32 LeftTrigger = InPadding + 0x07;
+	static constexpr int32 RightTrigger = InPadding + 0x08;
+
+	static constexpr bool bHasSpecialButtons = false;
+	static constexpr bool bHasMotion = false;
+	static constexpr bool bHasTouch = false;
+	static constexpr bool bHasStatus = false;
+};
+
+using FDualSenseUsbLayout = TDualSenseReportLayout<1, false>;
+using FDualSenseBluetoothLayout = TDualSenseReportLayout<2, false>;
+using FDualSenseEdgeUsbLayout = TDualSenseReportLayout<1, true>;
+using FDualSenseEdgeBluetoothLayout = TDualSenseReportLayout<2, true>;
+using FDualShockUsbLayout = TDualShockReportLayout<1>;
+using FDualShockBluetoothLayout = TDualShockReportLayout<3>;
+
+/**
+ * @brief Decodes a raw input report into an FGamepadInputState using a fixed layout.
+ *
+ * Every offset is a compile-time constant and optional sections are removed at compile time,
+ * so each instantiation is straight-line code with no transport or device checks.
+ *
+ * @tparam Layout One of the report layout tables above.
+ * @param Report Raw report bytes, starting at the report id.
+ * @param OutState Receives the decoded state.
+ */
+template<typename Layout>
+void DecodeInputReport(const unsigned char* Report, FGamepadInputState& OutState)
+{
+	using namespace EGamepadButton;
+
+	const uint8 FaceAndHat = Report[Layout::FaceAndHat];
+	const uint8 Misc = Report[Layout::Misc];
+
+	uint64 Buttons = HatToDPad[FaceAndHat & 0x0F];
+	Buttons |= (FaceAndHat & BTN_CROSS) ? Bit(FaceButtonBottom) : 0;
+	Buttons |= (FaceAndHat & BTN_SQUARE) ? Bit(FaceButtonLeft) : 0;
+	Buttons |= (FaceAndHat & BTN_CIRCLE) ? Bit(FaceButtonRight) : 0;
+	Buttons |= (FaceAndHat & BTN_TRIANGLE) ? Bit(FaceButtonTop) : 0;
+
+	// Shoulders and triggers
+	Buttons |= (Misc & BTN_LEFT_SHOLDER) ? Bit(LeftShoulder) : 0;
+	Buttons |= (Misc & BTN_RIGHT_SHOLDER) ? Bit(RightShoulder) : 0;
+	Buttons |= (Misc & BTN_LEFT_TRIGGER) ? Bit(LeftTriggerThreshold) : 0;
+	Buttons |= (Misc & BTN_RIGHT_TRIGGER) ? Bit(RightTriggerThreshold) : 0;
+
+	// Push Stick, also mapped to the unreal native gamepad thumb buttons
+	Buttons |= (Misc & BTN_LEFT_STICK) ? Bit(PushLeftStick) | Bit(LeftThumb) : 0;
+	Buttons |= (Misc & BTN_RIGHT_STICK) ? Bit(PushRightStick) | Bit(RightThumb) : 0;
+
+	// Start and Select, also mapped to the unreal native gamepad special buttons
+	Buttons |= (Misc & BTN_START) ? Bit(Menu) | Bit(SpecialRight) : 0;
+	Buttons |= (Misc & BTN_SELECT) ? Bit(Share) | Bit(SpecialLeft) : 0;
+
+	if constexpr (Layout::bHasSpecialButtons)
+	{
+		const uint8 Special = Report[Layout::Special] & Layout::SpecialButtonsMask;
+		Buttons |= (Special & BTN_PLAYSTATION_LOGO) ? Bit(PlayStation) : 0;
+		Buttons |= (Special & BTN_PAD_BUTTON) ? Bit(TouchPad) : 0;
+		Buttons |= (Special & BTN_MIC_BUTTON) ? Bit(Mic) : 0;
+		Buttons |= (Special & BTN_FN1) ? Bit(FunctionL) : 0;
+		Buttons |= (Special & BTN_FN2) ? Bit(FunctionR) : 0;
+		Buttons |= (Special & BTN_PADDLE_LEFT) ? Bit(PaddleL) : 0;
+		Buttons |= (Special & BTN_PADDLE_RIGHT) ? Bit(PaddleR) : 0;
+	}
+	OutState.Buttons = Buttons;
+
+	OutState.LeftStickX = Report[Layout::LeftStickX];
+	OutState.LeftStickY = Report[Layout::LeftStickY];
+	OutState.RightStickX = Report[Layout::RightStickX];
+	OutState.RightStickY = Report[Layout::RightStickY];
+	OutState.LeftTrigger = Report[Layout::LeftTrigger];
+	OutState.RightTrigger = Report[Layout::RightTrigger];
+
+	if constexpr (Layout::bHasMotion)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			OutState.Gyro[Axis] = static_cast<int16>(Report[Layout::Gyro + Axis * 2] | (Report[Layout::Gyro + Axis * 2 + 1] << 8));
+			OutState.Accel[Axis] = static_cast<int16>(Report[Layout::Accel + Axis * 2] | (Report[Layout::Accel + Axis * 2 + 1] << 8));
+		}
+		OutState.SensorTimestamp = static_cast<uint32>(Report[Layout::SensorTimestamp]) |
+		                           (static_cast<uint32>(Report[Layout::SensorTimestamp + 1]) << 8) |
+		                           (static_cast<uint32>(Report[Layout::SensorTimestamp + 2]) << 16) |
+		                           (static_cast<uint32>(Report[Layout::SensorTimestamp + 3]) << 24);
+	}
+
+	if constexpr (Layout::bHasTouch)
+	{
+		FMemory::Memcpy(OutState.TouchPoints, &Report[Layout::Touch], sizeof(OutState.TouchPoints));
+	}
+
+	if constexpr (Layout::bHasStatus)
+	{
+		OutState.BatteryStatus = Report[Layout::Status];
+		OutState.PeripheralStatus = Report[Layout::Status + 1];
+		OutState.ChargingStatus = Report[Layout::Status + 2];
+	}
+}
+
+/**
+ * @brief Signature shared by every DecodeInputReport instantiation.
+ */
+using FReportDecodeFunction = void (*)(const unsigned char* Report, FGamepadInputState& OutState);
+
+/**
+ * @brief Picks the report decoder for a device type and connection.
+ */
+class FReportDecoders
+{
+public:
+	/**
+	 * @brief Returns the decoder matching the device, chosen once when the library is initialized.
+	 *
+	 * @param DeviceType The controller model.
+	 * @param ConnectionType The transport the controller is connected through.
+	 * @return The decoder instantiation, or nullptr if the combination is not supported.
+	 */
+	static FReportDecodeFunction Select(EDeviceType DeviceType, EDeviceConnection ConnectionType);
+};
@@ -12,7 +12,9 @@
 #endif
 
 #include "Async/TaskGraphInterfaces.h"
+#include "Core/Threads/LibrarySlotTable.h"
 #include "Interfaces/SonyGamepadInterface.h"
+#include <atomic>
 
 /**
  * A manager class that handles the creation, storage, and lifecycle management of device library
@@ -54,19 +56,40 @@ public:
 	 *                     the library instance is to be retrieved.
 	 * @return A pointer to the ISonyGamepadInterface instance corresponding to the specified
 	 *         controller ID, or nullptr if no matching instance exists.
+	 *
+	 * @note The lookup is a single load and safe from any thread, but the pointer is only guaranteed to
+	 *       stay valid on the game thread, which removes libraries. Other threads use PinLibraryInstance().
 	 */
 	ISonyGamepadInterface* GetLibraryInstance(const FInputDeviceId& DeviceId);
+	/**
+	 * Retrieves the library instance of a connected controller from any thread, pinned so it is not
+	 * shut down until the returned handle goes out of scope. Hold it only for the duration of a call.
+	 *
+	 * @param DeviceId The unique identifier of the controller.
+	 * @return The pinned library, empty if no connected controller uses that identifier.
+	 */
+	FLibrarySlotTable::FPinned PinLibraryInstance(const FInputDeviceId& DeviceId);
 	/**
 	 * Retrieves the map of allocated device library instances. This map associates unique integer
 	 * keys with instances implementing the Sony gamepad interface, allowing access to the currently
 	 * managed devices.
+	 *
+	 * The map is built on each call; it is a snapshot meant for tooling, not for per-frame lookups.
 	 */
 	TMap<FInputDeviceId, ISonyGamepadInterface*> GetAllocatedDevicesMap();
+	/**
+	 * Sends the pending output changes of every connected controller. Each library writes at most
+	 * one report, and only if one of its setters changed the output state since the last flush.
+	 */
+	void FlushOutputs();
 	/**
 	 * Removes a library instance associated with the specified controller ID, disconnecting the
 	 * corresponding input device if it is currently connected. Ensures proper removal and cleanup
 	 * of the library instance from the internal container.
 	 *
+	 * Never waits for other threads: the library is shut down by a later DetectedChangeConnections()
+	 * once no pacer or other thread has it pinned anymore.
+	 *
 	 * @param GamepadId The unique identifier of the controller whose library instance is to be removed.
 	 */
 	void RemoveLibraryInstance(const FInputDeviceId& GamepadId);
@@ -76,22 +99,132 @@ public:
 	 * or DualShock4. This method ensures proper mapping of device paths, unique IDs, and initialization
 	 * of associated input devices.
 	 *
+	 * The connection is staged so the game thread never waits on the device: the library object and
+	 * its input device ID are created here, the handles are opened and the library initialized on a
+	 * worker, and FinishLibraryInstance() registers the device on the game thread once it is ready.
+	 *
 	 * @param Context The device context containing the type of controller, its path,
 	 *                and information required for initialization and identification.
 	 */
 	void CreateLibraryInstance(FDeviceContext& Context);
 	/**
-	 * Updates the device container manager at regular intervals by processing connected and
-	 * disconnected devices. It handles device discovery, connection state updates, lifecycle
-	 * management for device libraries, and ensures proper synchronization with previously
-	 * known devices.
+	 * Updates the device container manager by processing connected and disconnected devices.
+	 * It handles device discovery, connection state updates, lifecycle management for device
+	 * libraries, and ensures proper synchronization with previously known devices.
+	 *
+	 * When the platform delivers hotplug notifications, the enumeration only runs after a device
+	 * arrived or left; otherwise, or to retry a device that could not be opened, it runs every
+	 * PollingInterval seconds.
 	 *
 	 * @param DeltaTime The time in seconds since the last tick, used to accumulate time for
 	 *                  periodic processing of the device lifecycle and connection state.
 	 */
 	void DetectedChangeConnections(float DeltaTime);
+	/**
+	 * Resolves a controller index, the internal id of a platform user, to the input device of the
+	 * connected Sony controller mapped to that user.
+	 *
+	 * Results are cached per controller index and only recomputed after the device mapper reports a
+	 * connection or pairing change, a user logs in or out, or a library is added or removed, so the
+	 * common case is an array index plus a slot lookup confirming the device is still connected.
+	 *
+	 * @param ControllerId The controller index used by the Blueprint proxies and the input device interface.
+	 * @return The device, or an invalid id if no connected controller is mapped to that user.
+	 */
+	FInputDeviceId ResolveControllerDevice(int32 ControllerId);
+	/**
+	 * Returns a counter that changes whenever a library is added or removed, or the device mapper
+	 * reports a connection, pairing or login change. Caches derived from the device mapping compare
+	 * it to know when to rebuild.
+	 */
+	uint32 GetMappingVersion() const
+	{
+		return MappingVersion;
+	}
 
 private:
+	/**
+	 * Seconds between two enumerations when they are polled rather than triggered by notifications.
+	 */
+	static constexpr float PollingInterval = 2.0f;
+	/**
+	 * Shuts down the removed libraries no other thread has pinned anymore.
+	 *
+	 * @param bWait Whether to wait for every removed library, when the registry is being destroyed.
+	 */
+	void ShutdownRetiredLibraries(bool bWait);
+	/**
+	 * Registers for hotplug notifications of the platform, if it supports them.
+	 */
+	void StartHotplugNotifications();
+	/**
+	 * Subscribes to the device mapper and login events that invalidate ResolvedControllers.
+	 */
+	void BindMappingEvents();
+	/**
+	 * Unsubscribes from the events bound by BindMappingEvents().
+	 */
+	void UnbindMappingEvents();
+	/**
+	 * Marks every cached controller resolution as stale.
+	 */
+	void InvalidateControllerResolution()
+	{
+		++MappingVersion;
+	}
+	/**
+	 * Cached result of ResolveControllerDevice() for one controller index.
+	 */
+	struct FControllerResolution
+	{
+		FInputDeviceId DeviceId;
+		bool bResolved = false;
+	};
+	/**
+	 * Resolutions indexed by controller index, valid while ResolvedVersion equals MappingVersion.
+	 */
+	TArray<FControllerResolution> ResolvedControllers;
+	uint32 MappingVersion = 0;
+	uint32 ResolvedVersion = 0;
+	/**
+	 * Scratch list for the device mapper query of a cache miss, kept to avoid an allocation per miss.
+	 */
+	TArray<FInputDeviceId> ResolveScratch;
+	FDelegateHandle ConnectionChangeHandle;
+	FDelegateHandle PairingChangeHandle;
+	FDelegateHandle UserLoginChangeHandle;
+	/**
+	 * Last, game thread stage of CreateLibraryInstance(): makes an initialized library reachable and maps
+	 * its device to a user, or releases it if the worker could not open or initialize the device.
+	 *
+	 * @param SonyGamepad The library created for the device.
+	 * @param Path The device path the library was created for.
+	 * @param DeviceId The input device ID assigned to the device.
+	 * @param bReady Whether the worker stage succeeded.
+	 */
+	void FinishLibraryInstance(ISonyGamepadInterface* SonyGamepad, const FString& Path, const FInputDeviceId& DeviceId, bool bReady);
+	/**
+	 * Paths of devices whose connection is still running on a worker, so a detection meanwhile does not connect them twice.
+	 */
+	TSet<FString> PendingDevicePaths;
+	/**
+	 * Pending paths a detection no longer found, so their connection is torn down instead of registered once it finishes.
+	 */
+	TSet<FString> VanishedPendingPaths;
+	/**
+	 * Set by the hotplug callback, from any thread, when a device arrived or left; starts out set so
+	 * the first tick enumerates the devices already connected.
+	 */
+	std::atomic<bool> bDetectionRequested{true};
+	/**
+	 * Whether the platform delivers hotplug notifications, making periodic enumeration unnecessary.
+	 */
+	bool bHotplugActive = false;
+	/**
+	 * Set when the last enumeration found a controller it could not open yet, or could not even identify
+	 * one of the interfaces, e.g. right after its arrival notification; polling resumes until it succeeds.
+	 */
+	bool bRetryDetection = false;
 	/**
 	 * A floating-point variable that represents the change or difference in the accumulator value over time.
 	 * Typically used to measure incremental adjustments or deltas in processing or calculations.
@@ -110,11 +243,11 @@ private:
 	 */
 	static TSharedPtr<FDeviceRegistry> Instance;
 	/**
-	 * A static map that holds associations between input device IDs and their corresponding Sony gamepad interface instances.
-	 * This map is used to store and manage the lifecycle of gamepad interface objects, enabling efficient lookup and access
-	 * to the respective implementations for handling Sony gamepad interactions.
+	 * A static table that holds associations between input device IDs and their corresponding Sony gamepad interface instances.
+	 * It is indexed directly by device id, so lookups are a single atomic load from any thread, and it retires a removed
+	 * library only once no other thread has it pinned.
 	 */
-	static TMap<FInputDeviceId, ISonyGamepadInterface*> LibraryInstances;
+	static FLibrarySlotTable LibraryInstances;
 	/**
 	 * A static map that associates device paths represented as strings with unique input device
 	 * identifiers. This serves as a lookup mechanism to manage and track known device connections
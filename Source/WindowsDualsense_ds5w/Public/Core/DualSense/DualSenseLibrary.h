@@ -6,11 +6,18 @@
 
 #include "Async/TaskGraphInterfaces.h"
 #include "Containers/Queue.h"
+#include "Core/Algorithms/GyroBiasEstimator.h"
+#include "Core/Algorithms/MadgwickAhrs.h"
 #include "Core/Enums/EDeviceCommons.h"
+#include "Core/Decoders/ReportDecoders.h"
 #include "Core/Interfaces/SonyGamepadInterface.h"
 #include "Core/Interfaces/SonyGamepadTriggerInterface.h"
 #include "Core/Structs/DeviceContext.h"
 #include "Core/Structs/DualSenseFeatureReport.h"
+#include "Core/Structs/GamepadButtonState.h"
+#include "Core/Structs/ImuCalibration.h"
+#include "Core/Threads/InputReaderThread.h"
+#include "Core/Threads/OutputWriterThread.h"
 #include "CoreMinimal.h"
 #include "InputCoreTypes.h"
 #include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
@@ -245,7 +252,14 @@ struct FGyro
 	int16_t Z;
 };
 
-USTRUCT()
+/**
+ * @brief Min/max spread of each motion axis, formerly tracked during an explicit calibration.
+ *
+ * @deprecated No longer filled: motion samples are corrected with the factory calibration read from
+ *             the controller (FImuCalibration). Kept for one release so existing code still compiles;
+ *             it will be removed in the next one.
+ */
+USTRUCT(meta = (DeprecationMessage = "FSensorBounds is no longer filled; the factory calibration (FImuCalibration) replaces it."))
 struct FSensorBounds
 {
 	GENERATED_BODY()
@@ -372,20 +386,38 @@ public:
 	 */
 	virtual void SendOut() override;
 	/**
-	 * @brief Handles button input events for a DualSense controller.
+	 * @brief Sends the pending output changes, if any, as one report.
+	 */
+	virtual void FlushOutput() override;
+	/**
+	 * @brief Dispatches the digital button state contained in a single input report.
 	 *
-	 * This function checks the current state of a button on a DualSense controller and triggers
-	 * appropriate input events (button press or release) based on the change in its state.
+	 * Extracted from UpdateInput so that queued reports can be replayed one by one when
+	 * sub-frame input is enabled; each call only emits edges relative to the previous report.
+	 * ButtonState dispatches only the buttons whose bit changed.
 	 *
 	 * @param InMessageHandler The message handler responsible for dispatching input events.
 	 * @param UserId The platform user ID associated with the controller.
 	 * @param InputDeviceId The unique identifier for the DualSense input device.
-	 * @param ButtonName The name of the button being checked.
-	 * @param IsButtonPressed A boolean indicating the current pressed state of the button (true if pressed, false otherwise).
+	 * @param Buttons Digital button mask of the decoded report.
+	 */
+	void DispatchButtons(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+	                     const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+	                     const uint64 Buttons);
+	/**
+	 * @brief Feeds one decoded motion sample into calibration and the orientation filter.
+	 *
+	 * Called for every report received since the previous update. The integration step is taken
+	 * from the controller's own sensor timestamp, so it matches the real sampling interval
+	 * regardless of how often the game polls.
+	 *
+	 * @param State The decoded report carrying the sample.
 	 */
-	virtual void CheckButtonInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
-	                              const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
-	                              const FName ButtonName, const bool IsButtonPressed);
+	void ProcessMotionSample(const FGamepadInputState& State);
+	/**
+	 * @brief Computes the baselines of an explicit calibration and hands the gyro offset to BiasEstimator.
+	 */
+	void FinishMotionSensorCalibration();
 	/**
 	 * @brief Updates the input state for a DualSense device.
 	 *
@@ -666,6 +698,23 @@ public:
 	 *                 Set to true to enable touch or false to disable it.
 	 */
 	virtual void EnableTouch(const bool bIsTouch) override;
+	/**
+	 * @brief Enables or disables sub-frame input processing for the DualSense controller.
+	 *
+	 * When enabled, the input reader queues every report it receives and UpdateInput replays
+	 * all of them, so presses shorter than a frame are still dispatched and recorded in
+	 * SubFrameInputEvents with their arrival time.
+	 *
+	 * @param bEnable True to process every report, false to only decode the newest one.
+	 */
+	virtual void EnableSubFrameInput(const bool bEnable) override;
+	/**
+	 * @brief Returns the button edges decoded during the last UpdateInput call, in arrival order.
+	 */
+	virtual const TArray<FSubFrameInputEvent>& GetSubFrameInputEvents() const override
+	{
+		return SubFrameInputEvents;
+	}
 	/**
 	 * @brief Enables or disables the motion sensor feature of the DualSense controller.
 	 *
@@ -700,6 +749,14 @@ public:
 	 * @return True if the calibration status was successfully retrieved, false otherwise.
 	 */
 	virtual bool GetMotionSensorCalibrationStatus(float& OutProgress) override;
+	/**
+	 * @brief Retrieves the gyroscope offset estimated while the controller rests.
+	 *
+	 * @param OutBias Receives the per-axis bias in degrees per second.
+	 * @param OutConfidence Receives the confidence in the estimate, from 0 to 1.
+	 * @return True once a stationary period has produced an estimate.
+	 */
+	virtual bool GetGyroBiasEstimate(FVector& OutBias, float& OutConfidence) const override;
 	/**
 	 * @brief Updates the haptic feedback system of the DualSense controller with audio data.
 	 *
@@ -707,8 +764,8 @@ public:
 	 * It handles encoding and transmitting audio data to produce haptic vibration effects
 	 * on the controller hardware.
 	 *
-	 * @param Data A byte array containing the audio haptic data to be transmitted.
-	 * The method processes up to a maximum of 64 bytes of this data.
+	 * @param Data A view of the audio haptic data to be transmitted.
+	 * The method processes up to a maximum of 64 bytes of this data; shorter data is padded with silence.
 	 *
 	 * @details This function interacts with the device context to check if the controller is connected,
 	 * processes the provided audio data into the appropriate format, and forwards it to the
@@ -718,7 +775,7 @@ public:
 	 * This functionality is typically implemented in systems that aim to provide immersive
 	 * feedback during audio playback or gaming scenarios that utilize DualSense controllers.
 	 */
-	virtual void AudioHapticUpdate(TArray<int8> Data) override;
+	virtual void AudioHapticUpdate(TConstArrayView<int8> Data) override;
 	/**
 	 * @brief Resets the gyro orientation to its default alignment.
 	 *
@@ -737,20 +794,14 @@ public:
 	 */
 	virtual FDeviceContext* GetMutableDeviceContext() override { return &HIDDeviceContexts; }
 	/**
-	 * A map representing the states of various buttons on a controller.
-	 *
-	 * Each key in the map is a button name (FName), and its associated value is a boolean
-	 * indicating whether the button is currently pressed (`true`) or not pressed (`false`).
+	 * Packed state of every button on the controller, one bit per EGamepadButton::Type.
 	 *
-	 * This variable is primarily used for tracking button input states and ensuring
-	 * accurate representation of input events, such as detecting when a button's state
-	 * changes from pressed to released or vice versa.
-	 *
-	 * The map is updated dynamically during controller runtime, including in functions
-	 * like CheckButtonInput, which ensures real-time synchronization of input states.
+	 * Digital buttons are replaced as a whole for every decoded report, while the stick
+	 * direction buttons are updated per axis from the analog values. Only bits that differ
+	 * from the previous state produce pressed/released events.
 	 * It is reset during library shutdown to clear all stored button states.
 	 */
-	TMap<const FName, bool> ButtonStates;
+	FGamepadButtonState ButtonState;
 
 	TMap<const FName, float> AnalogStates;
 
@@ -938,6 +989,51 @@ private:
 	 * recalibration is required due to drift or unexpected behavior.
 	 */
 	bool bIsResetGyroscope = false;
+	/**
+	 * @brief Orientation filter fed with this controller's motion samples.
+	 *
+	 * Owned per device so that several connected controllers integrate independent
+	 * orientations, and resetting one controller leaves the others untouched. The filter
+	 * keeps its own sample rate estimate and beta.
+	 */
+	FMadgwickAhrs MotionFilter = FMadgwickAhrs(200.0f, 0.08f);
+	/**
+	 * @brief Whether MotionFilter has been seeded with a sample rate since the library was initialized.
+	 */
+	bool bMotionFilterInitialized = false;
+	/**
+	 * @brief Factory calibration of this controller's motion sensors, loaded when the library is initialized.
+	 */
+	FImuCalibration ImuCalibration;
+	/**
+	 * @brief Online gyroscope offset estimator, in calibrated counts.
+	 *
+	 * Thresholds for the DualSense scale (1024 counts per deg/s, 8192 counts per g): a window is
+	 * stationary when each gyro axis varies less than 0.3 deg/s, the acceleration magnitude less
+	 * than 0.01 g, and the mean rotation stays under 1 deg/s over a one second window, so a slow,
+	 * steady aim is not mistaken for drift.
+	 */
+	FGyroBiasEstimator BiasEstimator = FGyroBiasEstimator(0.3f * 1024.0f, 0.01f * 8192.0f, 1.0f * 1024.0f, 1.0f);
+	/**
+	 * @brief Hardware sensor timestamp of the last integrated motion sample.
+	 */
+	uint32 LastSensorTimestamp = 0;
+	/**
+	 * @brief Whether LastSensorTimestamp holds a sample, so the next one can compute its delta.
+	 */
+	bool bHasSensorTimestamp = false;
+	/**
+	 * @brief Calibrated gyroscope counts of the last integrated sample, after baseline and dead zone, in OnMotionDetected axis order.
+	 */
+	FVector MotionGyroscope = FVector::ZeroVector;
+	/**
+	 * @brief Calibrated accelerometer counts of the last integrated sample, after baseline and dead zone, in OnMotionDetected axis order.
+	 */
+	FVector MotionAccelerometer = FVector::ZeroVector;
+	/**
+	 * @brief Acceleration of the last integrated sample in m/s^2, used to derive the gravity vector.
+	 */
+	FVector MotionAccelMS2 = FVector::ZeroVector;
 	/**
 	 * @brief Indicates the presence of a motion sensor baseline calibration.
 	 *
@@ -1070,6 +1166,51 @@ private:
 	 * initialization, input handling, and managing device-specific settings.
 	 */
 	FDeviceContext HIDDeviceContexts;
+	/**
+	 * @brief Set when the output context changed since the last report was sent.
+	 *
+	 * Setters only update the output context and raise this flag; FlushOutput composes and writes
+	 * one report for all of them.
+	 */
+	bool bOutputDirty = false;
+	/**
+	 * @brief Schedules an output report for the next FlushOutput.
+	 */
+	void MarkOutputDirty() { bOutputDirty = true; }
+	/**
+	 * @brief Dedicated thread that reads input reports for this device.
+	 *
+	 * Started in InitializeLibrary and joined in ShutdownLibrary before the device handles are
+	 * released. UpdateInput only consumes the newest complete report published by this thread.
+	 */
+	TUniquePtr<FInputReaderThread> InputReader;
+	/**
+	 * @brief Dedicated thread that writes output reports for this device.
+	 *
+	 * Started first in InitializeLibrary and registered in HIDDeviceContexts, so every composed
+	 * report is sent from this thread and the game thread never blocks on HID writes.
+	 */
+	TUniquePtr<FOutputWriterThread> OutputWriter;
+	/**
+	 * @brief Decoder for the report layout of this device and connection, selected in InitializeLibrary.
+	 */
+	FReportDecodeFunction ReportDecoder = nullptr;
+	/**
+	 * @brief State decoded from the newest input report.
+	 */
+	FGamepadInputState InputState;
+	/**
+	 * @brief Whether UpdateInput replays every queued report instead of only the newest one.
+	 */
+	bool bEnableSubFrameInput = false;
+	/**
+	 * @brief Arrival time of the report currently being decoded, stamped on recorded sub-frame events.
+	 */
+	double CurrentReportTimestamp = 0.0;
+	/**
+	 * @brief Button edges decoded during the last UpdateInput call when sub-frame input is enabled.
+	 */
+	TArray<FSubFrameInputEvent> SubFrameInputEvents;
 	/**
 	 * @variable GyroBaseline
 	 * @brief Represents the baseline gyroscope values for calibration or adjustment.
@@ -1114,19 +1255,4 @@ private:
 	 * and avoidance of issues like gimbal lock, making it ideal for 3D rotational data.
 	 */
 	FQuat FusedOrientation;
-	/**
-	 * @class FSensorBounds
-	 * @brief Represents the boundaries or limits of a sensor's detectable range.
-	 *
-	 * The FSensorBounds class is utilized to define and handle the spatial or operational
-	 * limits of a sensor within a system. This can include constraints such as minimum and
-	 * maximum values that the sensor can register or operate within, which are essential for
-	 * validating and processing sensor data.
-	 *
-	 * @details This class can be especially useful in applications where sensors are required
-	 * to operate within strict parameters, ensuring data integrity and preventing erroneous
-	 * readings. By defining these bounds, it assists in managing sensor interactions and maintaining
-	 * proper system functionality.
-	 */
-	FSensorBounds Bounds;
 };
@@ -5,8 +5,12 @@
 #pragma once
 
 #include "Async/TaskGraphInterfaces.h"
+#include "Core/Decoders/ReportDecoders.h"
 #include "Core/Interfaces/SonyGamepadInterface.h"
 #include "Core/Structs/DualShockFeatureReport.h"
+#include "Core/Structs/GamepadButtonState.h"
+#include "Core/Threads/InputReaderThread.h"
+#include "Core/Threads/OutputWriterThread.h"
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
 #include "DualShockLibrary.generated.h"
@@ -87,20 +91,24 @@ public:
 	 */
 	virtual void SendOut() override;
 	/**
-	 * @brief Handles button input events for a DualSense controller.
+	 * @brief Sends the pending output changes, if any, as one report.
+	 */
+	virtual void FlushOutput() override;
+	/**
+	 * @brief Dispatches the digital button state contained in a single input report.
 	 *
-	 * This function checks the current state of a button on a DualSense controller and triggers
-	 * appropriate input events (button press or release) based on the change in its state.
+	 * Extracted from UpdateInput so that queued reports can be replayed one by one when
+	 * sub-frame input is enabled; each call only emits edges relative to the previous report.
+	 * ButtonState dispatches only the buttons whose bit changed.
 	 *
 	 * @param InMessageHandler The message handler responsible for dispatching input events.
 	 * @param UserId The platform user ID associated with the controller.
-	 * @param InputDeviceId The unique identifier for the DualSense input device.
-	 * @param ButtonName The name of the button being checked.
-	 * @param IsButtonPressed A boolean indicating the current pressed state of the button (true if pressed, false otherwise).
+	 * @param InputDeviceId The unique identifier for the DualShock 4 input device.
+	 * @param Buttons Digital button mask of the decoded report.
 	 */
-	virtual void CheckButtonInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
-	                              const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
-	                              const FName ButtonName, const bool IsButtonPressed);
+	void DispatchButtons(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+	                     const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+	                     const uint64 Buttons);
 	/**
 	 * @brief Updates the input state for a DualSense device.
 	 *
@@ -189,6 +197,23 @@ public:
 	 * @param bIsTouch A boolean indicating whether touch input is enabled (true) or disabled (false).
 	 */
 	virtual void EnableTouch(const bool bIsTouch) override;
+	/**
+	 * @brief Enables or disables sub-frame input processing for the DualShock 4 controller.
+	 *
+	 * When enabled, the input reader queues every report it receives and UpdateInput replays
+	 * all of them, so presses shorter than a frame are still dispatched and recorded in
+	 * SubFrameInputEvents with their arrival time.
+	 *
+	 * @param bEnable True to process every report, false to only decode the newest one.
+	 */
+	virtual void EnableSubFrameInput(const bool bEnable) override;
+	/**
+	 * @brief Returns the button edges decoded during the last UpdateInput call, in arrival order.
+	 */
+	virtual const TArray<FSubFrameInputEvent>& GetSubFrameInputEvents() const override
+	{
+		return SubFrameInputEvents;
+	}
 	/**
 	 * Enables the motion sensor functionality of the gamepad.
 	 *
@@ -215,6 +240,19 @@ public:
 	 * @return True if the calibration status was successfully retrieved, false otherwise.
 	 */
 	virtual bool GetMotionSensorCalibrationStatus(float& OutProgress) override { return false; }
+	/**
+	 * Retrieves the gyroscope offset estimated while the controller rests.
+	 *
+	 * @param OutBias Receives the per-axis bias in degrees per second.
+	 * @param OutConfidence Receives the confidence in the estimate, from 0 to 1.
+	 * @return True once an estimate is available; motion is not decoded for DualShock 4, so always false.
+	 */
+	virtual bool GetGyroBiasEstimate(FVector& OutBias, float& OutConfidence) const override
+	{
+		OutBias = FVector::ZeroVector;
+		OutConfidence = 0.0f;
+		return false;
+	}
 	/**
 	 * @brief Resets the gyro orientation to its default alignment.
 	 *
@@ -233,20 +271,14 @@ public:
 	 */
 	int32 ControllerID;
 	/**
-	 * A map representing the states of various buttons on a controller.
+	 * Packed state of every button on the controller, one bit per EGamepadButton::Type.
 	 *
-	 * Each key in the map is a button name (FName), and its associated value is a boolean
-	 * indicating whether the button is currently pressed (`true`) or not pressed (`false`).
-	 *
-	 * This variable is primarily used for tracking button input states and ensuring
-	 * accurate representation of input events, such as detecting when a button's state
-	 * changes from pressed to released or vice versa.
-	 *
-	 * The map is updated dynamically during controller runtime, including in functions
-	 * like CheckButtonInput, which ensures real-time synchronization of input states.
+	 * Digital buttons are replaced as a whole for every decoded report, while the stick
+	 * direction buttons are updated per axis from the analog values. Only bits that differ
+	 * from the previous state produce pressed/released events.
 	 * It is reset during library shutdown to clear all stored button states.
 	 */
-	TMap<const FName, bool> ButtonStates;
+	FGamepadButtonState ButtonState;
 
 	TMap<const FName, float> AnalogStates;
 
@@ -309,6 +341,51 @@ private:
 	 * initialization, input handling, and managing device-specific settings.
 	 */
 	FDeviceContext HIDDeviceContexts;
+	/**
+	 * @brief Set when the output context changed since the last report was sent.
+	 *
+	 * Setters only update the output context and raise this flag; FlushOutput composes and writes
+	 * one report for all of them.
+	 */
+	bool bOutputDirty = false;
+	/**
+	 * @brief Schedules an output report for the next FlushOutput.
+	 */
+	void MarkOutputDirty() { bOutputDirty = true; }
+	/**
+	 * @brief Dedicated thread that reads input reports for this device.
+	 *
+	 * Started in InitializeLibrary and joined in ShutdownLibrary before the device handles are
+	 * released. UpdateInput only consumes the newest complete report published by this thread.
+	 */
+	TUniquePtr<FInputReaderThread> InputReader;
+	/**
+	 * @brief Dedicated thread that writes output reports for this device.
+	 *
+	 * Started first in InitializeLibrary and registered in HIDDeviceContexts, so every composed
+	 * report is sent from this thread and the game thread never blocks on HID writes.
+	 */
+	TUniquePtr<FOutputWriterThread> OutputWriter;
+	/**
+	 * @brief Decoder for the report layout of this device and connection, selected in InitializeLibrary.
+	 */
+	FReportDecodeFunction ReportDecoder = nullptr;
+	/**
+	 * @brief State decoded from the newest input report.
+	 */
+	FGamepadInputState InputState;
+	/**
+	 * @brief Whether UpdateInput replays every queued report instead of only the newest one.
+	 */
+	bool bEnableSubFrameInput = false;
+	/**
+	 * @brief Arrival time of the report currently being decoded, stamped on recorded sub-frame events.
+	 */
+	double CurrentReportTimestamp = 0.0;
+	/**
+	 * @brief Button edges decoded during the last UpdateInput call when sub-frame input is enabled.
+	 */
+	TArray<FSubFrameInputEvent> SubFrameInputEvents;
 	/**
 	 * @brief Defines the sensitivity threshold for sensors to ignore minor inputs.
 	 *
@@ -3,7 +3,6 @@
 // Planned Release Year: 2025
 
 #pragma once
-#include "Containers/Ticker.h"
 #include "CoreMinimal.h"
 #include "Engine/Engine.h"
 #include "Misc/CoreDelegates.h"
@@ -25,22 +24,24 @@ class FHapticsRegistry final : public TSharedFromThis<FHapticsRegistry>, public
 public:
 	static TSharedPtr<FHapticsRegistry> Get();
 	/**
-	 * Creates and associates a new audio haptics listener for a specified input device and submix.
+	 * Subscribes an input device to the audio haptics listener of a submix, creating and registering the listener
+	 * if no other device uses that submix yet.
 	 *
-	 * This method ensures that only one listener is active for the given device. If a listener already exists,
-	 * it removes the previous association before creating and registering a new listener for the specified submix.
+	 * A device follows one submix at a time: if it is already subscribed elsewhere, that association is removed
+	 * first. Devices sharing a submix share its listener, so the submix is resampled and quantized once per
+	 * buffer no matter how many controllers it drives.
 	 *
-	 * @param DeviceId The unique identifier of the input device for which the listener is created.
+	 * @param DeviceId The unique identifier of the input device to subscribe.
 	 * @param Submix A pointer to the sound submix to which the audio haptics listener will be bound.
 	 *               If this is null, the method will return without taking any action.
+	 * @param Gain Linear gain applied to this device's haptic samples.
 	 */
-	void CreateListenerForDevice(const FInputDeviceId& DeviceId, USoundSubmix* Submix);
+	void CreateListenerForDevice(const FInputDeviceId& DeviceId, USoundSubmix* Submix, float Gain = 1.0f);
 	/**
-	 * Removes the audio haptics listener for the specified input device.
+	 * Unsubscribes the specified input device from its submix listener.
 	 *
-	 * This method ensures that any existing listener associated with the given
-	 * device ID is properly removed and unregistered. If no listener exists for
-	 * the provided device ID, the method takes no action.
+	 * The device's pacing thread is stopped; the listener itself is unregistered from the audio device
+	 * once its last device leaves. If the device is not subscribed, the method takes no action.
 	 *
 	 * @param DeviceId The unique identifier of the input device whose associated
 	 *                 haptics listener is to be removed.
@@ -50,7 +51,7 @@ public:
 	 * Destructor for the FHapticsRegistry class.
 	 *
 	 * Cleans up and releases all resources managed by this instance of FHapticsRegistry.
-	 * Specifically, it iterates through all registered listeners in the ControllerListeners map
+	 * Specifically, it iterates through all registered listeners in the SubmixListeners map
 	 * and ensures that all associated listeners are properly removed.
 	 *
 	 * This method guarantees that the resources used for managing haptics-related listeners are
@@ -77,31 +78,20 @@ public:
 	 * to ensure proper handling.
 	 */
 	void RemoveAllListeners();
-
 	/**
-	 * Executes the haptics tick for all registered haptics listeners.
-	 *
-	 * This method iterates through the map of registered ControllerListeners,
-	 * invokes the `ConsumeHapticsQueue` method on valid listeners, and processes
-	 * the pending haptic feedback actions. It ensures that haptics data
-	 * gets consumed in a timely manner during the game's update cycle.
-	 *
-	 * @param DeltaTime The time elapsed since the last tick, in seconds.
-	 *                  This parameter is generally used for time-based updates.
+	 * Returns the listener the specified input device is subscribed to.
 	 *
-	 * @return Always returns true to indicate the tick was successful.
+	 * @param DeviceId The unique identifier of the input device.
+	 * @return The listener, or null if the device is not subscribed to any submix.
 	 */
-	bool Tick(float DeltaTime);
-
+	TSharedPtr<FAudioHapticsListener> GetListenerForDevice(const FInputDeviceId& DeviceId) const;
 	/**
-	 * Handle for a delegate registered to the game thread ticker.
+	 * Changes the haptic gain of a subscribed input device without affecting other devices on the same submix.
 	 *
-	 * This variable is used to manage the life cycle of the delegate associated with
-	 * the game thread ticker. It enables the removal or replacement of the registered
-	 * delegate when necessary and ensures proper handling of tasks scheduled on the
-	 * game thread over time.
+	 * @param DeviceId The unique identifier of the input device.
+	 * @param Gain Linear gain, clamped to [0, FAudioHapticsListener::MaxGain].
 	 */
-	FTSTicker::FDelegateHandle GameThreadTickerHandle;
+	void SetDeviceGain(const FInputDeviceId& DeviceId, float Gain);
 
 	/**
 	 * Holds the singleton instance of FHapticsRegistry.
@@ -114,15 +104,18 @@ public:
 private:
 	static TSharedPtr<FHapticsRegistry> Instance;
 	/**
-	 * Maps input device identifiers to their associated audio haptics listeners.
-	 *
-	 * This data structure is responsible for managing the relationship between input devices
-	 * (identified by FInputDeviceId) and their corresponding haptics listeners
-	 * (represented by TSharedPtr<FAudioHapticsListener>). It ensures that each device
-	 * has a corresponding listener, allowing for device-specific haptics handling.
+	 * Unregisters a listener from the active audio device, if any.
+	 */
+	static void UnregisterListener(const TSharedPtr<FAudioHapticsListener>& Listener);
+	/**
+	 * Maps submixes to the audio haptics listener registered on them.
 	 *
-	 * The map is used primarily within the FHapticsRegistry class to register, retrieve,
-	 * and remove audio haptics listeners as devices are added or removed.
+	 * Each listener resamples its submix once and fans the packets out to every device subscribed to it;
+	 * a listener is created with its first device and unregistered with its last.
+	 */
+	TMap<USoundSubmix*, TSharedPtr<FAudioHapticsListener>> SubmixListeners;
+	/**
+	 * Maps input device identifiers to the submix they are subscribed to.
 	 */
-	TMap<FInputDeviceId, TSharedPtr<FAudioHapticsListener>> ControllerListeners;
+	TMap<FInputDeviceId, USoundSubmix*> DeviceSubmixes;
 };
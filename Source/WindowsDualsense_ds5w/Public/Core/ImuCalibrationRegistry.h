@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "Core/Structs/DeviceContext.h"
+#include "Core/Structs/ImuCalibration.h"
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Process-wide cache of the factory motion sensor calibration of every controller seen so far.
+ *
+ * Entries are keyed by the controller's Bluetooth address, read from the pairing info feature
+ * report, rather than by device path: a USB path identifies the port, so a different controller
+ * plugged into the same port must not inherit the previous one's coefficients, while the same
+ * controller keeps its address on any port and over either connection. Entries are kept across
+ * disconnects, so a reconnect costs the small pairing info request instead of the calibration one.
+ * The cache may be filled from the detection thread, hence the lock.
+ */
+class FImuCalibrationRegistry
+{
+public:
+	/**
+	 * Size of the DualSense pairing info feature report, including the report id.
+	 */
+	static constexpr int32 DualSensePairingReportSize = 20;
+	/**
+	 * Report id of the DualSense pairing info feature report, which carries the controller's address.
+	 */
+	static constexpr uint8 DualSensePairingReportId = 0x09;
+
+	/**
+	 * Returns the calibration of a device, reading it from the controller the first time its address is seen.
+	 *
+	 * The device handle must be open. If the controller does not answer or sends an invalid
+	 * report, the identity calibration is returned and nothing is cached, so the next connection
+	 * tries again. A controller whose address cannot be read is calibrated on every connection.
+	 *
+	 * @param Context The device whose calibration is requested.
+	 * @return The factory calibration, or the identity calibration if it is unavailable.
+	 */
+	static FImuCalibration Load(FDeviceContext* Context);
+	/**
+	 * Extracts the controller's address from a DualSense pairing info feature report (0x09).
+	 *
+	 * @param Report Raw feature report bytes, starting at the report id.
+	 * @param Length Number of valid bytes in Report.
+	 * @param OutAddress Receives the 48-bit address on success.
+	 * @return True if the report holds a usable address.
+	 */
+	static bool ParseDualSenseAddress(const unsigned char* Report, int32 Length, uint64& OutAddress);
+	/**
+	 * Parses a DualSense calibration feature report that was already fetched and caches the result.
+	 *
+	 * Used by platforms that read report 0x05 anyway while detecting Bluetooth controllers.
+	 *
+	 * @param Address The address of the controller the report was read from.
+	 * @param Report Raw feature report bytes, starting at the report id.
+	 * @param Length Number of valid bytes in Report.
+	 */
+	static void StoreDualSenseReport(uint64 Address, const unsigned char* Report, int32 Length);
+
+private:
+	/**
+	 * Guards Calibrations.
+	 */
+	static FCriticalSection Mutex;
+	/**
+	 * Valid factory calibrations, keyed by controller address.
+	 */
+	static TMap<uint64, FImuCalibration> Calibrations;
+};
@@ -53,16 +53,28 @@ public:
 	 */
 	virtual ~IPlatformHardwareInfoInterface() = default;
 	/**
-	 * Reads data from the hardware device using the provided context.
+	 * Value returned by Read() when the read failed without the device being gone, e.g. an I/O error
+	 * the platform does not classify as a disconnect. Unlike a timeout it returns immediately.
+	 */
+	static constexpr int32 ReadTransientError = -2;
+	/**
+	 * Reads a single input report from the hardware device into the given buffer.
 	 *
 	 * This pure virtual function must be implemented by derived classes to facilitate
-	 * data reading from a specific hardware device. The implementation is responsible
-	 * for interacting with the device and processing any relevant data.
+	 * data reading from a specific hardware device. The call blocks until a report arrives
+	 * or the timeout elapses and is intended to be issued from the device's input reader
+	 * thread only; it must never touch the input buffers stored in the context itself.
 	 *
 	 * @param Context A pointer to the device context that provides the necessary information
 	 *                or state required to perform the read operation.
+	 * @param Buffer Destination for the raw report bytes.
+	 * @param Length Size of the report to read, in bytes.
+	 * @param TimeoutMs Maximum time to wait for a report, in milliseconds.
+	 * @return The number of bytes read, 0 if no report arrived before the timeout, ReadTransientError
+	 *         if the read failed but the device may still be reachable, or any other negative value
+	 *         if the device is no longer reachable.
 	 */
-	virtual void Read(FDeviceContext* Context) = 0;
+	virtual int32 Read(FDeviceContext* Context, unsigned char* Buffer, int32 Length, int32 TimeoutMs) = 0;
 	/**
 	 * Writes data to the hardware device using the provided context.
 	 *
@@ -74,6 +86,31 @@ public:
 	 *                or state required to perform the write operation.
 	 */
 	virtual void Write(FDeviceContext* Context) = 0;
+	/**
+	 * Writes an already composed output report to the hardware device.
+	 *
+	 * Unlike Write, this never reads the buffers stored in the context, so it can be called from
+	 * the device's output writer thread while the game thread composes the next report.
+	 *
+	 * @param Context A pointer to the device context whose handle is used for the write.
+	 * @param Buffer Raw report bytes, starting at the report id.
+	 * @param Length Number of bytes to write.
+	 * @return True if the report was written.
+	 */
+	virtual bool WriteReport(FDeviceContext* Context, const unsigned char* Buffer, int32 Length) = 0;
+	/**
+	 * Reads a feature report from the hardware device.
+	 *
+	 * Derived classes must implement this method to issue a synchronous feature report request
+	 * on the device's output handle. It is used for one-off queries such as the factory motion
+	 * sensor calibration and must not be called from the input reader thread.
+	 *
+	 * @param Context A pointer to the device context whose handle is used for the request.
+	 * @param Buffer Receives the report. The first byte must hold the requested report id.
+	 * @param Length Size of the report, in bytes, including the report id.
+	 * @return True if the device answered with the report, false otherwise.
+	 */
+	virtual bool GetFeatureReport(FDeviceContext* Context, unsigned char* Buffer, int32 Length) = 0;
 	/**
 	 * Detects and collects information about connected hardware devices.
 	 *
@@ -123,6 +160,40 @@ public:
 	 * @param Context Pointer to the device context used to process audio haptic feedback.
 	 */
 	virtual void ProcessAudioHapitc(FDeviceContext* Context) = 0;
+	/**
+	 * Starts watching the system for controllers being connected or disconnected.
+	 *
+	 * Platforms that can be notified of device arrival and removal override this method so
+	 * Detect() only has to run when something changed. The default implementation has no
+	 * notification source and returns false, in which case the caller keeps polling Detect().
+	 *
+	 * @param OnDevicesChanged Invoked whenever a device that may be a controller arrives or leaves.
+	 *                         It can be called from any thread and must only schedule a detection.
+	 * @return True if notifications were registered.
+	 */
+	virtual bool StartHotplugNotifications(TFunction<void()> OnDevicesChanged)
+	{
+		return false;
+	}
+	/**
+	 * Stops the notifications registered by StartHotplugNotifications().
+	 *
+	 * Once this returns, the callback is no longer running and will not be invoked again.
+	 */
+	virtual void StopHotplugNotifications()
+	{
+	}
+	/**
+	 * Indicates whether the last Detect() skipped a possible controller it could not query, e.g. an
+	 * interface still being set up right after its arrival notification.
+	 *
+	 * No further notification may come for such a device, so the caller keeps polling Detect()
+	 * until this returns false. Only valid on the thread that ran Detect(), right after it.
+	 */
+	virtual bool NeedsDetectionRetry() const
+	{
+		return false;
+	}
 	/**
 	 * Default constructor for the IPlatformHardwareInfoInterface.
 	 *
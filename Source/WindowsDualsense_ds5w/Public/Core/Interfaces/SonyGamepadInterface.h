@@ -6,6 +6,7 @@
 
 #include "Core/Enums/EDeviceCommons.h"
 #include "Core/Structs/DeviceContext.h"
+#include "Core/Structs/SubFrameInputEvent.h"
 #include "CoreMinimal.h"
 #include "InputCoreTypes.h"
 #include "Misc/CoreDelegates.h"
@@ -65,6 +66,9 @@ public:
 	 * or system interface. The `FDeviceContext` provides necessary information
 	 * about the device such as its handle, connection type, and related settings.
 	 *
+	 * Called from a worker thread before the library is registered, so implementations may block
+	 * on the device but must not touch game thread state.
+	 *
 	 * @param Context A reference to an `FDeviceContext` structure containing
 	 *                the device's configuration and connection details.
 	 * @return A boolean value indicating whether the library was successfully initialized.
@@ -114,6 +118,24 @@ public:
 	 * @param bIsTouch A boolean indicating whether touch input is enabled (true) or disabled (false).
 	 */
 	virtual void EnableTouch(const bool bIsTouch) = 0;
+	/**
+	 * Enables or disables sub-frame input for the device.
+	 *
+	 * When enabled, every input report received since the previous update is decoded, so
+	 * button presses and releases shorter than a frame still reach the message handler and
+	 * are recorded with their arrival time.
+	 *
+	 * @param bEnable A boolean indicating whether every report should be processed (true) or only the newest one (false).
+	 */
+	virtual void EnableSubFrameInput(const bool bEnable) = 0;
+	/**
+	 * Retrieves the button edges decoded during the most recent input update, in arrival order.
+	 *
+	 * The array is rebuilt on every update and is empty unless sub-frame input is enabled.
+	 *
+	 * @return The sub-frame button events of the last update.
+	 */
+	virtual const TArray<FSubFrameInputEvent>& GetSubFrameInputEvents() const = 0;
 	/**
 	 * Resets the orientation of the gyroscope to its default state.
 	 * Typically used to recalibrate the gyroscope sensor.
@@ -140,6 +162,17 @@ public:
 	 * @return True if the calibration status was successfully retrieved, false otherwise.
 	 */
 	virtual bool GetMotionSensorCalibrationStatus(float& OutProgress) = 0;
+	/**
+	 * Retrieves the gyroscope zero-rate offset estimated continuously while the controller rests.
+	 *
+	 * The estimate is refined automatically whenever the controller is still, so no calibration
+	 * screen is required and slow thermal drift is corrected during play.
+	 *
+	 * @param OutBias Receives the per-axis bias in degrees per second.
+	 * @param OutConfidence Receives the confidence in the estimate, from 0 (none) to 1.
+	 * @return True if an estimate is available.
+	 */
+	virtual bool GetGyroBiasEstimate(FVector& OutBias, float& OutConfidence) const = 0;
 	/**
 	 * Retrieves the current battery level of the Sony gamepad.
 	 *
@@ -163,8 +196,18 @@ public:
 	/**
 	 * Pure virtual function that sends data or commands to the connected gamepad.
 	 * This function must be implemented by any class inheriting this interface.
+	 *
+	 * The report is composed and written immediately. Setters do not call this directly; they only
+	 * update the output context and mark it dirty, and FlushOutput sends the result once.
 	 */
 	virtual void SendOut() = 0;
+	/**
+	 * Sends a single output report if any setter changed the output context since the last flush.
+	 *
+	 * Called by the device manager once per frame, or less often when `ds.OutputMaxRate` caps the
+	 * output rate, so any number of setter calls within a frame results in at most one HID write.
+	 */
+	virtual void FlushOutput() = 0;
 	/**
 	 * Stops all currently active operations or actions associated with the interface.
 	 * This method must be implemented by any derived class to handle the termination
@@ -132,10 +132,10 @@ public:
 	/**
 	 * Updates the haptic feedback on a gamepad's triggers using audio waveform data.
 	 *
-	 * @param AudioData An array of integer values representing the audio waveform data
-	 *                  used to drive the haptic feedback effects on the triggers.
+	 * @param AudioData A view of the audio waveform data used to drive the haptic feedback
+	 *                  effects on the triggers. Only read during the call.
 	 */
-	virtual void AudioHapticUpdate(TArray<int8> AudioData) = 0;
+	virtual void AudioHapticUpdate(TConstArrayView<int8> AudioData) = 0;
 
 	/**
 	 * New advanced rhythmic machine effect (opcode 0x27).
@@ -20,7 +20,7 @@ class FCommonsDeviceInfo : public IPlatformHardwareInfoInterface
 	 * of derived class objects through base class pointers.
 	 */
 public:
-	virtual ~FCommonsDeviceInfo() override {}
+	virtual ~FCommonsDeviceInfo() override;
 	/**
 	 * Processes audio haptic feedback using the given device context.
 	 *
@@ -36,18 +36,21 @@ public:
 	 */
 	virtual void ProcessAudioHapitc(FDeviceContext* Context) override;
 	/**
-	 * Reads device information using the provided device context.
+	 * Reads a single input report using the provided device context.
 	 *
-	 * This method retrieves and processes the relevant information about
-	 * the device through the given device context. It is a member function
-	 * of the FCommonsDeviceInfo class and is intended to handle device-specific
-	 * data retrieval operations.
+	 * This method blocks on the device handle until a report arrives or the
+	 * timeout elapses. It is called from the device's input reader thread and
+	 * writes only into the supplied buffer.
 	 *
 	 * @param Context A pointer to the FDeviceContext object, which provides
 	 *        the necessary context and interface for accessing device-related
 	 *        information. It must be valid and properly initialized.
+	 * @param Buffer Destination for the raw report bytes.
+	 * @param Length Size of the report to read, in bytes.
+	 * @param TimeoutMs Maximum time to wait for a report, in milliseconds.
+	 * @return The number of bytes read, 0 on timeout, or a negative value on failure.
 	 */
-	virtual void Read(FDeviceContext* Context) override;
+	virtual int32 Read(FDeviceContext* Context, unsigned char* Buffer, int32 Length, int32 TimeoutMs) override;
 	/**
 	 * Writes device-specific information to the provided device context.
 	 *
@@ -60,6 +63,24 @@ public:
 	 *                non-null pointer.
 	 */
 	virtual void Write(FDeviceContext* Context) override;
+	/**
+	 * Writes a composed output report through hidapi.
+	 *
+	 * @param Context Pointer to the device context whose handle is used for the write.
+	 * @param Buffer Raw report bytes, starting at the report id.
+	 * @param Length Number of bytes to write.
+	 * @return True if the report was written.
+	 */
+	virtual bool WriteReport(FDeviceContext* Context, const unsigned char* Buffer, int32 Length) override;
+	/**
+	 * Reads a feature report through hidapi.
+	 *
+	 * @param Context Pointer to the device context whose handle is used for the request.
+	 * @param Buffer Receives the report. The first byte must hold the requested report id.
+	 * @param Length Size of the report, in bytes, including the report id.
+	 * @return True if the device answered with the report, false otherwise.
+	 */
+	virtual bool GetFeatureReport(FDeviceContext* Context, unsigned char* Buffer, int32 Length) override;
 	/**
 	 * Detects and populates a list of device contexts.
 	 *
@@ -92,5 +113,26 @@ public:
 	 *                be invalidated. This parameter must not be null.
 	 */
 	virtual void InvalidateHandle(FDeviceContext* Context) override;
+#if PLATFORM_LINUX
+	/**
+	 * Listens to kernel uevents on a netlink socket and reports hidraw nodes being added or removed.
+	 *
+	 * hidapi reaches controllers through their hidraw node, so this covers USB and Bluetooth alike.
+	 * Uevents carry no vendor id for hidraw nodes, so any HID device arriving or leaving triggers the
+	 * callback; that only costs one enumeration of the Sony devices.
+	 *
+	 * @param OnDevicesChanged Invoked from the monitor thread on every hidraw event.
+	 * @return True if the netlink socket was bound and the monitor thread started.
+	 */
+	virtual bool StartHotplugNotifications(TFunction<void()> OnDevicesChanged) override;
+	/**
+	 * Stops the monitor thread, waiting for it to exit, and closes the netlink socket.
+	 */
+	virtual void StopHotplugNotifications() override;
+
+private:
+	class FHotplugMonitor;
+	TUniquePtr<FHotplugMonitor> HotplugMonitor;
+#endif
 };
 #endif
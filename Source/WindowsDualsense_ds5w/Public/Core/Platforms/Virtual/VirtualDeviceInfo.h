@@ -0,0 +1,273 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "Core/Interfaces/PlatformHardwareInfoInterface.h"
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include <atomic>
+
+/**
+ * @brief Raw contents of one virtual input report, independent of the report layout.
+ *
+ * Each field holds the byte, or the little-endian value, the controller would send at the matching
+ * layout offset, so the same frame produces equivalent USB and Bluetooth reports.
+ */
+struct FVirtualInputFrame
+{
+	uint8 LeftStickX = 0x80;
+	uint8 LeftStickY = 0x80;
+	uint8 RightStickX = 0x80;
+	uint8 RightStickY = 0x80;
+	uint8 LeftTrigger = 0;
+	uint8 RightTrigger = 0;
+	/**
+	 * @brief Face buttons in the high nibble, hat switch in the low nibble; 0x08 is a released hat.
+	 */
+	uint8 FaceAndHat = 0x08;
+	/**
+	 * @brief Shoulders, trigger thresholds, stick clicks, Options and Create.
+	 */
+	uint8 Misc = 0;
+	/**
+	 * @brief PlayStation, touch pad and mic buttons, plus the Edge function buttons and paddles.
+	 */
+	uint8 Special = 0;
+	int16 Gyro[3] = {};
+	/**
+	 * @brief Accelerometer counts; the default is a controller lying flat, 1 g on the Y axis.
+	 */
+	int16 Accel[3] = {0, 8192, 0};
+};
+
+/**
+ * @brief Kinds of reports a virtual device records.
+ */
+enum class EVirtualCapture : uint8
+{
+	/**
+	 * @brief Output reports sent through Write() and WriteReport().
+	 */
+	Output,
+	/**
+	 * @brief Audio haptic reports sent through ProcessAudioHapitc().
+	 */
+	AudioHaptic,
+};
+
+/**
+ * @brief One report recorded by a virtual device.
+ */
+struct FVirtualCapturedReport
+{
+	/**
+	 * @brief Largest report recorded, the Bluetooth audio haptic report; longer writes are truncated.
+	 */
+	static constexpr int32 MaxLength = 142;
+
+	/**
+	 * @brief Time the report was written, in FPlatformTime::Seconds().
+	 */
+	double Timestamp = 0.0;
+	/**
+	 * @brief Number of bytes the caller wrote, before truncation to MaxLength.
+	 */
+	int32 Length = 0;
+	unsigned char Data[MaxLength] = {};
+};
+
+/**
+ * @brief Counters of the reports a virtual device recorded.
+ */
+struct FVirtualCaptureStats
+{
+	/**
+	 * @brief Reports written since the device was plugged or the captures were cleared.
+	 */
+	uint64 TotalReports = 0;
+	/**
+	 * @brief Reports overwritten in the capture ring before they were inspected.
+	 */
+	uint64 OverwrittenReports = 0;
+	/**
+	 * @brief Input reports generated since the device was plugged.
+	 */
+	uint64 InputReports = 0;
+	/**
+	 * @brief Calibration feature reports (0x05) answered since the device was plugged.
+	 */
+	uint64 CalibrationRequests = 0;
+};
+
+/**
+ * @brief Software backend that presents virtual controllers in place of the platform HID layer.
+ *
+ * Lets the libraries, the output composer and the device registry run without hardware, e.g. to
+ * load-test many controllers on machines without USB or to benchmark the input and output paths.
+ * It is selected at runtime, in place of the platform backend, when ds.Virtual.Enable is set or
+ * the command line has -DualSenseVirtual, and it plugs ds.Virtual.Count devices on creation.
+ *
+ * Input reports are produced at ds.Virtual.ReportRate, each one encoded with the same layout the
+ * decoders read. A device replays its script if one is set, and otherwise sends either a seeded
+ * random walk (ds.Virtual.RandomInput) or a resting controller, so runs are reproducible. Output and
+ * audio haptic reports are recorded into fixed-size rings that can be inspected at any time.
+ *
+ * Devices can be plugged and unplugged at runtime; the registry is notified through the hotplug
+ * callback, and readers of an unplugged device see it as lost.
+ */
+class FVirtualDeviceInfo final : public IPlatformHardwareInfoInterface
+{
+public:
+	/**
+	 * @brief Number of virtual device slots.
+	 */
+	static constexpr int32 MaxDevices = 16;
+	/**
+	 * @brief Reports kept per device and capture kind; older ones are overwritten.
+	 */
+	static constexpr int32 CaptureCapacity = 256;
+
+	FVirtualDeviceInfo();
+	virtual ~FVirtualDeviceInfo() override;
+
+	/**
+	 * @brief Checks the console variable and the command line for a request to use the virtual backend.
+	 */
+	static bool IsRequested();
+	/**
+	 * @brief Returns the virtual backend if it is the one in use, or null.
+	 */
+	static FVirtualDeviceInfo* GetActive();
+
+	/**
+	 * @brief Plugs a new virtual device into the first free slot. Game thread only.
+	 *
+	 * @return The slot index, or INDEX_NONE if every slot is taken.
+	 */
+	int32 Plug(EDeviceType DeviceType, EDeviceConnection ConnectionType);
+	/**
+	 * @brief Unplugs a virtual device; its reader sees the device as lost and the next detection removes it.
+	 *        Game thread only.
+	 *
+	 * @return False if the slot holds no device.
+	 */
+	bool Unplug(int32 Index);
+	/**
+	 * @brief Number of devices currently plugged.
+	 */
+	int32 Num() const;
+	/**
+	 * @brief Returns the path a plugged device is detected under, or an empty string if the slot holds no device.
+	 */
+	FString GetPath(int32 Index) const;
+	/**
+	 * @brief Replaces the input script of a device. The frames are sent one per report, in order.
+	 *
+	 * @param Index The device slot.
+	 * @param Frames The script; an empty script returns the device to generated input.
+	 * @param bLoop Whether to start over after the last frame, instead of holding it.
+	 */
+	void SetScript(int32 Index, TArray<FVirtualInputFrame> Frames, bool bLoop = true);
+	/**
+	 * @brief Copies the recorded reports of a device, oldest first.
+	 *
+	 * @return False if the slot holds no device.
+	 */
+	bool GetCapturedReports(int32 Index, EVirtualCapture Kind, TArray<FVirtualCapturedReport>& OutReports) const;
+	/**
+	 * @brief Returns the capture counters of a device.
+	 *
+	 * @return False if the slot holds no device.
+	 */
+	bool GetCaptureStats(int32 Index, EVirtualCapture Kind, FVirtualCaptureStats& OutStats) const;
+	/**
+	 * @brief Discards the recorded reports of a device and resets its capture counters.
+	 */
+	void ClearCaptures(int32 Index);
+
+	virtual int32 Read(FDeviceContext* Context, unsigned char* Buffer, int32 Length, int32 TimeoutMs) override;
+	virtual void Write(FDeviceContext* Context) override;
+	virtual bool WriteReport(FDeviceContext* Context, const unsigned char* Buffer, int32 Length) override;
+	/**
+	 * @brief Answers the DualSense calibration report with nominal factory values and the pairing
+	 *        info report with an address fixed per slot and model; other reports fail.
+	 */
+	virtual bool GetFeatureReport(FDeviceContext* Context, unsigned char* Buffer, int32 Length) override;
+	virtual void Detect(TArray<FDeviceContext>& DetectedDevices) override;
+	virtual bool CreateHandle(FDeviceContext* Context) override;
+	virtual void InvalidateHandle(FDeviceContext* Context) override;
+	virtual void ProcessAudioHapitc(FDeviceContext* Context) override;
+	virtual bool StartHotplugNotifications(TFunction<void()> OnDevicesChanged) override;
+	virtual void StopHotplugNotifications() override;
+
+private:
+	/**
+	 * @brief Fixed-size ring of recorded reports that overwrites the oldest one.
+	 */
+	struct FCaptureRing
+	{
+		TArray<FVirtualCapturedReport> Reports;
+		uint64 Written = 0;
+
+		void Add(const unsigned char* Buffer, int32 Length);
+		void Reset();
+	};
+
+	/**
+	 * @brief One device slot. Everything but bPlugged and Generation is guarded by Lock.
+	 */
+	struct FVirtualDevice
+	{
+		mutable FCriticalSection Lock;
+		std::atomic<bool> bPlugged{false};
+		/**
+		 * @brief Bumped on every plug and unplug, and encoded into handles, so a stale handle is rejected.
+		 */
+		std::atomic<uint32> Generation{0};
+		EDeviceType DeviceType = EDeviceType::DualSense;
+		EDeviceConnection ConnectionType = EDeviceConnection::Usb;
+		FString Path;
+
+		TArray<FVirtualInputFrame> Script;
+		int32 ScriptPosition = 0;
+		bool bLoopScript = true;
+		FVirtualInputFrame Frame;
+		FRandomStream Random;
+		double NextReportTime = 0.0;
+		uint32 SensorTimestamp = 0;
+		uint8 Sequence = 0;
+		uint64 InputReports = 0;
+		uint64 CalibrationRequests = 0;
+
+		FCaptureRing Captures[2];
+	};
+
+	/**
+	 * @brief Returns the slot a handle was issued for, or INDEX_NONE if that device was unplugged since.
+	 */
+	int32 FindDevice(FPlatformDeviceHandle Handle) const;
+	/**
+	 * @brief Resets the generated input of a device. Caller holds the device lock.
+	 */
+	void ResetInput(int32 Index);
+	/**
+	 * @brief Advances the input of a device by one report. Caller holds the device lock.
+	 */
+	static void AdvanceFrame(FVirtualDevice& Device);
+	/**
+	 * @brief Records a report written to a device.
+	 */
+	void Capture(FPlatformDeviceHandle Handle, EVirtualCapture Kind, const unsigned char* Buffer, int32 Length);
+	/**
+	 * @brief Invokes the hotplug callback, if one is registered.
+	 */
+	void NotifyDevicesChanged();
+
+	static FVirtualDeviceInfo* Active;
+
+	FVirtualDevice Devices[MaxDevices];
+	FCriticalSection HotplugLock;
+	TFunction<void()> OnHotplug;
+};
@@ -10,6 +10,7 @@
 #include "Windows/AllowWindowsPlatformTypes.h"
 #include "Windows/HideWindowsPlatformTypes.h"
 #include <Windows.h>
+#include <cfgmgr32.h>
 #endif
 
 #include "../../Interfaces/PlatformHardwareInfoInterface.h"
@@ -42,19 +43,33 @@ class FWindowsDeviceInfo final : public IPlatformHardwareInfoInterface
 
 public:
 	virtual void ProcessAudioHapitc(FDeviceContext* Context) override;
-	static bool ConfigureBluetoothFeatures(HANDLE DeviceHandle);
 	/**
-	 * @brief Reads data from the specified HID device context.
+	 * @brief Switches a Bluetooth controller to extended reports by reading feature report 0x05.
 	 *
-	 * This method performs the process of retrieving input data from an HID device, verifying the context's validity,
-	 * handling connection states, and managing input buffers. It also utilizes polling mechanisms to detect and
-	 * report disconnection events or communication failures during the read process.
+	 * For DualSense controllers that report carries the factory motion sensor calibration, which
+	 * is handed to FImuCalibrationRegistry under the address read from the pairing info report,
+	 * so the library does not request it a second time.
+	 *
+	 * @param DeviceHandle An open handle to the controller.
+	 * @param DeviceType The controller model.
+	 * @return True if the feature report was read.
+	 */
+	static bool ConfigureBluetoothFeatures(HANDLE DeviceHandle, EDeviceType DeviceType);
+	/**
+	 * @brief Reads a single input report from the specified HID device context.
+	 *
+	 * This method issues an overlapped read on the context's dedicated input handle and waits for
+	 * at most TimeoutMs for a report to arrive, cancelling the pending read on timeout. It is called
+	 * from the device's input reader thread and never touches the input buffers of the context.
 	 *
 	 * @param Context Pointer to the device context representing the HID device being read. Must not be null and
-	 *        should contain a valid device handle and input buffer. If the context is invalid or disconnected,
-	 *        the method will handle associated cleanup and reporting.
+	 *        should contain a valid input handle.
+	 * @param Buffer Destination for the raw report bytes.
+	 * @param Length Size of the report to read, in bytes.
+	 * @param TimeoutMs Maximum time to wait for a report, in milliseconds.
+	 * @return The number of bytes read, 0 on timeout or transient failure, or -1 if the device is gone.
 	 */
-	virtual void Read(FDeviceContext* Context) override;
+	virtual int32 Read(FDeviceContext* Context, unsigned char* Buffer, int32 Length, int32 TimeoutMs) override;
 	/**
 	 * @brief Writes data to the specified HID device context.
 	 *
@@ -68,6 +83,24 @@ public:
 	 *        represent a valid device handle for a successful write operation.
 	 */
 	virtual void Write(FDeviceContext* Context) override;
+	/**
+	 * @brief Writes a composed output report with a synchronous WriteFile on the context's output handle.
+	 *
+	 * @param Context Pointer to the device context whose handle is used for the write.
+	 * @param Buffer Raw report bytes, starting at the report id.
+	 * @param Length Number of bytes to write.
+	 * @return True if the report was written.
+	 */
+	virtual bool WriteReport(FDeviceContext* Context, const unsigned char* Buffer, int32 Length) override;
+	/**
+	 * @brief Reads a feature report with HidD_GetFeature on the context's output handle.
+	 *
+	 * @param Context Pointer to the device context whose handle is used for the request.
+	 * @param Buffer Receives the report. The first byte must hold the requested report id.
+	 * @param Length Size of the report, in bytes, including the report id.
+	 * @return True if the device answered with the report, false otherwise.
+	 */
+	virtual bool GetFeatureReport(FDeviceContext* Context, unsigned char* Buffer, int32 Length) override;
 	/**
 	 * @brief Detects available HID devices and updates the provided list of device contexts.
 	 *
@@ -75,10 +108,35 @@ public:
 	 * accessible on the system. It retrieves their attributes, device paths, and initializes valid device
 	 * contexts for further interaction. Devices that cannot be accessed or initialized are skipped.
 	 *
+	 * Interfaces are filtered on the vendor and product ids in their path before being opened, and an
+	 * interface is only opened the first time its path shows up, so the cost of a detection follows the
+	 * number of controllers rather than the number of HID devices on the machine.
+	 *
 	 * @param Devices A reference to an array of FDeviceContext objects that will be updated to include
 	 *        the detected and initialized HID device contexts. Existing data in the array will be overwritten.
 	 */
 	virtual void Detect(TArray<FDeviceContext>& Devices) override;
+	/**
+	 * @brief Registers for HID interface arrival and removal notifications with the configuration manager.
+	 *
+	 * Only interfaces whose path carries the ids of a supported controller trigger the callback, so
+	 * plugging in unrelated HID devices does not cause a rescan.
+	 *
+	 * @param OnDevicesChanged Invoked from a system thread pool thread on every relevant event.
+	 * @return True if CM_Register_Notification succeeded.
+	 */
+	virtual bool StartHotplugNotifications(TFunction<void()> OnDevicesChanged) override;
+	/**
+	 * @brief Unregisters the notifications, waiting for a callback in flight to return.
+	 */
+	virtual void StopHotplugNotifications() override;
+	/**
+	 * @brief True if the last Detect() could not open or query a candidate interface.
+	 */
+	virtual bool NeedsDetectionRetry() const override
+	{
+		return bIdentificationFailed;
+	}
 	/**
 	 * @brief Creates a handle for the specified device context.
 	 *
@@ -121,18 +179,19 @@ public:
 	 */
 	static bool PingOnce(HANDLE Handle, int32* OutLastError = nullptr);
 	/**
-	 * @brief Polls and processes a single tick for a HID device, performing ping and read operations.
+	 * @brief Performs a single overlapped read on a HID device handle, bounded by a timeout.
 	 *
-	 * This method checks the device's state, performs a ping operation if necessary, and reads data from the device.
-	 * It updates the polling state accordingly and determines the result of this polling iteration.
+	 * The read is cancelled if no report arrives within TimeoutMs, so the caller can periodically
+	 * check for shutdown requests. The handle must have been opened with FILE_FLAG_OVERLAPPED.
 	 *
 	 * @param Handle A handle to the HID device being polled.
 	 * @param Buffer A pointer to a buffer where the method writes the data read from the device.
 	 * @param Length The maximum number of bytes that can be read into the buffer.
+	 * @param TimeoutMs Maximum time to wait for a report, in milliseconds.
 	 * @param OutBytesRead A reference to a variable where the number of bytes successfully read will be stored.
 	 * @return An enumeration value of type EPollResult indicating the result of the polling operation.
 	 */
-	static EPollResult PollTick(HANDLE Handle, unsigned char* Buffer, int32 Length, DWORD& OutBytesRead);
+	static EPollResult PollTick(HANDLE Handle, unsigned char* Buffer, int32 Length, int32 TimeoutMs, DWORD& OutBytesRead);
 	/**
 	 * @brief Determines whether the given error code should be treated as a device disconnection.
 	 *
@@ -157,4 +216,48 @@ public:
 				return false;
 		}
 	}
+
+private:
+	/**
+	 * @brief Configuration manager callback; forwards interface arrivals and removals of supported controllers.
+	 */
+	static DWORD CALLBACK OnHotplugNotification(HCMNOTIFICATION Notification, PVOID Context, CM_NOTIFY_ACTION Action,
+	                                            PCM_NOTIFY_EVENT_DATA EventData, DWORD EventDataSize);
+	/**
+	 * @brief Checks, from the vendor and product ids encoded in a HID interface path, whether it may belong
+	 *        to a supported controller. Paths without recognizable ids are treated as candidates.
+	 */
+	static bool IsCandidateControllerPath(const WCHAR* Path);
+
+	/**
+	 * @brief What Detect() learned about an interface path the first time it opened it.
+	 */
+	struct FDetectedInterface
+	{
+		bool bIsController = false;
+		EDeviceType DeviceType = EDeviceType::DualSense;
+		EDeviceConnection ConnectionType = EDeviceConnection::Usb;
+	};
+	/**
+	 * @brief Opens an interface once to read its attributes and, for Bluetooth controllers, enable extended reports.
+	 *
+	 * @return False if the interface could not be queried and should be tried again on the next detection.
+	 */
+	static bool IdentifyInterface(const WCHAR* DevicePath, const FString& PathStr, FDetectedInterface& OutInterface);
+
+	/**
+	 * @brief Candidate interfaces identified by earlier detections, keyed by path, so unchanged interfaces
+	 *        are not opened again. Entries are dropped once their interface disappears. Only touched by Detect().
+	 */
+	TMap<FString, FDetectedInterface> DetectedInterfaces;
+	/**
+	 * @brief Set by Detect() when IdentifyInterface() failed for a candidate, or the interfaces could not be listed.
+	 */
+	bool bIdentificationFailed = false;
+	/**
+	 * @brief Reused SP_DEVICE_INTERFACE_DETAIL_DATA storage; grows to the longest path seen.
+	 */
+	TArray<uint8> DetailDataBuffer;
+	HCMNOTIFICATION HotplugNotification = nullptr;
+	TFunction<void()> OnHotplug;
 };
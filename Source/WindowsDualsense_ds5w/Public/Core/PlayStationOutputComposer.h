@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "Core/Algorithms/Crc32.h"
 #include "Core/Structs/DeviceContext.h"
 #include "CoreMinimal.h"
 
@@ -46,6 +47,18 @@ public:
 	 * making it integral to performance-critical systems where such operations are frequent.
 	 */
 	const static uint32 HashTable[256];
+	/**
+	 * CRC32 of the constant start of a DualSense Bluetooth output report: 0xA2, report id 0x31 and tag 0x02.
+	 */
+	static constexpr uint32 DualSenseOutputPrefixCrc = FCrc32::ExtendByte(FCrc32::ExtendByte(FCrc32::ExtendByte(0, 0xA2), 0x31), 0x02);
+	/**
+	 * CRC32 of the constant start of a DualShock 4 Bluetooth output report: 0xA2, report id 0x11 and flags 0xC0.
+	 */
+	static constexpr uint32 DualShockOutputPrefixCrc = FCrc32::ExtendByte(FCrc32::ExtendByte(FCrc32::ExtendByte(0, 0xA2), 0x11), 0xC0);
+	/**
+	 * CRC32 of the default start of an audio haptic report: 0xA2, report id 0x32 and sequence byte 0x00.
+	 */
+	static constexpr uint32 AudioHapticPrefixCrc = FCrc32::ExtendByte(FCrc32::ExtendByte(FCrc32::ExtendByte(0, 0xA2), 0x32), 0x00);
 	/**
 	 * @brief Configures and sends output data to a DualSense device using the provided device context.
 	 *
@@ -70,6 +83,33 @@ public:
 	 *                      for the controller's output functionalities.
 	 */
 	static void OutputDualShock(FDeviceContext* DeviceContext);
+	/**
+	 * Hands the composed output buffer of a device to its output writer thread, or writes it
+	 * directly when the device has none, e.g. before its library finished initializing.
+	 *
+	 * Reports byte-identical to the last one sent are suppressed, unless the keep-alive interval
+	 * set by `ds.OutputKeepAliveInterval` elapsed or the output writer failed to write a report
+	 * since the last call; the shadow copy is then discarded so the state is sent again.
+	 *
+	 * @param DeviceContext The context whose BufferOutput holds the composed report.
+	 */
+	static void Submit(FDeviceContext* DeviceContext);
+	/**
+	 * Indicates whether the last report sent to a device is older than the keep-alive interval
+	 * and should be sent again even if nothing changed.
+	 *
+	 * @param DeviceContext The device to check.
+	 * @return True if a resend is due.
+	 */
+	static bool IsKeepAliveDue(const FDeviceContext& DeviceContext);
+	/**
+	 * Indicates whether the output of a device should be submitted even if nothing changed,
+	 * because the keep-alive interval elapsed or the output writer failed to write a report.
+	 *
+	 * @param DeviceContext The device to check.
+	 * @return True if a resend is due.
+	 */
+	static bool IsResendDue(const FDeviceContext& DeviceContext);
 	/**
 	 * Configures the trigger effect settings on a PlayStation controller using the provided haptic effect data.
 	 *
@@ -91,12 +131,31 @@ public:
 	 */
 	static void SendAudioHapticAdvanced(FDeviceContext* DeviceContext);
 	/**
-	 * Computes the CRC32 hash for the given buffer using a predefined hash table and seed value.
-	 * The function iterates through each byte of the input buffer to calculate the resulting hash.
+	 * Computes the CRC32 of a Bluetooth report, including the 0xA2 HID header byte the seed accounts for.
+	 * Dispatches to the fastest implementation of FCrc32 available on the running CPU.
 	 *
 	 * @param Buffer A pointer to the input buffer containing the data for which the CRC32 hash is to be computed.
 	 * @param Len The length of the input buffer in bytes.
 	 * @return The computed CRC32 hash value.
 	 */
 	static uint32 Compute(const unsigned char* Buffer, size_t Len);
+	/**
+	 * Computes the same CRC32 as Compute(), one byte at a time using HashTable.
+	 * Kept as the reference the accelerated implementations are checked against.
+	 *
+	 * @param Buffer A pointer to the input buffer containing the data for which the CRC32 hash is to be computed.
+	 * @param Len The length of the input buffer in bytes.
+	 * @return The computed CRC32 hash value.
+	 */
+	static uint32 ComputeReference(const unsigned char* Buffer, size_t Len);
+	/**
+	 * Computes the CRC32 of a Bluetooth report whose first two bytes, the report id and its tag,
+	 * are known in advance, starting from the precomputed CRC of that prefix.
+	 *
+	 * @param Buffer The whole report, starting at the report id.
+	 * @param Len The length of the report covered by the CRC, prefix included.
+	 * @param PrefixCrc The CRC of the 0xA2 header byte followed by Buffer[0] and Buffer[1].
+	 * @return The computed CRC32 hash value, equal to Compute(Buffer, Len).
+	 */
+	static uint32 ComputeAfterPrefix(const unsigned char* Buffer, size_t Len, uint32 PrefixCrc);
 };
@@ -26,6 +26,8 @@ using FPlatformDeviceHandle = void*;
 #include "OutputContext.h"
 #include "DeviceContext.generated.h"
 
+class FOutputWriterThread;
+
 /**
  * @brief Represents the context and state of a connected device.
  *
@@ -56,6 +58,15 @@ struct FDeviceContext
 	 * For instance, it may hold `INVALID_HANDLE_VALUE` when invalid or disconnected.
 	 */
 	FPlatformDeviceHandle Handle = INVALID_PLATFORM_HANDLE;
+	/**
+	 * @brief Handle reserved for the device's input reader thread.
+	 *
+	 * On Windows this is a second, overlapped handle to the same HID interface, so blocking
+	 * input reads never serialize with output reports written through `Handle` and can be
+	 * cancelled on timeout. Platforms whose HID layer supports concurrent reads and writes on
+	 * a single handle leave this invalid and read from `Handle` directly.
+	 */
+	FPlatformDeviceHandle InputHandle = INVALID_PLATFORM_HANDLE;
 	/**
 	 * @brief A platform-specific handle to manage interaction with audio devices.
 	 *
@@ -134,6 +145,44 @@ struct FDeviceContext
 	 *       data handling capabilities.
 	 */
 	unsigned char BufferOutput[78] = {};
+	/**
+	 * @brief Writer thread that owns the output report writes of this device, if one is running.
+	 *
+	 * Set by the device library while it is initialized. When present, composed reports are
+	 * published to it instead of being written on the calling thread.
+	 */
+	FOutputWriterThread* OutputWriter = nullptr;
+	/**
+	 * @brief Shadow copy of the last output report handed to the device.
+	 *
+	 * The composer compares every new report against it and drops byte-identical ones.
+	 */
+	unsigned char LastSentOutput[78] = {};
+	/**
+	 * @brief Number of valid bytes in LastSentOutput; 0 until the first report was sent.
+	 */
+	int32 LastSentOutputLength = 0;
+	/**
+	 * @brief Time the last output report was handed to the device, in FPlatformTime::Seconds().
+	 */
+	double LastOutputSendTime = 0.0;
+	/**
+	 * @brief Number of output reports written directly, without an output writer.
+	 *
+	 * Reports published to the output writer are counted by the writer once the device accepted them.
+	 */
+	uint32 SentOutputReports = 0;
+	/**
+	 * @brief Failed writes of the output writer the composer has already reacted to.
+	 *
+	 * When the writer reports more failures, the shadow copy is discarded so the current state is
+	 * sent again instead of being suppressed as unchanged.
+	 */
+	uint32 HandledFailedWrites = 0;
+	/**
+	 * @brief Number of output reports dropped because they matched the last one sent.
+	 */
+	uint32 SuppressedOutputReports = 0;
 	/**
 	 * Indicates whether the device is connected.
 	 *
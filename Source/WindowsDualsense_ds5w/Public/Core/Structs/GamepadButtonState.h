@@ -0,0 +1,139 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "Core/Structs/SubFrameInputEvent.h"
+#include "CoreMinimal.h"
+#include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
+
+/**
+ * @brief Bit index of every digital input reported to the engine by Sony gamepads.
+ *
+ * Each value is the position of the button inside the packed 64-bit button mask. The order
+ * is also the order in which simultaneous edges are dispatched to the message handler.
+ */
+namespace EGamepadButton
+{
+	enum Type : uint8
+	{
+		FaceButtonBottom,
+		FaceButtonRight,
+		FaceButtonLeft,
+		FaceButtonTop,
+		DPadUp,
+		DPadDown,
+		DPadLeft,
+		DPadRight,
+		LeftShoulder,
+		RightShoulder,
+		LeftTriggerThreshold,
+		RightTriggerThreshold,
+		LeftThumb,
+		RightThumb,
+		SpecialLeft,
+		SpecialRight,
+		PushLeftStick,
+		PushRightStick,
+		Menu,
+		Share,
+		PlayStation,
+		TouchPad,
+		Mic,
+		FunctionL,
+		FunctionR,
+		PaddleL,
+		PaddleR,
+		LeftStickUp,
+		LeftStickDown,
+		LeftStickLeft,
+		LeftStickRight,
+		RightStickUp,
+		RightStickDown,
+		RightStickLeft,
+		RightStickRight,
+		Count
+	};
+
+	static_assert(Count <= 64, "The button mask is 64 bits wide");
+
+	/**
+	 * @brief Returns the mask bit for a button.
+	 */
+	constexpr uint64 Bit(const Type Button)
+	{
+		return 1ull << Button;
+	}
+
+	/**
+	 * @brief Buttons synthesized from analog stick deflection rather than read from the report.
+	 */
+	constexpr uint64 StickBits =
+	    Bit(LeftStickUp) | Bit(LeftStickDown) | Bit(LeftStickLeft) | Bit(LeftStickRight) |
+	    Bit(RightStickUp) | Bit(RightStickDown) | Bit(RightStickLeft) | Bit(RightStickRight);
+
+	/**
+	 * @brief Buttons read directly from the digital fields of an input report.
+	 */
+	constexpr uint64 DigitalBits = ((1ull << Count) - 1) & ~StickBits;
+
+	/**
+	 * @brief D-pad bits indexed by the 4-bit hat value of the report; 8 and above mean released.
+	 */
+	constexpr uint64 HatToDPad[16] = {
+	    Bit(DPadUp),
+	    Bit(DPadUp) | Bit(DPadRight),
+	    Bit(DPadRight),
+	    Bit(DPadRight) | Bit(DPadDown),
+	    Bit(DPadDown),
+	    Bit(DPadDown) | Bit(DPadLeft),
+	    Bit(DPadLeft),
+	    Bit(DPadLeft) | Bit(DPadUp),
+	    0, 0, 0, 0, 0, 0, 0, 0};
+} // namespace EGamepadButton
+
+/**
+ * @brief Packed pressed/released state of every button of one gamepad.
+ *
+ * Replaces per-button map lookups with a single 64-bit mask: the buttons that changed are found
+ * with one XOR against the previous mask and only those reach the message handler, iterated with
+ * count-trailing-zeros. Key names are resolved from a table built once, so the hot path performs
+ * no hashing and never constructs an FName.
+ */
+struct FGamepadButtonState
+{
+	/**
+	 * @brief Current state, one bit per EGamepadButton::Type.
+	 */
+	uint64 Mask = 0;
+
+	/**
+	 * @brief Returns the engine key name dispatched for a button.
+	 */
+	static const FName& GetKeyName(uint32 Button);
+
+	/**
+	 * @brief Replaces the state of a subset of buttons and dispatches an event for every bit that changed.
+	 *
+	 * @param NewMask The new state; only bits inside AffectedBits are taken into account.
+	 * @param AffectedBits The buttons described by NewMask. Other buttons keep their current state.
+	 * @param InMessageHandler The message handler receiving OnControllerButtonPressed/Released.
+	 * @param UserId The platform user ID associated with the controller.
+	 * @param InputDeviceId The unique identifier of the input device.
+	 * @param OutEvents If not null, receives one sub-frame event per edge.
+	 * @param Timestamp Arrival time stamped on recorded sub-frame events.
+	 */
+	void Update(uint64 NewMask, uint64 AffectedBits,
+	            const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+	            const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+	            TArray<FSubFrameInputEvent>* OutEvents = nullptr, double Timestamp = 0.0);
+
+	/**
+	 * @brief Clears all buttons without dispatching release events.
+	 */
+	void Reset()
+	{
+		Mask = 0;
+	}
+};
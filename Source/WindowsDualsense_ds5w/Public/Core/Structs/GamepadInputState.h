@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Compact, transport independent snapshot of one decoded input report.
+ *
+ * Produced by the report decoders from the raw HID bytes, so that the libraries never deal with
+ * report ids, Bluetooth headers or per-device offsets. Fields a device does not report keep their
+ * default value.
+ */
+struct FGamepadInputState
+{
+	/**
+	 * @brief Digital buttons, one bit per EGamepadButton::Type.
+	 */
+	uint64 Buttons = 0;
+	/**
+	 * @brief Raw stick axes, 0 to 255 with 128 at rest. Y grows downwards.
+	 */
+	uint8 LeftStickX = 128;
+	uint8 LeftStickY = 128;
+	uint8 RightStickX = 128;
+	uint8 RightStickY = 128;
+	/**
+	 * @brief Raw analog trigger travel, 0 to 255.
+	 */
+	uint8 LeftTrigger = 0;
+	uint8 RightTrigger = 0;
+	/**
+	 * @brief Raw gyroscope counts for the X, Y and Z axes.
+	 */
+	int16 Gyro[3] = {};
+	/**
+	 * @brief Raw accelerometer counts for the X, Y and Z axes.
+	 */
+	int16 Accel[3] = {};
+	/**
+	 * @brief Free-running hardware timestamp of the motion sample, in units of 1/3 microsecond. Wraps at 32 bits.
+	 */
+	uint32 SensorTimestamp = 0;
+	/**
+	 * @brief Raw touch point words: bit 7 is the inverted contact flag, bits 0-6 the id, then 12-bit X and Y.
+	 */
+	uint32 TouchPoints[2] = {0x80, 0x80};
+	/**
+	 * @brief Battery level in the low nibble and charge state in the high nibble.
+	 */
+	uint8 BatteryStatus = 0;
+	/**
+	 * @brief Peripheral flags; bit 0 signals a headset plugged into the controller.
+	 */
+	uint8 PeripheralStatus = 0;
+	/**
+	 * @brief Power flags; bit 5 signals that the controller is charging.
+	 */
+	uint8 ChargingStatus = 0;
+};
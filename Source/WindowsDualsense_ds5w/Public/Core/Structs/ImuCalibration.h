@@ -0,0 +1,81 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Per-unit motion sensor calibration, as stored by the factory in the controller.
+ *
+ * Every axis is corrected as (Raw - Bias) * Scale. The result is expressed in the nominal sensor
+ * resolution (1024 counts per deg/s for the gyroscope, 8192 counts per g for the accelerometer),
+ * so downstream code keeps converting with the nominal constants while benefiting from the
+ * individual sensitivity of each unit. A default constructed calibration is the identity.
+ */
+struct FImuCalibration
+{
+	/**
+	 * @brief Size of the DualSense calibration feature report, including the report id.
+	 */
+	static constexpr int32 DualSenseReportSize = 41;
+	/**
+	 * @brief Report id of the DualSense calibration feature report.
+	 */
+	static constexpr uint8 DualSenseReportId = 0x05;
+
+	/**
+	 * @brief Raw offsets subtracted from the gyroscope and accelerometer axes, in counts.
+	 */
+	float GyroBias[3] = {0.0f, 0.0f, 0.0f};
+	float AccelBias[3] = {0.0f, 0.0f, 0.0f};
+	/**
+	 * @brief Per-axis factors mapping the unbiased counts onto the nominal resolution.
+	 */
+	float GyroScale[3] = {1.0f, 1.0f, 1.0f};
+	float AccelScale[3] = {1.0f, 1.0f, 1.0f};
+	/**
+	 * @brief True when the coefficients come from the controller rather than the identity default.
+	 */
+	bool bFromDevice = false;
+
+	/**
+	 * @brief Applies the calibration to a raw gyroscope sample.
+	 *
+	 * @param Raw Raw X, Y and Z counts.
+	 * @return The corrected sample, in nominal counts.
+	 */
+	FVector CalibrateGyro(const int16 Raw[3]) const
+	{
+		return FVector((Raw[0] - GyroBias[0]) * GyroScale[0],
+		               (Raw[1] - GyroBias[1]) * GyroScale[1],
+		               (Raw[2] - GyroBias[2]) * GyroScale[2]);
+	}
+
+	/**
+	 * @brief Applies the calibration to a raw accelerometer sample.
+	 *
+	 * @param Raw Raw X, Y and Z counts.
+	 * @return The corrected sample, in nominal counts.
+	 */
+	FVector CalibrateAccel(const int16 Raw[3]) const
+	{
+		return FVector((Raw[0] - AccelBias[0]) * AccelScale[0],
+		               (Raw[1] - AccelBias[1]) * AccelScale[1],
+		               (Raw[2] - AccelBias[2]) * AccelScale[2]);
+	}
+
+	/**
+	 * @brief Parses the DualSense calibration feature report (0x05).
+	 *
+	 * Follows the layout used by the Linux hid-playstation driver. Reports with degenerate
+	 * ranges, as sent by some clones, are rejected so the caller keeps the identity calibration.
+	 *
+	 * @param Report Raw feature report bytes, starting at the report id.
+	 * @param Length Number of valid bytes in Report.
+	 * @param OutCalibration Receives the coefficients on success.
+	 * @return True if the report was valid.
+	 */
+	static bool ParseDualSense(const unsigned char* Report, int32 Length, FImuCalibration& OutCalibration);
+};
@@ -0,0 +1,38 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SubFrameInputEvent.generated.h"
+
+/**
+ * @brief A single button edge decoded from one HID input report.
+ *
+ * When sub-frame input is enabled, every report received between two game frames is decoded and each
+ * press or release is recorded with the time the report arrived. Gameplay code that needs the precise
+ * ordering of fast inputs (rhythm or fighting game windows) can read these events instead of relying
+ * on per-frame button state.
+ */
+USTRUCT(BlueprintType)
+struct FSubFrameInputEvent
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Key name of the button, matching the name sent to OnControllerButtonPressed/Released.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "SonyGamepad|Input")
+	FName Button = NAME_None;
+	/**
+	 * @brief True for a press edge, false for a release edge.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "SonyGamepad|Input")
+	bool bPressed = false;
+	/**
+	 * @brief Arrival time of the report that produced the edge, in FPlatformTime::Seconds().
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "SonyGamepad|Input")
+	double Timestamp = 0.0;
+};
@@ -0,0 +1,157 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * @brief One audio haptic frame: 32 interleaved stereo samples, the payload of a single haptic report.
+ */
+struct FHapticFrame
+{
+	static constexpr int32 Size = 64;
+
+	int8 Samples[Size] = {};
+};
+
+/**
+ * @brief Preallocated single-producer / single-consumer ring of haptic frames that drops the oldest frame on overflow.
+ *
+ * The producer (the audio render thread) never blocks, never allocates and never waits for the consumer:
+ * when the ring is full it simply overwrites the oldest slot. The consumer copies a slot out and then
+ * checks that the producer did not start overwriting it meanwhile, retrying with a newer frame if it did,
+ * the same validation a seqlock uses. Slot contents are stored as relaxed 64-bit atomics, so a torn copy
+ * is detected and discarded rather than being a data race.
+ *
+ * @note Exactly one thread may act as producer and exactly one as consumer at any given time.
+ */
+class FHapticFrameRing
+{
+public:
+	/**
+	 * @brief Number of slots, a power of two. Each submix buffer yields about two frames, so this covers roughly 300 ms.
+	 */
+	static constexpr uint64 Capacity = 32;
+
+	FHapticFrameRing() = default;
+	FHapticFrameRing(const FHapticFrameRing&) = delete;
+	FHapticFrameRing& operator=(const FHapticFrameRing&) = delete;
+
+	/**
+	 * @brief Appends a frame, overwriting the oldest one if the consumer fell behind. Producer only.
+	 *
+	 * @param Samples FHapticFrame::Size samples to copy into the ring.
+	 */
+	void Push(const int8* Samples)
+	{
+		const uint64 Index = Claimed.load(std::memory_order_relaxed);
+		// Announce the write before touching the slot, so a consumer copying it can tell.
+		Claimed.store(Index + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		FSlot& Slot = Slots[Index & (Capacity - 1)];
+		for (int32 Word = 0; Word < WordsPerFrame; ++Word)
+		{
+			uint64 Value;
+			FMemory::Memcpy(&Value, Samples + Word * sizeof(uint64), sizeof(uint64));
+			Slot.Words[Word].store(Value, std::memory_order_relaxed);
+		}
+
+		Committed.store(Index + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Removes the oldest frame still in the ring. Consumer only.
+	 *
+	 * @param OutFrame Receives the frame.
+	 * @return False if the ring is empty.
+	 */
+	bool Pop(FHapticFrame& OutFrame)
+	{
+		for (;;)
+		{
+			const uint64 Available = Committed.load(std::memory_order_acquire);
+			if (ReadIndex == Available)
+			{
+				return false;
+			}
+			if (Available - ReadIndex > Capacity)
+			{
+				DroppedFrames.fetch_add(Available - Capacity - ReadIndex, std::memory_order_relaxed);
+				ReadIndex = Available - Capacity;
+			}
+
+			const FSlot& Slot = Slots[ReadIndex & (Capacity - 1)];
+			for (int32 Word = 0; Word < WordsPerFrame; ++Word)
+			{
+				const uint64 Value = Slot.Words[Word].load(std::memory_order_relaxed);
+				FMemory::Memcpy(OutFrame.Samples + Word * sizeof(uint64), &Value, sizeof(uint64));
+			}
+
+			// The slot is reused by frame ReadIndex + Capacity; if that write had started, the copy may be torn.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (Claimed.load(std::memory_order_relaxed) - ReadIndex <= Capacity)
+			{
+				++ReadIndex;
+				return true;
+			}
+
+			DroppedFrames.fetch_add(1, std::memory_order_relaxed);
+			++ReadIndex;
+		}
+	}
+
+	/**
+	 * @brief Number of frames waiting to be read. Consumer only.
+	 */
+	uint64 Num() const
+	{
+		return FMath::Min(Committed.load(std::memory_order_acquire) - ReadIndex, Capacity);
+	}
+
+	/**
+	 * @brief Discards up to Count of the oldest frames. Consumer only.
+	 */
+	void Skip(const uint64 Count)
+	{
+		const uint64 Available = Committed.load(std::memory_order_acquire);
+		const uint64 Oldest = Available - FMath::Min(Available - ReadIndex, Capacity);
+		ReadIndex = FMath::Min(Oldest + Count, Available);
+	}
+
+	/**
+	 * @brief Discards every frame currently in the ring. Consumer only.
+	 */
+	void Empty()
+	{
+		ReadIndex = Committed.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Number of frames overwritten before the consumer could read them.
+	 */
+	uint64 GetDroppedFrameCount() const
+	{
+		return DroppedFrames.load(std::memory_order_relaxed);
+	}
+
+private:
+	static constexpr int32 WordsPerFrame = FHapticFrame::Size / sizeof(uint64);
+
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+	{
+		std::atomic<uint64> Words[WordsPerFrame] = {};
+	};
+
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+	static_assert(FHapticFrame::Size % sizeof(uint64) == 0, "Frames are copied in 64-bit words.");
+
+	FSlot Slots[Capacity];
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Claimed{0};
+	std::atomic<uint64> Committed{0};
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint64 ReadIndex = 0;
+	std::atomic<uint64> DroppedFrames{0};
+};
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "InputCoreTypes.h"
+#include <atomic>
+
+class FEvent;
+class FHapticFrameRing;
+class FRunnableThread;
+
+/**
+ * @brief Snapshot of the counters of a haptics pacer.
+ */
+struct FHapticsPacerStats
+{
+	/**
+	 * @brief Audio haptic reports handed to the controller.
+	 */
+	uint32 SentPackets = 0;
+	/**
+	 * @brief Times a report was due while the jitter buffer was empty.
+	 */
+	uint32 Underruns = 0;
+	/**
+	 * @brief Times the jitter buffer grew too deep and was trimmed back to its target.
+	 */
+	uint32 Overruns = 0;
+	/**
+	 * @brief Frames discarded by those trims.
+	 */
+	uint32 TrimmedFrames = 0;
+	/**
+	 * @brief Frames the audio thread overwrote before they were read.
+	 */
+	uint64 RingDroppedFrames = 0;
+	/**
+	 * @brief Current target depth of the jitter buffer, in frames.
+	 */
+	int32 TargetDepth = 0;
+};
+
+/**
+ * @brief Per-device thread that sends audio haptic reports on a steady cadence.
+ *
+ * The audio thread produces haptic frames in bursts of one submix buffer, so draining them from the
+ * game thread ticker sent several reports back to back and then nothing until the next frame. The
+ * pacer instead sends one frame every PacketPeriod seconds, the time a frame lasts at the haptic
+ * sample rate, against absolute deadlines so the cadence does not drift.
+ *
+ * The frame ring doubles as an adaptive jitter buffer: sending starts once TargetDepth frames are
+ * queued; an underrun re-primes the buffer and raises the target, a long run without underruns lowers
+ * it again, and a buffer that grew well past the target is trimmed to bound the latency.
+ */
+class FHapticsPacerThread final : public FRunnable
+{
+public:
+	/**
+	 * @param InDeviceId The device the reports are sent to.
+	 * @param InFrames The ring the frames are read from. The pacer becomes its only consumer and must not outlive it.
+	 * @param InPacketPeriod Duration of one frame, in seconds.
+	 */
+	FHapticsPacerThread(FInputDeviceId InDeviceId, FHapticFrameRing& InFrames, double InPacketPeriod);
+	virtual ~FHapticsPacerThread() override;
+	/**
+	 * @brief Spawns the underlying OS thread.
+	 *
+	 * @return True if the thread was created successfully.
+	 */
+	bool Start();
+	/**
+	 * @brief Requests the thread to stop and blocks until it has exited.
+	 */
+	void Shutdown();
+	/**
+	 * @brief Returns the current counters. Safe to call from any thread.
+	 */
+	FHapticsPacerStats GetStats() const;
+
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	static constexpr int32 MinTargetDepth = 1;
+	static constexpr int32 InitialTargetDepth = 2;
+	static constexpr int32 MaxTargetDepth = 6;
+	/**
+	 * @brief Frames above the target tolerated before the buffer is trimmed.
+	 */
+	static constexpr int32 OverrunSlack = 3;
+	/**
+	 * @brief Consecutive reports without underrun after which the target is lowered, about ten seconds.
+	 */
+	static constexpr int32 StablePacketsToShrink = 1000;
+	/**
+	 * @brief Lateness, in periods, after which the schedule restarts from now instead of catching up.
+	 */
+	static constexpr int32 MaxLatePeriods = 4;
+
+	/**
+	 * @brief Blocks until Deadline, in FPlatformTime::Seconds() time, or until a stop is requested.
+	 *
+	 * Sleeps on the wake event only, never spinning, so it returns within about half a millisecond of
+	 * Deadline, early or late; the jitter buffer absorbs that.
+	 */
+	void WaitUntil(double Deadline) const;
+	/**
+	 * @brief Runs one period: maintains the jitter buffer and sends at most one frame.
+	 */
+	void SendNext();
+
+	FInputDeviceId DeviceId;
+	FHapticFrameRing& Frames;
+	double PacketPeriod;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopRequested{false};
+
+	bool bPrimed = false;
+	int32 StablePackets = 0;
+	std::atomic<int32> TargetDepth{InitialTargetDepth};
+	std::atomic<uint32> SentPackets{0};
+	std::atomic<uint32> Underruns{0};
+	std::atomic<uint32> Overruns{0};
+	std::atomic<uint32> TrimmedFrames{0};
+};
@@ -0,0 +1,141 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "Containers/CircularQueue.h"
+#include "Core/Structs/DeviceContext.h"
+#include "Core/Threads/LockFreeTripleBuffer.h"
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FRunnableThread;
+
+/**
+ * @brief A single raw HID input report as delivered by the platform layer.
+ *
+ * The payload is sized for the largest report the plugin reads (DualShock 4 over Bluetooth),
+ * so the same slot type can be used for every supported device and connection.
+ */
+struct FInputReport
+{
+	/**
+	 * @brief Raw report bytes, including the report id at index 0.
+	 */
+	unsigned char Data[547] = {};
+	/**
+	 * @brief Number of valid bytes in Data.
+	 */
+	int32 Length = 0;
+	/**
+	 * @brief Time at which the report was received, in FPlatformTime::Seconds().
+	 */
+	double Timestamp = 0.0;
+};
+
+/**
+ * @brief Long-lived reader thread that owns all input reads for one device.
+ *
+ * The thread blocks on IPlatformHardwareInfoInterface::Read and publishes every complete report
+ * through a lock-free triple buffer. The game thread picks up the newest report with ConsumeLatest()
+ * without ever waiting on I/O or observing a report that is still being written.
+ *
+ * When report queueing is enabled, every report is additionally pushed into a bounded single-producer
+ * single-consumer ring so the game thread can replay all reports received since the previous frame.
+ */
+class FInputReaderThread final : public FRunnable
+{
+public:
+	/**
+	 * @brief Creates a reader for the given device context. The thread is not started until Start() is called.
+	 *
+	 * @param InContext The device context owning the handles to read from. Must outlive the reader.
+	 */
+	explicit FInputReaderThread(FDeviceContext* InContext);
+	virtual ~FInputReaderThread() override;
+	/**
+	 * @brief Spawns the underlying OS thread.
+	 *
+	 * @return True if the thread was created successfully.
+	 */
+	bool Start();
+	/**
+	 * @brief Requests the thread to stop and blocks until it has exited.
+	 *
+	 * Must be called before the handles in the device context are invalidated.
+	 */
+	void Shutdown();
+	/**
+	 * @brief Makes the most recently published report available through GetLatest().
+	 *
+	 * @return True if a report newer than the previous one was picked up.
+	 */
+	bool ConsumeLatest();
+	/**
+	 * @brief Returns the report selected by the last successful ConsumeLatest() call.
+	 */
+	const FInputReport& GetLatest() const;
+	/**
+	 * @brief Enables or disables queueing of every received report for DequeueReport().
+	 *
+	 * Enabling the queue discards anything left over from a previous session, so the first
+	 * replay only contains reports received after this call.
+	 *
+	 * @param bEnable True to queue every report, false to only publish the newest one.
+	 */
+	void SetQueueAllReports(bool bEnable);
+	/**
+	 * @brief Pops the oldest queued report, in arrival order.
+	 *
+	 * @param OutReport Receives the report.
+	 * @return True if a report was available.
+	 */
+	bool DequeueReport(FInputReport& OutReport);
+	/**
+	 * @brief Number of reports dropped because the game thread did not drain the queue in time.
+	 */
+	uint32 GetDroppedReportCount() const;
+	/**
+	 * @brief Indicates whether the platform layer reported the device as gone.
+	 *
+	 * Once set, the reader stops issuing reads; the device registry removes the instance
+	 * on its next detection pass.
+	 */
+	bool IsDeviceLost() const;
+	/**
+	 * @brief Returns the input report length expected for the device type and connection of a context.
+	 */
+	static int32 GetInputReportLength(const FDeviceContext& Context);
+
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	/**
+	 * @brief Upper bound for a single blocking read, so stop requests are honoured promptly.
+	 */
+	static constexpr int32 ReadTimeoutMs = 100;
+	/**
+	 * @brief Pause after a read that failed right away, so a persistent error does not spin the thread.
+	 */
+	static constexpr float TransientErrorBackoffSeconds = 0.005f;
+	/**
+	 * @brief Consecutive failed reads, about a second of them, after which the device is treated as lost.
+	 */
+	static constexpr int32 MaxConsecutiveTransientErrors = 200;
+	/**
+	 * @brief Capacity of the report queue; enough for more than 100 ms of reports at 1 kHz.
+	 */
+	static constexpr uint32 QueuedReportCapacity = 128;
+
+	FDeviceContext* Context;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopRequested{false};
+	std::atomic<bool> bDeviceLost{false};
+	std::atomic<bool> bQueueAllReports{false};
+	std::atomic<uint32> DroppedReports{0};
+	TLockFreeTripleBuffer<FInputReport> Reports;
+	TCircularQueue<FInputReport> QueuedReports;
+};
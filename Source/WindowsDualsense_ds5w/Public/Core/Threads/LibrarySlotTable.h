@@ -0,0 +1,327 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "InputCoreTypes.h"
+#include <atomic>
+
+class ISonyGamepadInterface;
+
+/**
+ * @brief Table of controller libraries indexed directly by input device id.
+ *
+ * Device ids handed out by the platform input device mapper are consecutive integers, so the id
+ * itself is the slot index. Slots live in fixed-size chunks that are allocated the first time an id
+ * in their range is stored and kept until the table is destroyed, so the table grows with the ids in
+ * use while a lookup stays two atomic loads. It is written by one owner thread, the game thread, and
+ * read from any thread without locks.
+ *
+ * Readers on other threads pin a slot for the duration of a call. Remove() unpublishes the library
+ * without waiting; the library is handed back by CollectRetired() once the pins taken before it was
+ * removed have been released, so the owner never blocks on a reader, e.g. a pacer in the middle of a
+ * blocking Bluetooth write, and shuts the library down only when no other thread still uses it.
+ */
+class FLibrarySlotTable
+{
+	struct FSlot
+	{
+		std::atomic<ISonyGamepadInterface*> Library{nullptr};
+		std::atomic<int32> Readers{0};
+	};
+
+public:
+	/**
+	 * @brief Number of slots allocated at once.
+	 */
+	static constexpr int32 ChunkSize = 64;
+	/**
+	 * @brief Largest number of chunks; device ids at or above ChunkSize * MaxChunks cannot be stored.
+	 */
+	static constexpr int32 MaxChunks = 1024;
+	static constexpr int32 Capacity = ChunkSize * MaxChunks;
+
+	/**
+	 * @brief A library pinned by Pin(); it is not retired while a pin is held. Keep pins short-lived.
+	 */
+	class FPinned
+	{
+	public:
+		FPinned() = default;
+		FPinned(const FPinned&) = delete;
+		FPinned& operator=(const FPinned&) = delete;
+		FPinned(FPinned&& Other) noexcept
+		    : Readers(Other.Readers)
+		    , Library(Other.Library)
+		{
+			Other.Readers = nullptr;
+			Other.Library = nullptr;
+		}
+		FPinned& operator=(FPinned&& Other) noexcept
+		{
+			if (this != &Other)
+			{
+				Release();
+				Readers = Other.Readers;
+				Library = Other.Library;
+				Other.Readers = nullptr;
+				Other.Library = nullptr;
+			}
+			return *this;
+		}
+		~FPinned()
+		{
+			Release();
+		}
+
+		ISonyGamepadInterface* Get() const
+		{
+			return Library;
+		}
+		ISonyGamepadInterface* operator->() const
+		{
+			return Library;
+		}
+		explicit operator bool() const
+		{
+			return Library != nullptr;
+		}
+		/**
+		 * @brief Unpins the library early.
+		 */
+		void Release()
+		{
+			if (Readers)
+			{
+				Readers->fetch_sub(1, std::memory_order_release);
+				Readers = nullptr;
+			}
+			Library = nullptr;
+		}
+
+	private:
+		friend class FLibrarySlotTable;
+
+		FPinned(std::atomic<int32>* InReaders, ISonyGamepadInterface* InLibrary)
+		    : Readers(InReaders)
+		    , Library(InLibrary)
+		{
+		}
+
+		std::atomic<int32>* Readers = nullptr;
+		ISonyGamepadInterface* Library = nullptr;
+	};
+
+	FLibrarySlotTable() = default;
+	FLibrarySlotTable(const FLibrarySlotTable&) = delete;
+	FLibrarySlotTable& operator=(const FLibrarySlotTable&) = delete;
+	~FLibrarySlotTable()
+	{
+		for (std::atomic<FChunk*>& Chunk : Chunks)
+		{
+			delete Chunk.load(std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @brief Returns the library stored for a device without pinning it.
+	 *
+	 * Only the owner thread may use the result beyond the call, since only it can retire the library.
+	 */
+	ISonyGamepadInterface* Find(const FInputDeviceId& DeviceId) const
+	{
+		const FSlot* Slot = FindSlot(DeviceId);
+		return Slot ? Slot->Library.load(std::memory_order_acquire) : nullptr;
+	}
+
+	/**
+	 * @brief Returns the library stored for a device, pinned until the returned handle is released. Any thread.
+	 */
+	FPinned Pin(const FInputDeviceId& DeviceId)
+	{
+		FSlot* Slot = FindSlot(DeviceId);
+		if (!Slot)
+		{
+			return FPinned();
+		}
+
+		// Announce the reader before loading the pointer: Remove() unpublishes before CollectRetired() counts
+		// readers, so either the library is kept until this pin is released, or this load already sees it gone.
+		Slot->Readers.fetch_add(1, std::memory_order_seq_cst);
+		ISonyGamepadInterface* Library = Slot->Library.load(std::memory_order_seq_cst);
+		if (!Library)
+		{
+			Slot->Readers.fetch_sub(1, std::memory_order_release);
+			return FPinned();
+		}
+		return FPinned(&Slot->Readers, Library);
+	}
+
+	/**
+	 * @brief Stores the library of a device, allocating the chunk of its slot if needed. Owner thread only.
+	 *
+	 * @return False if the device id is beyond Capacity or the slot is taken.
+	 */
+	bool Add(const FInputDeviceId& DeviceId, ISonyGamepadInterface* Library)
+	{
+		const int32 Id = DeviceId.GetId();
+		if (Id < 0 || Id >= Capacity || !Library)
+		{
+			return false;
+		}
+
+		std::atomic<FChunk*>& ChunkEntry = Chunks[Id / ChunkSize];
+		FChunk* Chunk = ChunkEntry.load(std::memory_order_relaxed);
+		if (!Chunk)
+		{
+			Chunk = new FChunk();
+			ChunkEntry.store(Chunk, std::memory_order_release);
+		}
+
+		FSlot& Slot = Chunk->Slots[Id % ChunkSize];
+		if (Slot.Library.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		Slot.Library.store(Library, std::memory_order_release);
+		Count.fetch_add(1, std::memory_order_relaxed);
+		HighWater = FMath::Max(HighWater, Id + 1);
+		return true;
+	}
+
+	/**
+	 * @brief Unpublishes the library of a device without waiting for its readers. Owner thread only.
+	 *
+	 * The library is no longer returned by Find() or Pin(), but other threads may still hold a pin
+	 * on it: it must not be shut down before CollectRetired() hands it back.
+	 *
+	 * @return The removed library, or null if the slot was empty.
+	 */
+	ISonyGamepadInterface* Remove(const FInputDeviceId& DeviceId)
+	{
+		FSlot* Slot = FindSlot(DeviceId);
+		if (!Slot)
+		{
+			return nullptr;
+		}
+
+		ISonyGamepadInterface* Library = Slot->Library.exchange(nullptr, std::memory_order_seq_cst);
+		if (!Library)
+		{
+			return nullptr;
+		}
+
+		Count.fetch_sub(1, std::memory_order_relaxed);
+		Retired.Add({Slot, Library});
+		return Library;
+	}
+
+	/**
+	 * @brief Calls Functor(Library) for every removed library no other thread has pinned anymore, then
+	 *        forgets it. Owner thread only; never blocks.
+	 *
+	 * A new library stored in the same slot meanwhile shares the reader count, which can only delay
+	 * the retirement, never make it early.
+	 */
+	template <typename FunctorType>
+	void CollectRetired(FunctorType&& Functor)
+	{
+		for (int32 Index = Retired.Num() - 1; Index >= 0; --Index)
+		{
+			if (Retired[Index].Slot->Readers.load(std::memory_order_seq_cst) == 0)
+			{
+				ISonyGamepadInterface* Library = Retired[Index].Library;
+				Retired.RemoveAtSwap(Index);
+				Functor(Library);
+			}
+		}
+	}
+
+	/**
+	 * @brief Like CollectRetired(), but waits until every removed library was handed back. Owner thread only.
+	 *
+	 * Meant for shutdown, when nothing can defer the retirement to a later tick.
+	 */
+	template <typename FunctorType>
+	void FlushRetired(FunctorType&& Functor)
+	{
+		CollectRetired(Functor);
+		while (Retired.Num() > 0)
+		{
+			FPlatformProcess::YieldThread();
+			CollectRetired(Functor);
+		}
+	}
+
+	/**
+	 * @brief Number of stored libraries, not counting removed ones waiting to be retired.
+	 */
+	int32 Num() const
+	{
+		return Count.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Calls Functor(DeviceId, Library) for every stored library, in device id order. Owner thread only.
+	 */
+	template <typename FunctorType>
+	void ForEach(FunctorType&& Functor) const
+	{
+		for (int32 ChunkIndex = 0; ChunkIndex * ChunkSize < HighWater; ++ChunkIndex)
+		{
+			const FChunk* Chunk = Chunks[ChunkIndex].load(std::memory_order_relaxed);
+			if (!Chunk)
+			{
+				continue;
+			}
+			for (int32 SlotIndex = 0; SlotIndex < ChunkSize; ++SlotIndex)
+			{
+				if (ISonyGamepadInterface* Library = Chunk->Slots[SlotIndex].Library.load(std::memory_order_relaxed))
+				{
+					Functor(FInputDeviceId::CreateFromInternalId(ChunkIndex * ChunkSize + SlotIndex), Library);
+				}
+			}
+		}
+	}
+
+private:
+	struct FChunk
+	{
+		FSlot Slots[ChunkSize];
+	};
+
+	/**
+	 * @brief A removed library and the slot whose readers it waits for.
+	 */
+	struct FRetired
+	{
+		FSlot* Slot;
+		ISonyGamepadInterface* Library;
+	};
+
+	FSlot* FindSlot(const FInputDeviceId& DeviceId) const
+	{
+		const int32 Id = DeviceId.GetId();
+		if (Id < 0 || Id >= Capacity)
+		{
+			return nullptr;
+		}
+		FChunk* Chunk = Chunks[Id / ChunkSize].load(std::memory_order_acquire);
+		return Chunk ? &Chunk->Slots[Id % ChunkSize] : nullptr;
+	}
+
+	std::atomic<FChunk*> Chunks[MaxChunks] = {};
+	std::atomic<int32> Count{0};
+	/**
+	 * @brief One past the highest device id ever stored; bounds ForEach() to the ids actually handed out.
+	 */
+	int32 HighWater = 0;
+	/**
+	 * @brief Removed libraries waiting for their pins to be released. Owner thread only.
+	 */
+	TArray<FRetired> Retired;
+};
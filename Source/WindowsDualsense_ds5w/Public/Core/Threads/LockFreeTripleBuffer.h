@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * @brief Single-producer / single-consumer triple buffer that always hands the consumer the newest complete value.
+ *
+ * The producer fills the slot returned by GetWriteBuffer() and calls Publish(); the consumer calls Consume()
+ * and then reads GetReadBuffer(). The three slots are exchanged through a single atomic index, so neither
+ * side ever blocks, the consumer never observes a partially written value, and intermediate values that the
+ * consumer did not pick up in time are simply overwritten (latest wins).
+ *
+ * @note Exactly one thread may act as producer and exactly one as consumer at any given time.
+ */
+template <typename T>
+class TLockFreeTripleBuffer
+{
+public:
+	TLockFreeTripleBuffer() = default;
+	TLockFreeTripleBuffer(const TLockFreeTripleBuffer&) = delete;
+	TLockFreeTripleBuffer& operator=(const TLockFreeTripleBuffer&) = delete;
+
+	/**
+	 * @brief Returns the slot owned by the producer. Only valid until the next call to Publish().
+	 */
+	T& GetWriteBuffer()
+	{
+		return Buffers[WriteIndex];
+	}
+
+	/**
+	 * @brief Publishes the producer slot as the newest value and takes ownership of the spare slot.
+	 */
+	void Publish()
+	{
+		const uint8 Previous = Shared.exchange(WriteIndex | DirtyBit, std::memory_order_acq_rel);
+		WriteIndex = Previous & IndexMask;
+	}
+
+	/**
+	 * @brief Swaps the newest published value into the consumer slot.
+	 *
+	 * @return True if a value newer than the current read slot was available, false otherwise.
+	 */
+	bool Consume()
+	{
+		if ((Shared.load(std::memory_order_relaxed) & DirtyBit) == 0)
+		{
+			return false;
+		}
+
+		const uint8 Previous = Shared.exchange(ReadIndex, std::memory_order_acq_rel);
+		ReadIndex = Previous & IndexMask;
+		return true;
+	}
+
+	/**
+	 * @brief Returns the slot owned by the consumer. Stable until the next successful call to Consume().
+	 */
+	const T& GetReadBuffer() const
+	{
+		return Buffers[ReadIndex];
+	}
+
+private:
+	static constexpr uint8 IndexMask = 0x03;
+	static constexpr uint8 DirtyBit = 0x04;
+
+	T Buffers[3] = {};
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint8> Shared{1};
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint8 WriteIndex = 0;
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint8 ReadIndex = 2;
+};
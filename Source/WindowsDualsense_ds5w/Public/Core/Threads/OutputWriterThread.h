@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "Core/Threads/LockFreeTripleBuffer.h"
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+struct FDeviceContext;
+
+/**
+ * @brief A fully composed HID output report, ready to be written as is.
+ */
+struct FOutputReport
+{
+	/**
+	 * @brief Raw report bytes, including the report id at index 0 and, over Bluetooth, the CRC.
+	 */
+	unsigned char Data[78] = {};
+	/**
+	 * @brief Number of valid bytes in Data.
+	 */
+	int32 Length = 0;
+};
+
+/**
+ * @brief Long-lived writer thread that owns all output report writes for one device.
+ *
+ * Producers compose a report and hand it over with Publish(), which never blocks. Reports travel
+ * through a lock-free triple buffer, so when the device is slower than the producer, e.g. a
+ * Bluetooth write stalling for several milliseconds, intermediate states are overwritten and only
+ * the newest one is sent once the device accepts data again.
+ */
+class FOutputWriterThread final : public FRunnable
+{
+public:
+	/**
+	 * @brief Creates a writer for the given device context. The thread is not started until Start() is called.
+	 *
+	 * @param InContext The device context owning the handle to write to. Must outlive the writer.
+	 */
+	explicit FOutputWriterThread(FDeviceContext* InContext);
+	virtual ~FOutputWriterThread() override;
+	/**
+	 * @brief Spawns the underlying OS thread.
+	 *
+	 * @return True if the thread was created successfully.
+	 */
+	bool Start();
+	/**
+	 * @brief Requests the thread to stop and blocks until it has exited.
+	 *
+	 * A report published before this call is still written. Must be called before the handles in
+	 * the device context are invalidated.
+	 */
+	void Shutdown();
+	/**
+	 * @brief Hands a composed report to the writer, replacing any report it has not sent yet.
+	 *
+	 * Must always be called from the same thread.
+	 *
+	 * @param Data Raw report bytes, starting at the report id.
+	 * @param Length Number of bytes to send. Truncated to the size of FOutputReport::Data.
+	 */
+	void Publish(const unsigned char* Data, int32 Length);
+	/**
+	 * @brief Number of published reports that were not written because a newer one replaced them.
+	 *
+	 * May transiently include the report currently waiting to be written.
+	 */
+	uint32 GetSupersededReportCount() const;
+	/**
+	 * @brief Number of reports the device accepted.
+	 */
+	uint32 GetSentReportCount() const;
+	/**
+	 * @brief Number of reports the device refused, e.g. a Bluetooth write that timed out.
+	 *
+	 * The composer watches this counter to send the current state again after a failed write.
+	 */
+	uint32 GetFailedWriteCount() const;
+	/**
+	 * @brief Returns the output report length expected for the device type and connection of a context.
+	 */
+	static int32 GetOutputReportLength(const FDeviceContext& Context);
+
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	/**
+	 * @brief Upper bound for a single wait, so stop requests are honoured even without a wake-up.
+	 */
+	static constexpr uint32 WaitTimeoutMs = 100;
+
+	/**
+	 * @brief Writes the newest published report, if any.
+	 */
+	void WritePending();
+
+	FDeviceContext* Context;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopRequested{false};
+	std::atomic<uint32> PublishedReports{0};
+	std::atomic<uint32> WrittenReports{0};
+	std::atomic<uint32> SentReports{0};
+	std::atomic<uint32> FailedWrites{0};
+	TLockFreeTripleBuffer<FOutputReport> Reports;
+};
@@ -161,16 +161,44 @@ public:
 private:
 	FInputDeviceId GetGamepadInterface(int32 ControllerId);
 	/**
-	 * Tracks the accumulated time or events between periodic polling operations.
-	 * This variable is typically used to manage timing or frequency of polling processes.
+	 * A connected Sony controller mapped to a user, as dispatched by Tick.
+	 */
+	struct FActiveDevice
+	{
+		FInputDeviceId DeviceId;
+		FPlatformUserId UserId;
+		/**
+		 * Hardware identifier reported through FInputDeviceScope, built once per controller model when
+		 * the list is rebuilt rather than on every tick.
+		 */
+		FString HardwareIdentifier;
+	};
+	/**
+	 * Rebuilds ActiveDevices from the device mapper. Only runs when the registry's mapping version changed.
+	 */
+	void RebuildActiveDevices();
+	/**
+	 * Sony controllers Tick dispatches input for, so the per-tick path neither queries the device mapper
+	 * nor allocates.
+	 */
+	TArray<FActiveDevice> ActiveDevices;
+	/**
+	 * Mapping version ActiveDevices was built for; see FDeviceRegistry::GetMappingVersion().
+	 */
+	uint32 ActiveDevicesVersion = 0;
+	bool bActiveDevicesBuilt = false;
+	/**
+	 * Tracks the time accumulated since the last input update was dispatched.
+	 * Devices are sampled at their native report rate by their input reader threads; this only
+	 * throttles how often the game thread decodes the newest state, as configured by
+	 * `ds.InputUpdateInterval`, and is passed as the delta of the update.
 	 */
 	float PollAccumulator = 0.0f;
 	/**
-	 * Defines the interval, in seconds, between periodic polling operations.
-	 * This variable determines how often certain tasks, such as device state checks
-	 * or updates, are performed within the system.
+	 * Tracks the time accumulated since pending output changes were last flushed to the controllers,
+	 * so that `ds.OutputMaxRate` can cap the number of output reports per second.
 	 */
-	float PollInterval = 0.033f;
+	float OutputAccumulator = 0.0f;
 	/**
 	 * Stores a mapping of connection states for devices, where the key represents
 	 * a device ID (int32) and the value indicates whether a connection change
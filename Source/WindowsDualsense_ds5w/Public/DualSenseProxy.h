@@ -115,6 +115,16 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "DualSense|Audio", meta = (DisplayName = "Unregister Submix"))
 	static void UnregisterSubmixForDevice(int32 ControllerId);
+	/**
+	 * @brief Sets the audio haptics gain of a DualSense controller registered to a submix.
+	 *
+	 * Controllers sharing a submix receive the same haptic stream; the gain scales it for this controller only.
+	 *
+	 * @param ControllerId The identifier for the connected DualSense controller.
+	 * @param Gain Linear gain between 0 and 4, where 1 plays the submix unchanged.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "DualSense|Audio", meta = (DisplayName = "Set Haptics Gain"))
+	static void SetHapticsGain(int32 ControllerId, float Gain = 1.0f);
 	/**
 	 * @brief Activates an automatic gun effect on a specified DualSense controller.
 	 *
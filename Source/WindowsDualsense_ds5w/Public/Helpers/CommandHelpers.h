@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "InputCoreTypes.h"
 
+class FVirtualDeviceInfo;
 class ISonyGamepadInterface;
 
 /**
@@ -16,6 +17,14 @@ class ISonyGamepadInterface;
  *  - ds.SetTrigL <DeviceId> <hex bytes...>
  *  - ds.DumpTrig <DeviceId>
  *  - ds.ClearTrig <DeviceId>
+ *  - ds.DumpOutputStats <DeviceId>
+ *  - ds.DumpHapticsStats <DeviceId>
+ *  - ds.BenchmarkCrc [Iterations]
+ *  - ds.BenchmarkHapticResampler [SampleRate] [Iterations]
+ *  - ds.Virtual.Plug [DualSense|Edge|DS4] [USB|BT]
+ *  - ds.Virtual.Unplug <Slot>
+ *  - ds.Virtual.Hold <Slot> [<LX> <LY> <RX> <RY> <L2> <R2> [FaceAndHat] [Misc] [Special]]
+ *  - ds.Virtual.DumpCaptures <Slot>
  */
 class WINDOWSDUALSENSE_DS5W_API FCommandHelpers
 {
@@ -36,10 +45,24 @@ public:
 	// Galloping effect convenience commands
 	static void HandleGallopTrigR(const TArray<FString>& Args);
 	static void HandleGallopTrigL(const TArray<FString>& Args);
+	// Output report statistics
+	static void HandleDumpOutputStats(const TArray<FString>& Args);
+	// Haptics pacing statistics
+	static void HandleDumpHapticsStats(const TArray<FString>& Args);
+	// CRC32 golden-vector check and microbenchmark
+	static void HandleBenchmarkCrc(const TArray<FString>& Args);
+	// Haptic resampler microbenchmark
+	static void HandleBenchmarkHapticResampler(const TArray<FString>& Args);
+	// Virtual controller backend
+	static void HandleVirtualPlug(const TArray<FString>& Args);
+	static void HandleVirtualUnplug(const TArray<FString>& Args);
+	static void HandleVirtualHold(const TArray<FString>& Args);
+	static void HandleVirtualDumpCaptures(const TArray<FString>& Args);
 
 private:
 	static bool ParseDeviceId(const TArray<FString>& Args, FInputDeviceId& OutDeviceId);
 	static ISonyGamepadInterface* GetGamepad(const FInputDeviceId& DeviceId);
 	static uint8 ClampByte(int32 V) { return static_cast<uint8>(FMath::Clamp(V, 0, 255)); }
 	static bool ParseHexByte(const FString& Token, uint8& OutByte);
+	static FVirtualDeviceInfo* GetVirtualBackend();
 };
@@ -6,6 +6,7 @@
 
 #include "Core/Enums/EDeviceCommons.h"
 #include "Core/Enums/EDeviceConnection.h"
+#include "Core/Structs/SubFrameInputEvent.h"
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
 #if PLATFORM_WINDOWS
@@ -114,6 +115,16 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "SonyGamepad|Motion Sensors")
 	static bool GetMotionSensorCalibrationStatus(int32 ControllerId, float& Progress);
+	/**
+	 * Retrieves the gyroscope offset estimated automatically while the controller rests.
+	 *
+	 * @param ControllerId The ID of the controller to query.
+	 * @param Bias Receives the per-axis bias in degrees per second.
+	 * @param Confidence Receives the confidence in the estimate, from 0 (none) to 1.
+	 * @return True if an estimate is available.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad|Motion Sensors")
+	static bool GetGyroBiasEstimate(int32 ControllerId, FVector& Bias, float& Confidence);
 	/**
 	 * Enables or disables the touch functionality on a specified DualSense controller.
 	 *
@@ -122,6 +133,26 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "SonyGamepad: Dualsense or DualShock Touch")
 	static void EnableTouch(int32 ControllerId, bool bEnableTouch);
+	/**
+	 * Enables or disables sub-frame input on a specified DualSense or DualShock controller.
+	 *
+	 * When enabled, every input report received between two frames is processed, so button presses
+	 * shorter than a frame are never lost and can be read back with GetSubFrameInputEvents.
+	 *
+	 * @param ControllerId The identifier of the controller to configure.
+	 * @param bEnableSubFrameInput True to process every input report, false to only process the newest one.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad: Dualsense or DualShock Input")
+	static void EnableSubFrameInput(int32 ControllerId, bool bEnableSubFrameInput);
+	/**
+	 * Retrieves the button presses and releases decoded during the last input update, in arrival order.
+	 *
+	 * @param ControllerId The identifier of the controller to query.
+	 * @param OutEvents Receives the events, each stamped with the arrival time of its input report.
+	 * @return True if the controller was found, false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad: Dualsense or DualShock Input")
+	static bool GetSubFrameInputEvents(int32 ControllerId, TArray<FSubFrameInputEvent>& OutEvents);
 	/**
 	 * Enables or disables the gyroscope functionality for a specified DualSense controller.
 	 *
@@ -5,10 +5,14 @@
 #pragma once
 
 #include "AudioResampler.h"
-#include "Containers/Queue.h"
+#include "Core/Algorithms/HapticDecimator.h"
 #include "Core/Structs/DeviceContext.h"
+#include "Core/Threads/HapticFrameRing.h"
+#include "Core/Threads/HapticsPacerThread.h"
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 #include "ISubmixBufferListener.h"
+#include <atomic>
 
 /**
  Class responsible for handling audio submix buffers and preparing audio data for haptic feedback systems.
@@ -16,20 +20,22 @@
  FAudioHapticsListener integrates with the audio rendering pipeline using the ISubmixBufferListener interface,
  allowing real-time access to submix audio buffers. The class supports processing, conversion, and resampling
  of audio data for use in haptic feedback hardware or systems. It includes mechanisms to manage resampling state
- and an internal queue for storing processed audio data.
+ and a preallocated ring of processed haptic frames.
+
+ One listener exists per submix: each buffer is resampled and quantized once, and the resulting packet stream is
+ fanned out to every subscribed device, each with its own frame ring, pacer thread and optional gain.
  */
 class FAudioHapticsListener : public ISubmixBufferListener
 {
 	/**
-	 Constructor for the FAudioHapticsListener class, initializing the listener with the given input device ID
-	 and audio submix reference.
+	 Constructor for the FAudioHapticsListener class, initializing the listener with the given audio submix reference.
+	 Devices are subscribed afterwards with AddDevice().
 
-	 @param InDeviceId The identifier for the input device associated with this haptics listener.
 	 @param InSubmix Pointer to the USoundSubmix object that this listener processes audio data from.
-	 @return An instance of FAudioHapticsListener initialized with the provided input device ID and submix reference.
+	 @return An instance of FAudioHapticsListener initialized with the provided submix reference.
 	 */
 public:
-	FAudioHapticsListener(FInputDeviceId InDeviceId, USoundSubmix* InSubmix);
+	explicit FAudioHapticsListener(USoundSubmix* InSubmix);
 
 	/**
 	 Determines if the audio processing system is actively rendering audio.
@@ -46,16 +52,49 @@ public:
 	}
 
 	/**
-	 Processes and consumes the current audio data in the haptics queue, sending it to the appropriate haptic feedback interface.
+	 Destroys the listener, stopping every pacer first since the pacers read from this listener's frame rings.
+	 */
+	virtual ~FAudioHapticsListener() override;
 
-	 This method retrieves audio packets from the internal queue and forwards them to a supported haptic feedback system, such as
-	 the Sony DualSense gamepad, through the relevant interface. Packets that could not be processed are discarded after the final
-	 flush of the queue.
+	/**
+	 Subscribes a device to the packet stream of this submix and starts the thread that sends its frames
+	 at the haptic sample rate. Subscribing a device twice only updates its gain.
 
-	 It integrates with device-specific haptic systems using interfaces like ISonyGamepadTriggerInterface to achieve real-time
-	 audio-haptic feedback conversion.
+	 @param InDeviceId The device that receives the haptic packets.
+	 @param Gain Linear gain applied to the device's samples, clamped to [0, MaxGain].
 	 */
-	void ConsumeHapticsQueue();
+	void AddDevice(FInputDeviceId InDeviceId, float Gain = 1.0f);
+	/**
+	 Unsubscribes a device, stopping its pacing thread and waiting for it to exit.
+
+	 @return True if the device was subscribed.
+	 */
+	bool RemoveDevice(FInputDeviceId InDeviceId);
+	/**
+	 Unsubscribes every device and stops all pacing threads.
+	 */
+	void RemoveAllDevices();
+	/**
+	 Indicates whether at least one device is subscribed.
+	 */
+	bool HasDevices() const;
+	/**
+	 Changes the gain of a subscribed device. Takes effect with the next packet.
+
+	 @param InDeviceId The subscribed device.
+	 @param Gain Linear gain, clamped to [0, MaxGain]; 1 leaves the samples untouched.
+	 */
+	void SetDeviceGain(FInputDeviceId InDeviceId, float Gain);
+	/**
+	 Returns the jitter buffer counters of the pacer of a subscribed device.
+
+	 @return False if the device is not subscribed.
+	 */
+	bool GetPacingStats(FInputDeviceId InDeviceId, FHapticsPacerStats& OutStats) const;
+	/**
+	 Largest per-device gain accepted by AddDevice() and SetDeviceGain().
+	 */
+	static constexpr float MaxGain = 4.0f;
 
 	/**
 	 Returns the associated audio submix instance.
@@ -82,16 +121,115 @@ public:
 	*/
 	virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock) override;
 	/**
-	 A thread-safe queue used for storing audio packets to be processed within the audio rendering pipeline.
-
-	 AudioPacketQueue is implemented as a multiple-producer single-consumer (MPSC) queue, allowing audio packets
-	 to be enqueued by multiple threads and dequeued by a single consumer thread. This design is optimized for
-	 high-performance, concurrent audio processing workflows. The queue holds arrays of int8, which represent
-	 raw audio data packets. These packets can be used for real-time processing, such as resampling or formatting
-	 for haptic feedback systems.
+	 A device subscribed to the packet stream of this submix.
 	 */
 private:
-	TQueue<TArray<int8>, EQueueMode::Spsc> AudioPacketQueue;
+	static constexpr int32 UnityGain = 256;
+	struct FSubscriber
+	{
+		FInputDeviceId DeviceId;
+		/**
+		 Haptic frames produced on the audio render thread and waiting to be sent to the controller.
+
+		 Fixed-size and preallocated, so the audio thread never allocates; when the consumer falls behind, the
+		 oldest frames are overwritten, since late haptics are worse than missing ones.
+		 */
+		FHapticFrameRing Frames;
+		/**
+		 Thread draining Frames on a steady cadence.
+		 */
+		TUniquePtr<FHapticsPacerThread> Pacer;
+		/**
+		 Gain in 8.8 fixed point, applied as an integer scale of the quantized samples; UnityGain skips the scaling.
+		 */
+		std::atomic<int32> GainQ8{UnityGain};
+	};
+	/**
+	 Immutable list of the subscribers FanOut() pushes to, replaced as a whole on every subscription change.
+	 */
+	struct FSubscriberSnapshot
+	{
+		TArray<FSubscriber*> Subscribers;
+	};
+	/**
+	 Converts a linear gain to the 8.8 fixed point used by FSubscriber::GainQ8.
+	 */
+	static int32 ToGainQ8(float Gain);
+	/**
+	 Pushes a complete packet to the frame ring of every subscriber in the published snapshot, scaled by its gain.
+	 Audio render thread only; takes no lock.
+	 */
+	void FanOut(const FHapticFrame& Packet);
+	/**
+	 Publishes a snapshot of Subscribers to FanOut() and frees the previous one once the audio thread cannot
+	 be reading it anymore. Caller holds SubscribersLock.
+	 */
+	void PublishSnapshot();
+	/**
+	 Subscribed devices. Heap-allocated so the rings keep their address for the pacers while the array changes.
+	 */
+	TArray<TUniquePtr<FSubscriber>> Subscribers;
+	/**
+	 Guards Subscribers and Snapshot against concurrent subscription changes. Never taken on the audio thread;
+	 pacers are started and stopped outside of it.
+	 */
+	mutable FCriticalSection SubscribersLock;
+	/**
+	 Owner of the snapshot currently published in PublishedSnapshot.
+	 */
+	TUniquePtr<FSubscriberSnapshot> Snapshot;
+	/**
+	 Snapshot read by FanOut(). A removed subscriber stays alive until the snapshot naming it is retired.
+	 */
+	std::atomic<const FSubscriberSnapshot*> PublishedSnapshot{nullptr};
+	/**
+	 Incremented by FanOut() on entry and on exit, so it is odd while the audio thread may hold a snapshot.
+	 PublishSnapshot() waits for an odd value to move on before retiring the previous snapshot: a grace
+	 period of at most one packet fan-out, since FanOut() only pushes to non-blocking rings.
+	 */
+	std::atomic<uint32> FanOutEpoch{0};
+	/**
+	 Sample rate of the haptic stream sent to the controller.
+	 */
+	static constexpr int32 HapticSampleRate = 3000;
+	/**
+	 Coefficients of the one-pole high-pass applied to the resampled signal: Low = Gain * x + Alpha * Low, y = x - Low.
+	 */
+	static constexpr float HighPassAlpha = 0.2f;
+	static constexpr float HighPassGain = 0.5f - HighPassAlpha;
+	/**
+	 Resamples a submix buffer into ResampledAudioBuffer with the polyphase decimator, high-pass included.
+	 Falls back to ResampleWithBestSinc() for rates the decimator does not support.
+
+	 @return The number of frames written.
+	 */
+	int32 ResampleWithDecimator(float* AudioData, int32 NumInputFrames, int32 NumChannels, int32 SampleRate);
+	/**
+	 Resamples a submix buffer into ResampledAudioBuffer with Audio::FResampler in BestSinc mode, then applies the high-pass.
+
+	 @return The number of frames written.
+	 */
+	int32 ResampleWithBestSinc(float* AudioData, int32 NumInputFrames, int32 NumChannels, int32 SampleRate);
+	/**
+	 Quantizes resampled frames into PendingPacket and fans every packet that fills up out to the subscribers.
+
+	 Frames that do not complete a packet stay in PendingPacket until the next callback, so the
+	 number of frames per callback, which depends on the mixer rate, buffer size and resampler
+	 latency, never causes audio to be dropped.
+
+	 @param Frames Interleaved resampled frames. The first two channels drive the left and right actuators.
+	 @param NumFrames Number of frames in Frames.
+	 @param NumChannels Number of interleaved channels in Frames.
+	 */
+	void AppendToPackets(const float* Frames, int32 NumFrames, int32 NumChannels);
+	/**
+	 Haptic packet being filled across submix callbacks.
+	 */
+	FHapticFrame PendingPacket;
+	/**
+	 Number of samples already written to PendingPacket.
+	 */
+	int32 PendingSamples = 0;
 	/**
 	 A buffer used to store audio data that has been resampled for haptic feedback systems.
 
@@ -110,6 +248,15 @@ private:
 	 It supports initializing the resampling method, processing the mono audio data, and writing the resampled output for further use.
 	 */
 	TUniquePtr<Audio::FResampler> ResamplerImpl;
+	/**
+	 Input format ResamplerImpl was initialized for; it is recreated when the audio device changes it.
+	 */
+	int32 ResamplerSampleRate = 0;
+	int32 ResamplerNumChannels = 0;
+	/**
+	 Polyphase FIR decimator, the default and much cheaper alternative to ResamplerImpl; selected with `ds.HapticsResampler`.
+	 */
+	FHapticDecimator Decimator;
 
 	/**
 	 A reference to a USoundSubmix instance used within the audio processing pipeline.
@@ -120,15 +267,6 @@ private:
 	 resampling or conversion, enabling it to be used for tactile feedback in haptic devices.
 	 */
 	USoundSubmix* Submix;
-	/**
-	 A unique identifier representing an input device.
-
-	 DeviceId is used to reliably reference and interact with a specific input device
-	 within the system, such as game controllers or other haptics-enabled peripherals.
-	 It provides a consistent and unique mechanism for identifying devices, enabling
-	 their integration into various systems, including haptic feedback and input processing pipelines.
-	 */
-	FInputDeviceId DeviceId;
 	/**
 	 Variable used to maintain the state of the left channel for a low-pass filter.
 